@@ -8,6 +8,7 @@
 #include "cRenderState.h"
 #include "cShader.h"
 #include <fstream>
+#include <vector>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include "Engine/Platform/Platform.h"
 
@@ -54,6 +55,16 @@ eae6320::cResult eae6320::Graphics::cGeometry::CreateGeomrtry(cGeometry*& ptr, V
 {
 	auto result = Results::Success;
 	ptr = new cGeometry(_v_data, _v_length, _idx_data, _idx_length);
+	// The vertex data is only valid while the geometry is being created, so the bounds are calculated now
+	{
+		std::vector<Math::sVector> positions;
+		positions.reserve(_v_length);
+		for (uint16_t i = 0; i < _v_length; i++)
+		{
+			positions.push_back(Math::sVector(_v_data[i].x, _v_data[i].y, _v_data[i].z));
+		}
+		ptr->m_boundingSphere = Math::sSphere::CreateFromPoints(positions.data(), positions.size());
+	}
 	result = ptr->InitializeGeometry();
 	return result;
 }
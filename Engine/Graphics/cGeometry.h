@@ -2,6 +2,7 @@
 #include "Engine/Assets/ReferenceCountedAssets.h"
 #include <Engine/Assets/cHandle.h>
 #include <Engine/Assets/cManager.h>
+#include <Engine/Math/sSphere.h>
 
 #if defined( EAE6320_PLATFORM_D3D )
 #include "cVertexFormat.h"
@@ -38,6 +39,8 @@ namespace eae6320 {
 			cResult InitializeGeometry();
 			void DrawGeometry();
 			cResult CleanUp();
+			// In the geometry's local space, for culling
+			const Math::sSphere& GetBoundingSphere() const { return m_boundingSphere; }
 #pragma region ReferenceCounting
 				EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS()
 				EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cGeometry)
@@ -68,6 +71,7 @@ namespace eae6320 {
 			int m_indexCount; 
 			VertexFormats::s3dObject* m_VertexData;
 			uint16_t* m_IndexData;
+			Math::sSphere m_boundingSphere;
 
 
 #if defined( EAE6320_PLATFORM_GL )
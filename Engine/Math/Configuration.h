@@ -0,0 +1,49 @@
+/*
+	This file provides configurable settings
+	that can be used to modify the math project
+*/
+
+#ifndef EAE6320_MATH_CONFIGURATION_H
+#define EAE6320_MATH_CONFIGURATION_H
+
+// Matrix products and quaternion-to-matrix conversions use SSE2 when the compiler targets it
+// (every x64 build, and x86 builds with /arch:SSE2, which is the default).
+// The SSE2 paths do the same operations in the same order as the scalar ones,
+// so both produce the same results; comment this out to compare them
+#if defined( _M_X64 ) || defined( __x86_64__ ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) || defined( __SSE2__ )
+	#define EAE6320_MATH_ISSSEENABLED
+#endif
+
+// Lockstep multiplayer and replays need every machine to simulate bit-identical results.
+// Defining this makes the math and physics code avoid everything whose results can differ between compilers, CPUs, and C runtimes:
+//	* Math::Sqrt() is always the SSE square root instruction (which IEEE 754 requires to be correctly rounded)
+//		and Math::Sin() and Math::Cos() are our own polynomials instead of the C runtime's
+//	* cQuaternion::Normalize( sArrays ) uses a real square root instead of the reciprocal square root estimate,
+//		whose bits differ between Intel and AMD CPUs
+//	* Multiplies and adds are never contracted into FMA instructions
+// It is defined for every project in Engine/EngineDefaults.props rather than here,
+// so that files that never include this one (e.g. sAABB.cpp) are compiled the same way as the rest.
+// The same sheet sets /fp:precise. The v142 toolset has no /fp:contract, but at the default /arch it never emits FMA instructions;
+// other compilers need -ffp-contract=off on the command line, because the pragma below only covers code that comes after an include of this file.
+// Remove the definition there to trade determinism for a little speed
+
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+	#if !defined( EAE6320_MATH_ISSSEENABLED ) || ( defined( __FLT_EVAL_METHOD__ ) && ( __FLT_EVAL_METHOD__ != 0 ) )
+		#error "Deterministic math requires SSE2 floating point (x87 code keeps intermediate results at a precision that depends on the compiler)"
+	#endif
+	#if defined( _M_FP_FAST ) || defined( __FAST_MATH__ )
+		#error "Deterministic math can't be built with fast floating point (/fp:fast or -ffast-math)"
+	#endif
+	#if defined( _MSC_VER ) && ( _MSC_VER < 1930 ) && defined( __AVX2__ )
+		#error "Deterministic math can't be built with /arch:AVX2 before the v143 toolset (files that don't include this one could get FMA instructions)"
+	#endif
+	#if defined( _MSC_VER )
+		#pragma fp_contract( off )
+	#elif defined( __clang__ )
+		#pragma STDC FP_CONTRACT OFF
+	#elif defined( __GNUC__ )
+		#pragma GCC optimize( "fp-contract=off" )
+	#endif
+#endif
+
+#endif	// EAE6320_MATH_CONFIGURATION_H
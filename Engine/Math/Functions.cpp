@@ -3,10 +3,62 @@
 
 #include "Functions.h"
 
+#include "Configuration.h"
+
 #include <cmath>
 #include <cstring>
 #include <Engine/Asserts/Asserts.h>
 
+// Helper Definitions
+//===================
+
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+namespace
+{
+	// The angle is reduced to [-pi/4, pi/4] and evaluated with minimax polynomials (the same approach as Cephes' sinf() and cosf()).
+	// Every operation is a single float operation in a fixed order,
+	// so as long as the compiler doesn't reorder or contract them (see Configuration.h) the results are the same everywhere
+
+	// Subtracting a multiple of pi/4 in three parts keeps the reduced angle precise
+	constexpr float s_piOver4_part1 = 0.78515625f;
+	constexpr float s_piOver4_part2 = 2.4187564849853515625e-4f;
+	constexpr float s_piOver4_part3 = 3.77489497744594108e-8f;
+	constexpr float s_4OverPi = 1.27323954473516f;
+
+	// Returns the angle's offset from the nearest multiple of pi/2,
+	// which is returned as an octant (0 or 2, the second half of the circle is the first one with the opposite sign)
+	float ReduceAngle( const float i_angle_positive, int& o_octant, bool& o_isInSecondHalf )
+	{
+		auto octant = static_cast<int>( i_angle_positive * s_4OverPi );
+		auto octant_float = static_cast<float>( octant );
+		// Round odd octants up so that the angle is reduced around a multiple of pi/2
+		if ( ( octant & 1 ) != 0 )
+		{
+			octant++;
+			octant_float += 1.0f;
+		}
+		octant &= 7;
+		o_isInSecondHalf = octant > 3;
+		o_octant = o_isInSecondHalf ? ( octant - 4 ) : octant;
+		return ( ( i_angle_positive - ( octant_float * s_piOver4_part1 ) ) - ( octant_float * s_piOver4_part2 ) ) - ( octant_float * s_piOver4_part3 );
+	}
+
+	float EvaluateSin( const float i_angle_reduced )
+	{
+		const auto angle_squared = i_angle_reduced * i_angle_reduced;
+		return ( ( ( ( ( -1.9515295891e-4f * angle_squared ) + 8.3321608736e-3f ) * angle_squared ) - 1.6666654611e-1f )
+			* angle_squared * i_angle_reduced ) + i_angle_reduced;
+	}
+
+	float EvaluateCos( const float i_angle_reduced )
+	{
+		const auto angle_squared = i_angle_reduced * i_angle_reduced;
+		return ( ( ( ( ( ( 2.443315711809948e-5f * angle_squared ) - 1.388731625493765e-3f ) * angle_squared ) + 4.166664568298827e-2f )
+			* angle_squared * angle_squared ) - ( 0.5f * angle_squared ) ) + 1.0f;
+	}
+}
+#endif
+
 // Interface
 //==========
 
@@ -96,6 +148,35 @@ uint16_t eae6320::Math::ConvertFloatToHalf( const float i_value )
 	}
 }
 
+float eae6320::Math::Sin( const float i_angleInRadians )
+{
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+	// sin( -x ) == -sin( x )
+	const auto isNegative = i_angleInRadians < 0.0f;
+	int octant;
+	bool isInSecondHalf;
+	const auto angle_reduced = ReduceAngle( isNegative ? -i_angleInRadians : i_angleInRadians, octant, isInSecondHalf );
+	const auto result = ( octant == 2 ) ? EvaluateCos( angle_reduced ) : EvaluateSin( angle_reduced );
+	return ( isNegative != isInSecondHalf ) ? -result : result;
+#else
+	return std::sin( i_angleInRadians );
+#endif
+}
+
+float eae6320::Math::Cos( const float i_angleInRadians )
+{
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+	// cos( -x ) == cos( x )
+	int octant;
+	bool isInSecondHalf;
+	const auto angle_reduced = ReduceAngle( i_angleInRadians < 0.0f ? -i_angleInRadians : i_angleInRadians, octant, isInSecondHalf );
+	const auto result = ( octant == 2 ) ? EvaluateSin( angle_reduced ) : EvaluateCos( angle_reduced );
+	return ( isInSecondHalf != ( octant == 2 ) ) ? -result : result;
+#else
+	return std::cos( i_angleInRadians );
+#endif
+}
+
 float eae6320::Math::ConvertHorizontalFieldOfViewToVerticalFieldOfView( const float i_horizontalFieldOfView_inRadians,
 	const float i_aspectRatio )
 {
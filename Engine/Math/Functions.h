@@ -26,6 +26,13 @@ namespace eae6320
 			// aspectRatio = width / height
 			const float i_aspectRatio );
 
+		// These are the standard library's functions unless EAE6320_MATH_ISDETERMINISTIC is defined (see Configuration.h),
+		// in which case they give the same results with every compiler and C runtime.
+		// The deterministic Sin() and Cos() are accurate to about 1 ulp for angles up to 8192 radians
+		float Sqrt( const float i_value );
+		float Sin( const float i_angleInRadians );
+		float Cos( const float i_angleInRadians );
+
 		// Convert a single color channel value between linear and sRGB
 			template<typename tFloat, class EnforceFloat = typename std::enable_if<std::is_floating_point<tFloat>::value>::type>
 		constexpr tFloat ConvertLinearToSRgb( const tFloat i_value );
@@ -6,10 +6,14 @@
 
 #include "Functions.h"
 
+#include "Configuration.h"
 #include "Constants.h"
 
 #include <cmath>
 #include <Engine/Asserts/Asserts.h>
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+	#include <emmintrin.h>
+#endif
 
 // Interface
 //==========
@@ -19,6 +23,15 @@ constexpr float eae6320::Math::ConvertDegreesToRadians( const float i_degrees )
 	return i_degrees * ( Pi / 180.0f );
 }
 
+inline float eae6320::Math::Sqrt( const float i_value )
+{
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+	return _mm_cvtss_f32( _mm_sqrt_ss( _mm_set_ss( i_value ) ) );
+#else
+	return std::sqrt( i_value );
+#endif
+}
+
 	template<typename tFloat, class EnforceFloat>
 constexpr tFloat eae6320::Math::ConvertLinearToSRgb( const tFloat i_value )
 {
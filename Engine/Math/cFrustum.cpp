@@ -0,0 +1,234 @@
+// Includes
+//=========
+
+#include "cFrustum.h"
+
+#include "Configuration.h"
+#include "Functions.h"
+#include "cMatrix_transformation.h"
+#include "sAABB.h"
+#include "sSphere.h"
+
+#include <cmath>
+#ifdef EAE6320_MATH_ISSSEENABLED
+	#include <emmintrin.h>
+#endif
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// A point is on the inside of the plane when a*x + b*y + c*z + w >= 0
+	eae6320::Math::sPlane CreatePlane( const float i_a, const float i_b, const float i_c, const float i_w )
+	{
+		const auto length = eae6320::Math::Sqrt( ( i_a * i_a ) + ( i_b * i_b ) + ( i_c * i_c ) );
+		const auto length_reciprocal = length > 0.0f ? 1.0f / length : 0.0f;
+		return eae6320::Math::sPlane( eae6320::Math::sVector( i_a * length_reciprocal, i_b * length_reciprocal, i_c * length_reciprocal ),
+			-i_w * length_reciprocal );
+	}
+
+	void ClearUnusedBits( const size_t i_count, uint32_t* const o_visibilityBits )
+	{
+		const auto usedBitCount = i_count % 32;
+		if ( usedBitCount != 0 )
+		{
+			o_visibilityBits[i_count / 32] &= ( 1u << usedBitCount ) - 1u;
+		}
+	}
+
+#ifdef EAE6320_MATH_ISSSEENABLED
+	// The plane's data broadcast to every lane, so that four volumes can be tested against it at once
+	struct sPlane_wide
+	{
+		__m128 x, y, z, distance;
+		__m128 x_abs, y_abs, z_abs;
+	};
+
+	void LoadPlanes( const eae6320::Math::sPlane* const i_planes, sPlane_wide* const o_planes )
+	{
+		const auto absoluteMask = _mm_castsi128_ps( _mm_set1_epi32( 0x7fffffff ) );
+		for ( size_t i = 0; i < eae6320::Math::cFrustum::PlaneCount; i++ )
+		{
+			auto& plane = o_planes[i];
+			plane.x = _mm_set1_ps( i_planes[i].normal.x );
+			plane.y = _mm_set1_ps( i_planes[i].normal.y );
+			plane.z = _mm_set1_ps( i_planes[i].normal.z );
+			plane.distance = _mm_set1_ps( i_planes[i].distance );
+			plane.x_abs = _mm_and_ps( plane.x, absoluteMask );
+			plane.y_abs = _mm_and_ps( plane.y, absoluteMask );
+			plane.z_abs = _mm_and_ps( plane.z, absoluteMask );
+		}
+	}
+
+	// The same operations in the same order as sPlane::GetSignedDistance()
+	inline __m128 GetSignedDistances( const sPlane_wide& i_plane, const __m128 i_x, const __m128 i_y, const __m128 i_z )
+	{
+		return _mm_sub_ps( _mm_add_ps( _mm_add_ps(
+			_mm_mul_ps( i_plane.x, i_x ),
+			_mm_mul_ps( i_plane.y, i_y ) ),
+			_mm_mul_ps( i_plane.z, i_z ) ),
+			i_plane.distance );
+	}
+#endif
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+const eae6320::Math::sPlane& eae6320::Math::cFrustum::GetPlane( const ePlane i_plane ) const
+{
+	return m_planes[i_plane];
+}
+
+// Visibility
+//-----------
+
+bool eae6320::Math::cFrustum::IsVisible( const sSphere& i_sphere ) const
+{
+	const auto radius_negative = -i_sphere.radius;
+	for ( const auto& plane : m_planes )
+	{
+		if ( plane.GetSignedDistance( i_sphere.center ) < radius_negative )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool eae6320::Math::cFrustum::IsVisible( const sAABB& i_box ) const
+{
+	// The box is outside of a plane if its center is further outside
+	// than the box's projected radius onto the plane's normal
+	const auto center = i_box.GetCenter();
+	const auto extents = i_box.GetExtents();
+	for ( const auto& plane : m_planes )
+	{
+		const auto radius = ( ( std::abs( plane.normal.x ) * extents.x ) + ( std::abs( plane.normal.y ) * extents.y ) )
+			+ ( std::abs( plane.normal.z ) * extents.z );
+		if ( plane.GetSignedDistance( center ) < -radius )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Batches
+//--------
+
+void eae6320::Math::cFrustum::CullSpheres( const sSphere* const i_spheres, const size_t i_count, uint32_t* const o_visibilityBits ) const
+{
+	for ( size_t i = 0, wordCount = GetVisibilityWordCount( i_count ); i < wordCount; i++ )
+	{
+		o_visibilityBits[i] = 0;
+	}
+	size_t i = 0;
+#ifdef EAE6320_MATH_ISSSEENABLED
+	sPlane_wide planes[PlaneCount];
+	LoadPlanes( m_planes, planes );
+	// Each sphere is one register (x, y, z, radius),
+	// and transposing four of them gives one register per component
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		const auto* const spheres = reinterpret_cast<const float*>( i_spheres + i );
+		auto x = _mm_loadu_ps( spheres );
+		auto y = _mm_loadu_ps( spheres + 4 );
+		auto z = _mm_loadu_ps( spheres + 8 );
+		auto radius = _mm_loadu_ps( spheres + 12 );
+		_MM_TRANSPOSE4_PS( x, y, z, radius );
+		const auto radius_negative = _mm_xor_ps( radius, _mm_set1_ps( -0.0f ) );
+		auto isOutside = _mm_setzero_ps();
+		for ( const auto& plane : planes )
+		{
+			isOutside = _mm_or_ps( isOutside, _mm_cmplt_ps( GetSignedDistances( plane, x, y, z ), radius_negative ) );
+		}
+		const auto visibilityBits = static_cast<uint32_t>( _mm_movemask_ps( isOutside ) ) ^ 0xfu;
+		o_visibilityBits[i / 32] |= visibilityBits << ( i % 32 );
+	}
+#endif
+	for ( ; i < i_count; i++ )
+	{
+		o_visibilityBits[i / 32] |= static_cast<uint32_t>( IsVisible( i_spheres[i] ) ) << ( i % 32 );
+	}
+	ClearUnusedBits( i_count, o_visibilityBits );
+}
+
+void eae6320::Math::cFrustum::CullAABBs( const sAABB* const i_boxes, const size_t i_count, uint32_t* const o_visibilityBits ) const
+{
+	for ( size_t i = 0, wordCount = GetVisibilityWordCount( i_count ); i < wordCount; i++ )
+	{
+		o_visibilityBits[i] = 0;
+	}
+	size_t i = 0;
+#ifdef EAE6320_MATH_ISSSEENABLED
+	sPlane_wide planes[PlaneCount];
+	LoadPlanes( m_planes, planes );
+	const auto half = _mm_set1_ps( 0.5f );
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		// A box is six floats, which don't line up with registers, so the components are gathered individually
+		const auto* const boxes = i_boxes + i;
+		const auto min_x = _mm_setr_ps( boxes[0].minimum.x, boxes[1].minimum.x, boxes[2].minimum.x, boxes[3].minimum.x );
+		const auto min_y = _mm_setr_ps( boxes[0].minimum.y, boxes[1].minimum.y, boxes[2].minimum.y, boxes[3].minimum.y );
+		const auto min_z = _mm_setr_ps( boxes[0].minimum.z, boxes[1].minimum.z, boxes[2].minimum.z, boxes[3].minimum.z );
+		const auto max_x = _mm_setr_ps( boxes[0].maximum.x, boxes[1].maximum.x, boxes[2].maximum.x, boxes[3].maximum.x );
+		const auto max_y = _mm_setr_ps( boxes[0].maximum.y, boxes[1].maximum.y, boxes[2].maximum.y, boxes[3].maximum.y );
+		const auto max_z = _mm_setr_ps( boxes[0].maximum.z, boxes[1].maximum.z, boxes[2].maximum.z, boxes[3].maximum.z );
+		const auto center_x = _mm_mul_ps( _mm_add_ps( min_x, max_x ), half );
+		const auto center_y = _mm_mul_ps( _mm_add_ps( min_y, max_y ), half );
+		const auto center_z = _mm_mul_ps( _mm_add_ps( min_z, max_z ), half );
+		const auto extent_x = _mm_mul_ps( _mm_sub_ps( max_x, min_x ), half );
+		const auto extent_y = _mm_mul_ps( _mm_sub_ps( max_y, min_y ), half );
+		const auto extent_z = _mm_mul_ps( _mm_sub_ps( max_z, min_z ), half );
+		auto isOutside = _mm_setzero_ps();
+		for ( const auto& plane : planes )
+		{
+			const auto radius = _mm_add_ps( _mm_add_ps(
+				_mm_mul_ps( plane.x_abs, extent_x ),
+				_mm_mul_ps( plane.y_abs, extent_y ) ),
+				_mm_mul_ps( plane.z_abs, extent_z ) );
+			const auto radius_negative = _mm_xor_ps( radius, _mm_set1_ps( -0.0f ) );
+			isOutside = _mm_or_ps( isOutside,
+				_mm_cmplt_ps( GetSignedDistances( plane, center_x, center_y, center_z ), radius_negative ) );
+		}
+		const auto visibilityBits = static_cast<uint32_t>( _mm_movemask_ps( isOutside ) ) ^ 0xfu;
+		o_visibilityBits[i / 32] |= visibilityBits << ( i % 32 );
+	}
+#endif
+	for ( ; i < i_count; i++ )
+	{
+		o_visibilityBits[i / 32] |= static_cast<uint32_t>( IsVisible( i_boxes[i] ) ) << ( i % 32 );
+	}
+	ClearUnusedBits( i_count, o_visibilityBits );
+}
+
+bool eae6320::Math::cFrustum::IsVisible( const uint32_t* const i_visibilityBits, const size_t i_index )
+{
+	return ( i_visibilityBits[i_index / 32] & ( 1u << ( i_index % 32 ) ) ) != 0;
+}
+
+// Initialization / Shut Down
+//---------------------------
+
+eae6320::Math::cFrustum::cFrustum( const cMatrix_transformation& i_transform_worldToProjected )
+{
+	// A point is inside of the frustum when its projected position satisfies
+	// -w <= x <= w, -w <= y <= w, and either 0 <= z <= w (Direct3D) or -w <= z <= w (OpenGL),
+	// and each of those inequalities is a plane made from the rows of the transform
+	const auto& m = i_transform_worldToProjected;
+	m_planes[Left] = CreatePlane( m.m_30 + m.m_00, m.m_31 + m.m_01, m.m_32 + m.m_02, m.m_33 + m.m_03 );
+	m_planes[Right] = CreatePlane( m.m_30 - m.m_00, m.m_31 - m.m_01, m.m_32 - m.m_02, m.m_33 - m.m_03 );
+	m_planes[Bottom] = CreatePlane( m.m_30 + m.m_10, m.m_31 + m.m_11, m.m_32 + m.m_12, m.m_33 + m.m_13 );
+	m_planes[Top] = CreatePlane( m.m_30 - m.m_10, m.m_31 - m.m_11, m.m_32 - m.m_12, m.m_33 - m.m_13 );
+#if defined( EAE6320_PLATFORM_D3D )
+	m_planes[Near] = CreatePlane( m.m_20, m.m_21, m.m_22, m.m_23 );
+#elif defined( EAE6320_PLATFORM_GL )
+	m_planes[Near] = CreatePlane( m.m_30 + m.m_20, m.m_31 + m.m_21, m.m_32 + m.m_22, m.m_33 + m.m_23 );
+#endif
+	m_planes[Far] = CreatePlane( m.m_30 - m.m_20, m.m_31 - m.m_21, m.m_32 - m.m_22, m.m_33 - m.m_23 );
+}
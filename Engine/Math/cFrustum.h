@@ -0,0 +1,100 @@
+/*
+	This class represents the view frustum of a camera
+	as six planes whose normals point inwards
+
+	The planes are extracted from a world-to-projected transform
+	(i.e. cameraToProjected * worldToCamera),
+	so they are in world space and a volume can be tested without transforming it into the camera's space
+*/
+
+#ifndef EAE6320_MATH_CFRUSTUM_H
+#define EAE6320_MATH_CFRUSTUM_H
+
+// Includes
+//=========
+
+#include "sPlane.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cMatrix_transformation;
+		struct sAABB;
+		struct sSphere;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cFrustum
+		{
+			// Interface
+			//==========
+
+		public:
+
+			enum ePlane : uint8_t
+			{
+				Left, Right, Bottom, Top, Near, Far,
+
+				PlaneCount
+			};
+
+			// Access
+			//-------
+
+			const sPlane& GetPlane( const ePlane i_plane ) const;
+
+			// Visibility
+			//-----------
+
+			// The tests are conservative:
+			// A volume that is outside of the frustum but near one of its corners may be reported as visible,
+			// but a volume that is even partly inside of the frustum will never be reported as invisible
+			bool IsVisible( const sSphere& i_sphere ) const;
+			bool IsVisible( const sAABB& i_box ) const;
+
+			// Batches
+			//--------
+
+			// The batch tests write one bit per volume:
+			// Volume i is visible if bit ( i % 32 ) of o_visibilityBits[i / 32] is set.
+			// o_visibilityBits must have room for GetVisibilityWordCount( i_count ) words,
+			// and any bits past the last volume are cleared.
+			// The results match calling IsVisible() for each volume
+			void CullSpheres( const sSphere* const i_spheres, const size_t i_count, uint32_t* const o_visibilityBits ) const;
+			void CullAABBs( const sAABB* const i_boxes, const size_t i_count, uint32_t* const o_visibilityBits ) const;
+			static constexpr size_t GetVisibilityWordCount( const size_t i_count ) { return ( i_count + 31 ) / 32; }
+			static bool IsVisible( const uint32_t* const i_visibilityBits, const size_t i_index );
+
+			// Initialization / Shut Down
+			//---------------------------
+
+			cFrustum() = default;
+			// The transform must be a world-to-projected (or camera-to-projected, for planes in camera space) transform
+			// created with CreateCameraToProjectedTransform_perspective()
+			explicit cFrustum( const cMatrix_transformation& i_transform_worldToProjected );
+
+			// Data
+			//=====
+
+		private:
+
+			sPlane m_planes[PlaneCount];
+		};
+	}
+}
+
+#endif	// EAE6320_MATH_CFRUSTUM_H
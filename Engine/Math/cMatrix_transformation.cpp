@@ -3,10 +3,57 @@
 
 #include "cMatrix_transformation.h"
 
+#include "Configuration.h"
 #include "cQuaternion.h"
 #include "sVector.h"
 
 #include <cmath>
+#ifdef EAE6320_MATH_ISSSEENABLED
+	#include <emmintrin.h>
+#endif
+
+// Helper Definitions
+//===================
+
+#ifdef EAE6320_MATH_ISSSEENABLED
+namespace
+{
+	// The elements are stored as columns, so each column is one register.
+	// The class isn't aligned to 16 bytes, so every load and store is unaligned
+
+	// Adds up the columns scaled by the four factors in the same order as the scalar code:
+	// ( ( c0 * f0 + c1 * f1 ) + c2 * f2 ) + c3 * f3
+	inline __m128 CombineColumns( const __m128 i_columns[4], const float* const i_factors )
+	{
+		return _mm_add_ps( _mm_add_ps( _mm_add_ps(
+			_mm_mul_ps( i_columns[0], _mm_set1_ps( i_factors[0] ) ),
+			_mm_mul_ps( i_columns[1], _mm_set1_ps( i_factors[1] ) ) ),
+			_mm_mul_ps( i_columns[2], _mm_set1_ps( i_factors[2] ) ) ),
+			_mm_mul_ps( i_columns[3], _mm_set1_ps( i_factors[3] ) ) );
+	}
+
+	// ( c0 * f0 + c1 * f1 ) + c2 * f2
+	inline __m128 CombineRotationColumns( const __m128 i_columns[4], const float* const i_factors )
+	{
+		return _mm_add_ps( _mm_add_ps(
+			_mm_mul_ps( i_columns[0], _mm_set1_ps( i_factors[0] ) ),
+			_mm_mul_ps( i_columns[1], _mm_set1_ps( i_factors[1] ) ) ),
+			_mm_mul_ps( i_columns[2], _mm_set1_ps( i_factors[2] ) ) );
+	}
+
+	// ( i_base + ±i_first ) + ±i_second, flipping the sign bits is exact so this rounds like the scalar code
+	inline __m128 CombineRotationTerms( const __m128 i_base,
+		const __m128 i_first, const __m128 i_firstSigns, const __m128 i_second, const __m128 i_secondSigns )
+	{
+		return _mm_add_ps( _mm_add_ps( i_base, _mm_xor_ps( i_first, i_firstSigns ) ), _mm_xor_ps( i_second, i_secondSigns ) );
+	}
+
+	inline __m128 GetMask_xyz()
+	{
+		return _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+	}
+}
+#endif
 
 // Interface
 //==========
@@ -16,15 +63,39 @@
 
 eae6320::Math::sVector eae6320::Math::cMatrix_transformation::operator *( const sVector i_rhs ) const
 {
+#ifdef EAE6320_MATH_ISSSEENABLED
+	const auto* const columns = &m_00;
+	const auto result = _mm_add_ps( _mm_add_ps( _mm_add_ps(
+		_mm_mul_ps( _mm_loadu_ps( columns ), _mm_set1_ps( i_rhs.x ) ),
+		_mm_mul_ps( _mm_loadu_ps( columns + 4 ), _mm_set1_ps( i_rhs.y ) ) ),
+		_mm_mul_ps( _mm_loadu_ps( columns + 8 ), _mm_set1_ps( i_rhs.z ) ) ),
+		_mm_loadu_ps( columns + 12 ) );
+	float elements[4];
+	_mm_storeu_ps( elements, result );
+	return sVector( elements[0], elements[1], elements[2] );
+#else
 	return sVector(
 		( m_00 * i_rhs.x ) + ( m_01 * i_rhs.y ) + ( m_02 * i_rhs.z ) + m_03,
 		( m_10 * i_rhs.x ) + ( m_11 * i_rhs.y ) + ( m_12 * i_rhs.z ) + m_13,
 		( m_20 * i_rhs.x ) + ( m_21 * i_rhs.y ) + ( m_22 * i_rhs.z ) + m_23
 	);
+#endif
 }
 
 eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::operator *( const cMatrix_transformation& i_rhs ) const
 {
+#ifdef EAE6320_MATH_ISSSEENABLED
+	const auto* const columns_lhs = &m_00;
+	const __m128 columns[4] = { _mm_loadu_ps( columns_lhs ), _mm_loadu_ps( columns_lhs + 4 ), _mm_loadu_ps( columns_lhs + 8 ), _mm_loadu_ps( columns_lhs + 12 ) };
+	const auto* const columns_rhs = &i_rhs.m_00;
+	cMatrix_transformation result;
+	auto* const columns_result = &result.m_00;
+	_mm_storeu_ps( columns_result, CombineColumns( columns, columns_rhs ) );
+	_mm_storeu_ps( columns_result + 4, CombineColumns( columns, columns_rhs + 4 ) );
+	_mm_storeu_ps( columns_result + 8, CombineColumns( columns, columns_rhs + 8 ) );
+	_mm_storeu_ps( columns_result + 12, CombineColumns( columns, columns_rhs + 12 ) );
+	return result;
+#else
 	return cMatrix_transformation(
 		( m_00 * i_rhs.m_00 ) + ( m_01 * i_rhs.m_10 ) + ( m_02 * i_rhs.m_20 ) + ( m_03 * i_rhs.m_30 ),
 		( m_10 * i_rhs.m_00 ) + ( m_11 * i_rhs.m_10 ) + ( m_12 * i_rhs.m_20 ) + ( m_13 * i_rhs.m_30 ),
@@ -46,11 +117,17 @@ eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::ope
 		( m_20 * i_rhs.m_03 ) + ( m_21 * i_rhs.m_13 ) + ( m_22 * i_rhs.m_23 ) + ( m_23 * i_rhs.m_33 ),
 		( m_30 * i_rhs.m_03 ) + ( m_31 * i_rhs.m_13 ) + ( m_32 * i_rhs.m_23 ) + ( m_33 * i_rhs.m_33 )
 	);
+#endif
 }
 
 const eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::ConcatenateAffine(
 	const cMatrix_transformation& i_nextTransform, const cMatrix_transformation& i_firstTransform )
 {
+#ifdef EAE6320_MATH_ISSSEENABLED
+	cMatrix_transformation result;
+	ConcatenateAffine( i_nextTransform, &i_firstTransform, 1, &result );
+	return result;
+#else
 	// A few simplifying assumptions can be made for affine transformations vs. general 4x4 matrix multiplication
 	return cMatrix_transformation(
 		( i_nextTransform.m_00 * i_firstTransform.m_00 ) + ( i_nextTransform.m_01 * i_firstTransform.m_10 ) + ( i_nextTransform.m_02 * i_firstTransform.m_20 ),
@@ -73,6 +150,118 @@ const eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformatio
 		( i_nextTransform.m_20 * i_firstTransform.m_03 ) + ( i_nextTransform.m_21 * i_firstTransform.m_13 ) + ( i_nextTransform.m_22 * i_firstTransform.m_23 ) + i_nextTransform.m_23,
 		1.0f
 	);
+#endif
+}
+
+// Batches
+//--------
+
+void eae6320::Math::cMatrix_transformation::TransformPoints( const cMatrix_transformation& i_transform,
+	const sVector* const i_points, const size_t i_count, sVector* const o_points )
+{
+	size_t i = 0;
+#ifdef EAE6320_MATH_ISSSEENABLED
+	static_assert( sizeof( sVector ) == ( 3 * sizeof( float ) ), "Four packed vectors have to fill exactly three registers" );
+	const auto m00 = _mm_set1_ps( i_transform.m_00 ), m01 = _mm_set1_ps( i_transform.m_01 ), m02 = _mm_set1_ps( i_transform.m_02 ), m03 = _mm_set1_ps( i_transform.m_03 );
+	const auto m10 = _mm_set1_ps( i_transform.m_10 ), m11 = _mm_set1_ps( i_transform.m_11 ), m12 = _mm_set1_ps( i_transform.m_12 ), m13 = _mm_set1_ps( i_transform.m_13 );
+	const auto m20 = _mm_set1_ps( i_transform.m_20 ), m21 = _mm_set1_ps( i_transform.m_21 ), m22 = _mm_set1_ps( i_transform.m_22 ), m23 = _mm_set1_ps( i_transform.m_23 );
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 is transposed to one register per axis
+		const auto* const input = &i_points[i].x;
+		const auto a = _mm_loadu_ps( input );
+		const auto b = _mm_loadu_ps( input + 4 );
+		const auto c = _mm_loadu_ps( input + 8 );
+		const auto x = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+		const auto y = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 1, 1 ) ), _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 2, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		const auto z = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 1, 2, 2 ) ), c, _MM_SHUFFLE( 3, 0, 2, 0 ) );
+		// Every lane is one point, summed in the same order as the single version
+		const auto x_result = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m00, x ), _mm_mul_ps( m01, y ) ), _mm_mul_ps( m02, z ) ), m03 );
+		const auto y_result = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m10, x ), _mm_mul_ps( m11, y ) ), _mm_mul_ps( m12, z ) ), m13 );
+		const auto z_result = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m20, x ), _mm_mul_ps( m21, y ) ), _mm_mul_ps( m22, z ) ), m23 );
+		// And transposed back
+		auto* const output = &o_points[i].x;
+		_mm_storeu_ps( output, _mm_shuffle_ps(
+			_mm_shuffle_ps( x_result, y_result, _MM_SHUFFLE( 0, 0, 0, 0 ) ), _mm_shuffle_ps( z_result, x_result, _MM_SHUFFLE( 1, 1, 0, 0 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		_mm_storeu_ps( output + 4, _mm_shuffle_ps(
+			_mm_shuffle_ps( y_result, z_result, _MM_SHUFFLE( 1, 1, 1, 1 ) ), _mm_shuffle_ps( x_result, y_result, _MM_SHUFFLE( 2, 2, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		_mm_storeu_ps( output + 8, _mm_shuffle_ps(
+			_mm_shuffle_ps( z_result, x_result, _MM_SHUFFLE( 3, 3, 2, 2 ) ), _mm_shuffle_ps( y_result, z_result, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+	}
+#endif
+	for ( ; i < i_count; i++ )
+	{
+		o_points[i] = i_transform * i_points[i];
+	}
+}
+
+void eae6320::Math::cMatrix_transformation::ConcatenateAffine( const cMatrix_transformation& i_nextTransform,
+	const cMatrix_transformation* const i_firstTransforms, const size_t i_count, cMatrix_transformation* const o_transforms )
+{
+#ifdef EAE6320_MATH_ISSSEENABLED
+	const auto* const columns_next = &i_nextTransform.m_00;
+	const __m128 columns[4] = { _mm_loadu_ps( columns_next ), _mm_loadu_ps( columns_next + 4 ), _mm_loadu_ps( columns_next + 8 ), _mm_loadu_ps( columns_next + 12 ) };
+	// The bottom row of an affine transform is known, so it is written rather than calculated
+	const auto mask_xyz = GetMask_xyz();
+	const auto w_one = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		// Each column of the result only reads the same column of the first transform,
+		// so the result can overwrite it
+		const auto* const columns_first = &i_firstTransforms[i].m_00;
+		auto* const columns_result = &o_transforms[i].m_00;
+		_mm_storeu_ps( columns_result, _mm_and_ps( CombineRotationColumns( columns, columns_first ), mask_xyz ) );
+		_mm_storeu_ps( columns_result + 4, _mm_and_ps( CombineRotationColumns( columns, columns_first + 4 ), mask_xyz ) );
+		_mm_storeu_ps( columns_result + 8, _mm_and_ps( CombineRotationColumns( columns, columns_first + 8 ), mask_xyz ) );
+		_mm_storeu_ps( columns_result + 12, _mm_or_ps(
+			_mm_and_ps( _mm_add_ps( CombineRotationColumns( columns, columns_first + 12 ), columns[3] ), mask_xyz ), w_one ) );
+	}
+#else
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		o_transforms[i] = ConcatenateAffine( i_nextTransform, i_firstTransforms[i] );
+	}
+#endif
+}
+
+// Inversion
+//----------
+
+eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::GetInverse_orthonormalAffine() const
+{
+#ifdef EAE6320_MATH_ISSSEENABLED
+	const auto* const columns = &m_00;
+	// The bottom row is 0, 0, 0, 1, so transposing the four columns with that row as the last one
+	// gives the transposed rotation with 0 in every w lane
+	auto right = _mm_loadu_ps( columns );
+	auto up = _mm_loadu_ps( columns + 4 );
+	auto back = _mm_loadu_ps( columns + 8 );
+	auto bottom = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	_MM_TRANSPOSE4_PS( right, up, back, bottom );
+	// -( x * right ) - ( y * up ) - ( z * back ), in the same order as the scalar version
+	const auto translation = _mm_sub_ps( _mm_sub_ps(
+		_mm_xor_ps( _mm_mul_ps( _mm_set1_ps( m_03 ), right ), _mm_set1_ps( -0.0f ) ),
+		_mm_mul_ps( _mm_set1_ps( m_13 ), up ) ),
+		_mm_mul_ps( _mm_set1_ps( m_23 ), back ) );
+	cMatrix_transformation result;
+	auto* const columns_result = &result.m_00;
+	_mm_storeu_ps( columns_result, right );
+	_mm_storeu_ps( columns_result + 4, up );
+	_mm_storeu_ps( columns_result + 8, back );
+	_mm_storeu_ps( columns_result + 12, _mm_or_ps( _mm_and_ps( translation, GetMask_xyz() ), bottom ) );
+	return result;
+#else
+	return cMatrix_transformation(
+		m_00, m_01, m_02, 0.0f,
+		m_10, m_11, m_12, 0.0f,
+		m_20, m_21, m_22, 0.0f,
+
+		-( m_03 * m_00 ) - ( m_13 * m_10 ) - ( m_23 * m_20 ),
+		-( m_03 * m_01 ) - ( m_13 * m_11 ) - ( m_23 * m_21 ),
+		-( m_03 * m_02 ) - ( m_13 * m_12 ) - ( m_23 * m_22 ),
+
+		1.0f );
+#endif
 }
 
 // Access
@@ -112,16 +301,7 @@ eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::Cre
 	// Many simplifying assumptions can be made in order to create the inverse
 	// because in our class a camera can only ever have rotation and translation
 	// (i.e. it can't be scaled)
-	return cMatrix_transformation(
-		i_transform_localCameraToWorld.m_00, i_transform_localCameraToWorld.m_01, i_transform_localCameraToWorld.m_02, 0.0f,
-		i_transform_localCameraToWorld.m_10, i_transform_localCameraToWorld.m_11, i_transform_localCameraToWorld.m_12, 0.0f,
-		i_transform_localCameraToWorld.m_20, i_transform_localCameraToWorld.m_21, i_transform_localCameraToWorld.m_22, 0.0f,
-
-		-( i_transform_localCameraToWorld.m_03 * i_transform_localCameraToWorld.m_00 ) - ( i_transform_localCameraToWorld.m_13 * i_transform_localCameraToWorld.m_10 ) - ( i_transform_localCameraToWorld.m_23 * i_transform_localCameraToWorld.m_20 ),
-		-( i_transform_localCameraToWorld.m_03 * i_transform_localCameraToWorld.m_01 ) - ( i_transform_localCameraToWorld.m_13 * i_transform_localCameraToWorld.m_11 ) - ( i_transform_localCameraToWorld.m_23 * i_transform_localCameraToWorld.m_21 ),
-		-( i_transform_localCameraToWorld.m_03 * i_transform_localCameraToWorld.m_02 ) - ( i_transform_localCameraToWorld.m_13 * i_transform_localCameraToWorld.m_12 ) - ( i_transform_localCameraToWorld.m_23 * i_transform_localCameraToWorld.m_22 ),
-
-		1.0f );
+	return i_transform_localCameraToWorld.GetInverse_orthonormalAffine();
 }
 
 eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(
@@ -157,6 +337,35 @@ eae6320::Math::cMatrix_transformation::cMatrix_transformation( const cQuaternion
 	m_03( i_translation.x ), m_13( i_translation.y ), m_23( i_translation.z ),
 	m_33( 1.0f )
 {
+#ifdef EAE6320_MATH_ISSSEENABLED
+	// The quaternion is stored w, x, y, z
+	const auto q = _mm_loadu_ps( &i_rotation.m_w );
+	const auto _2q = _mm_add_ps( q, q );
+	const auto negative_x = _mm_setr_ps( -0.0f, 0.0f, 0.0f, 0.0f );
+	const auto negative_y = _mm_setr_ps( 0.0f, -0.0f, 0.0f, 0.0f );
+	const auto negative_z = _mm_setr_ps( 0.0f, 0.0f, -0.0f, 0.0f );
+	const auto negative_xz = _mm_setr_ps( -0.0f, 0.0f, -0.0f, 0.0f );
+	const auto negative_xy = _mm_setr_ps( -0.0f, -0.0f, 0.0f, 0.0f );
+	const auto negative_yz = _mm_setr_ps( 0.0f, -0.0f, -0.0f, 0.0f );
+	const auto mask_xyz = GetMask_xyz();
+	// Every element is ( base ± product ) ± product, with the same products as the scalar version below.
+	// The w lane of every shuffle is arbitrary and masked out
+	// Right: 1 - 2yy - 2zz, 2xy + 2zw, 2xz - 2yw
+	_mm_storeu_ps( &m_00, _mm_and_ps( CombineRotationTerms( _mm_setr_ps( 1.0f, 0.0f, 0.0f, 0.0f ),
+		_mm_mul_ps( _mm_shuffle_ps( _2q, _2q, _MM_SHUFFLE( 0, 1, 1, 2 ) ), _mm_shuffle_ps( q, q, _MM_SHUFFLE( 0, 3, 2, 2 ) ) ), negative_x,
+		_mm_mul_ps( _mm_shuffle_ps( _2q, _2q, _MM_SHUFFLE( 0, 2, 3, 3 ) ), _mm_shuffle_ps( q, q, _MM_SHUFFLE( 0, 0, 0, 3 ) ) ), negative_xz ),
+		mask_xyz ) );
+	// Up: 2xy - 2zw, 1 - 2xx - 2zz, 2yz + 2xw
+	_mm_storeu_ps( &m_01, _mm_and_ps( CombineRotationTerms( _mm_setr_ps( 0.0f, 1.0f, 0.0f, 0.0f ),
+		_mm_mul_ps( _mm_shuffle_ps( _2q, _2q, _MM_SHUFFLE( 0, 2, 1, 1 ) ), _mm_shuffle_ps( q, q, _MM_SHUFFLE( 0, 3, 1, 2 ) ) ), negative_y,
+		_mm_mul_ps( _mm_shuffle_ps( _2q, _2q, _MM_SHUFFLE( 0, 1, 3, 3 ) ), _mm_shuffle_ps( q, q, _MM_SHUFFLE( 0, 0, 3, 0 ) ) ), negative_xy ),
+		mask_xyz ) );
+	// Back: 2xz + 2yw, 2yz - 2xw, 1 - 2xx - 2yy
+	_mm_storeu_ps( &m_02, _mm_and_ps( CombineRotationTerms( _mm_setr_ps( 0.0f, 0.0f, 1.0f, 0.0f ),
+		_mm_mul_ps( _mm_shuffle_ps( _2q, _2q, _MM_SHUFFLE( 0, 1, 2, 1 ) ), _mm_shuffle_ps( q, q, _MM_SHUFFLE( 0, 1, 3, 3 ) ) ), negative_z,
+		_mm_mul_ps( _mm_shuffle_ps( _2q, _2q, _MM_SHUFFLE( 0, 2, 1, 2 ) ), _mm_shuffle_ps( q, q, _MM_SHUFFLE( 0, 2, 0, 0 ) ) ), negative_yz ),
+		mask_xyz ) );
+#else
 	const auto _2x = i_rotation.m_x + i_rotation.m_x;
 	const auto _2y = i_rotation.m_y + i_rotation.m_y;
 	const auto _2z = i_rotation.m_z + i_rotation.m_z;
@@ -181,6 +390,7 @@ eae6320::Math::cMatrix_transformation::cMatrix_transformation( const cQuaternion
 	m_20 = _2xz - _2yw;
 	m_21 = _2yz + _2xw;
 	m_22 = 1.0f - _2xx - _2yy;
+#endif
 }
 
 // Implementation
@@ -22,6 +22,11 @@
 #ifndef EAE6320_MATH_CMATRIX_TRANSFORMATION_H
 #define EAE6320_MATH_CMATRIX_TRANSFORMATION_H
 
+// Includes
+//=========
+
+#include <cstddef>
+
 // Forward Declarations
 //=====================
 
@@ -29,6 +34,7 @@ namespace eae6320
 {
 	namespace Math
 	{
+		class cFrustum;
 		class cQuaternion;
 		struct sVector;
 	}
@@ -59,6 +65,25 @@ namespace eae6320
 			static const cMatrix_transformation ConcatenateAffine(
 				const cMatrix_transformation& i_nextTransform, const cMatrix_transformation& i_firstTransform );
 
+			// Batches
+			//--------
+
+			// These give the same results as calling the single versions on every element,
+			// but the transform is only loaded once and points are transformed four at a time.
+			// The output array may be the input array
+			static void TransformPoints( const cMatrix_transformation& i_transform,
+				const sVector* const i_points, const size_t i_count, sVector* const o_points );
+			static void ConcatenateAffine( const cMatrix_transformation& i_nextTransform,
+				const cMatrix_transformation* const i_firstTransforms, const size_t i_count, cMatrix_transformation* const o_transforms );
+
+			// Inversion
+			//----------
+
+			// If the transform is known to only rotate and translate (i.e. it has no scale or shear)
+			// then its inverse is the transposed rotation with the translation rotated back and negated,
+			// which is much cheaper than a general inverse (or than rebuilding it from a quaternion)
+			cMatrix_transformation GetInverse_orthonormalAffine() const;
+
 			// Access
 			//-------
 
@@ -107,6 +132,7 @@ namespace eae6320
 		private:
 
 			// Storage is column-major; see notes at the top of the file
+			// (a frustum reads the rows of a projection directly to extract its planes)
 			float m_00 = 1.0f, m_10 = 0.0f, m_20 = 0.0f, m_30 = 0.0f,
 				m_01 = 0.0f, m_11 = 1.0f, m_21 = 0.0f, m_31 = 0.0f,
 				m_02 = 0.0f, m_12 = 0.0f, m_22 = 1.0f, m_32 = 0.0f,
@@ -125,6 +151,8 @@ namespace eae6320
 				const float i_01, const float i_11, const float i_21, const float i_31,
 				const float i_02, const float i_12, const float i_22, const float i_32,
 				const float i_03, const float i_13, const float i_23, const float i_33 );
+
+			friend class cFrustum;
 		};
 	}
 }
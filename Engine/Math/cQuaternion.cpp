@@ -3,10 +3,15 @@
 
 #include "cQuaternion.h"
 
+#include "Configuration.h"
+#include "Functions.h"
 #include "sVector.h"
 
 #include <cmath>
 #include <Engine/Asserts/Asserts.h>
+#ifdef EAE6320_MATH_ISSSEENABLED
+	#include <emmintrin.h>
+#endif
 
 // Static Data Initialization
 //===========================
@@ -14,6 +19,241 @@
 namespace
 {
 	constexpr auto s_epsilon = 1.0e-9f;
+
+	// Above this cosine the angle is too small for slerp's weights to be precise,
+	// but nlerp's weights are close enough to them to be used instead
+	constexpr auto s_slerpCosineThreshold = 0.9995f;
+	// acos( x ) ~= sqrt( 1 - x ) * polynomial( x ) for 0 <= x <= 1
+	// (Abramowitz and Stegun 4.4.46, the error is at most 2e-8)
+	constexpr float s_acosCoefficients[] =
+	{
+		1.5707963050f, -0.2145988016f, 0.0889789874f, -0.0501743046f,
+		0.0308918810f, -0.0170881256f, 0.0066700901f, -0.0012624911f
+	};
+	// sin( x ) ~= x * polynomial( x^2 ) for 0 <= x <= pi/2
+	// (the Taylor series up to x^11, the error is at most 6e-8)
+	constexpr float s_sinCoefficients[] =
+	{
+		1.0f, -1.0f / 6.0f, 1.0f / 120.0f, -1.0f / 5040.0f, 1.0f / 362880.0f, -1.0f / 39916800.0f
+	};
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// The batch functions use the same operations in the same order in both paths
+
+#ifdef EAE6320_MATH_ISSSEENABLED
+
+	// Four quaternions, one component per register
+	struct sLanes
+	{
+		__m128 w, x, y, z;
+	};
+
+	inline sLanes Load( const eae6320::Math::cQuaternion::sArrays_const& i_arrays, const size_t i_index )
+	{
+		return { _mm_loadu_ps( i_arrays.w + i_index ), _mm_loadu_ps( i_arrays.x + i_index ),
+			_mm_loadu_ps( i_arrays.y + i_index ), _mm_loadu_ps( i_arrays.z + i_index ) };
+	}
+
+	inline void Store( const sLanes& i_lanes, const size_t i_index, const eae6320::Math::cQuaternion::sArrays& o_arrays )
+	{
+		_mm_storeu_ps( o_arrays.w + i_index, i_lanes.w );
+		_mm_storeu_ps( o_arrays.x + i_index, i_lanes.x );
+		_mm_storeu_ps( o_arrays.y + i_index, i_lanes.y );
+		_mm_storeu_ps( o_arrays.z + i_index, i_lanes.z );
+	}
+
+	// The last one to three quaternions are copied into registers padded with the identity
+	// so that they go through the same code (and get the same results) as the others
+	inline sLanes Load_partial( const eae6320::Math::cQuaternion::sArrays_const& i_arrays, const size_t i_index, const size_t i_count )
+	{
+		alignas( 16 ) float w[4] = { 1.0f, 1.0f, 1.0f, 1.0f }, x[4] = {}, y[4] = {}, z[4] = {};
+		for ( size_t i = 0; i < i_count; i++ )
+		{
+			w[i] = i_arrays.w[i_index + i];
+			x[i] = i_arrays.x[i_index + i];
+			y[i] = i_arrays.y[i_index + i];
+			z[i] = i_arrays.z[i_index + i];
+		}
+		return { _mm_load_ps( w ), _mm_load_ps( x ), _mm_load_ps( y ), _mm_load_ps( z ) };
+	}
+
+	inline void Store_partial( const sLanes& i_lanes, const size_t i_index, const size_t i_count, const eae6320::Math::cQuaternion::sArrays& o_arrays )
+	{
+		alignas( 16 ) float w[4], x[4], y[4], z[4];
+		_mm_store_ps( w, i_lanes.w );
+		_mm_store_ps( x, i_lanes.x );
+		_mm_store_ps( y, i_lanes.y );
+		_mm_store_ps( z, i_lanes.z );
+		for ( size_t i = 0; i < i_count; i++ )
+		{
+			o_arrays.w[i_index + i] = w[i];
+			o_arrays.x[i_index + i] = x[i];
+			o_arrays.y[i_index + i] = y[i];
+			o_arrays.z[i_index + i] = z[i];
+		}
+	}
+
+	inline __m128 Dot( const sLanes& i_lhs, const sLanes& i_rhs )
+	{
+		return _mm_add_ps( _mm_add_ps( _mm_add_ps(
+			_mm_mul_ps( i_lhs.w, i_rhs.w ),
+			_mm_mul_ps( i_lhs.x, i_rhs.x ) ),
+			_mm_mul_ps( i_lhs.y, i_rhs.y ) ),
+			_mm_mul_ps( i_lhs.z, i_rhs.z ) );
+	}
+
+	inline sLanes Multiply( const sLanes& i_lhs, const sLanes& i_rhs )
+	{
+		// The same terms as cQuaternion::operator *()
+		return {
+			_mm_sub_ps( _mm_mul_ps( i_lhs.w, i_rhs.w ),
+				_mm_add_ps( _mm_add_ps( _mm_mul_ps( i_lhs.x, i_rhs.x ), _mm_mul_ps( i_lhs.y, i_rhs.y ) ), _mm_mul_ps( i_lhs.z, i_rhs.z ) ) ),
+			_mm_add_ps( _mm_add_ps( _mm_mul_ps( i_lhs.w, i_rhs.x ), _mm_mul_ps( i_lhs.x, i_rhs.w ) ),
+				_mm_sub_ps( _mm_mul_ps( i_lhs.y, i_rhs.z ), _mm_mul_ps( i_lhs.z, i_rhs.y ) ) ),
+			_mm_add_ps( _mm_add_ps( _mm_mul_ps( i_lhs.w, i_rhs.y ), _mm_mul_ps( i_lhs.y, i_rhs.w ) ),
+				_mm_sub_ps( _mm_mul_ps( i_lhs.z, i_rhs.x ), _mm_mul_ps( i_lhs.x, i_rhs.z ) ) ),
+			_mm_add_ps( _mm_add_ps( _mm_mul_ps( i_lhs.w, i_rhs.z ), _mm_mul_ps( i_lhs.z, i_rhs.w ) ),
+				_mm_sub_ps( _mm_mul_ps( i_lhs.x, i_rhs.y ), _mm_mul_ps( i_lhs.y, i_rhs.x ) ) ) };
+	}
+
+	inline sLanes Normalize( const sLanes& i_lanes )
+	{
+		const auto length_squared = Dot( i_lanes, i_lanes );
+#ifndef EAE6320_MATH_ISDETERMINISTIC
+		// y' = y * ( 1.5 - 0.5 * length^2 * y * y )
+		const auto estimate = _mm_rsqrt_ps( length_squared );
+		const auto length_reciprocal = _mm_mul_ps( estimate, _mm_sub_ps( _mm_set1_ps( 1.5f ),
+			_mm_mul_ps( _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5f ), length_squared ), estimate ), estimate ) ) );
+#else
+		// The estimate's bits depend on the CPU
+		const auto length_reciprocal = _mm_div_ps( _mm_set1_ps( 1.0f ), _mm_sqrt_ps( length_squared ) );
+#endif
+		return { _mm_mul_ps( i_lanes.w, length_reciprocal ), _mm_mul_ps( i_lanes.x, length_reciprocal ),
+			_mm_mul_ps( i_lanes.y, length_reciprocal ), _mm_mul_ps( i_lanes.z, length_reciprocal ) };
+	}
+
+	inline __m128 Acos_approximate( const __m128 i_x )
+	{
+		auto polynomial = _mm_set1_ps( s_acosCoefficients[7] );
+		for ( int i = 6; i >= 0; i-- )
+		{
+			polynomial = _mm_add_ps( _mm_mul_ps( polynomial, i_x ), _mm_set1_ps( s_acosCoefficients[i] ) );
+		}
+		return _mm_mul_ps( _mm_sqrt_ps( _mm_sub_ps( _mm_set1_ps( 1.0f ), i_x ) ), polynomial );
+	}
+
+	inline __m128 Sin_approximate( const __m128 i_x )
+	{
+		const auto x_squared = _mm_mul_ps( i_x, i_x );
+		auto polynomial = _mm_set1_ps( s_sinCoefficients[5] );
+		for ( int i = 4; i >= 0; i-- )
+		{
+			polynomial = _mm_add_ps( _mm_mul_ps( polynomial, x_squared ), _mm_set1_ps( s_sinCoefficients[i] ) );
+		}
+		return _mm_mul_ps( i_x, polynomial );
+	}
+
+	// i_from * i_weight_from + i_to * i_weight_to, normalized
+	inline sLanes Blend( const sLanes& i_from, const __m128 i_weight_from, const sLanes& i_to, const __m128 i_weight_to )
+	{
+		return Normalize( {
+			_mm_add_ps( _mm_mul_ps( i_from.w, i_weight_from ), _mm_mul_ps( i_to.w, i_weight_to ) ),
+			_mm_add_ps( _mm_mul_ps( i_from.x, i_weight_from ), _mm_mul_ps( i_to.x, i_weight_to ) ),
+			_mm_add_ps( _mm_mul_ps( i_from.y, i_weight_from ), _mm_mul_ps( i_to.y, i_weight_to ) ),
+			_mm_add_ps( _mm_mul_ps( i_from.z, i_weight_from ), _mm_mul_ps( i_to.z, i_weight_to ) ) } );
+	}
+
+	// Negates i_to where the dot product is negative so that it is on the shorter arc from i_from,
+	// and returns the (now positive) dot product
+	inline __m128 MakeShortestArc( const sLanes& i_from, sLanes& io_to )
+	{
+		const auto dot = Dot( i_from, io_to );
+		const auto sign = _mm_and_ps( dot, _mm_set1_ps( -0.0f ) );
+		io_to.w = _mm_xor_ps( io_to.w, sign );
+		io_to.x = _mm_xor_ps( io_to.x, sign );
+		io_to.y = _mm_xor_ps( io_to.y, sign );
+		io_to.z = _mm_xor_ps( io_to.z, sign );
+		return _mm_xor_ps( dot, sign );
+	}
+
+	inline sLanes Nlerp( const sLanes& i_from, sLanes i_to, const float i_t )
+	{
+		MakeShortestArc( i_from, i_to );
+		return Blend( i_from, _mm_set1_ps( 1.0f - i_t ), i_to, _mm_set1_ps( i_t ) );
+	}
+
+	inline sLanes Slerp( const sLanes& i_from, sLanes i_to, const float i_t )
+	{
+		const auto cosine = _mm_min_ps( MakeShortestArc( i_from, i_to ), _mm_set1_ps( 1.0f ) );
+		// sin( ( 1 - t ) * theta ) / sin( theta ) and sin( t * theta ) / sin( theta ),
+		// but the division can be skipped because the result is normalized anyway
+		const auto theta = Acos_approximate( cosine );
+		const auto weight_from_slerp = Sin_approximate( _mm_mul_ps( _mm_set1_ps( 1.0f - i_t ), theta ) );
+		const auto weight_to_slerp = Sin_approximate( _mm_mul_ps( _mm_set1_ps( i_t ), theta ) );
+		const auto shouldNlerp = _mm_cmpgt_ps( cosine, _mm_set1_ps( s_slerpCosineThreshold ) );
+		const auto weight_from = _mm_or_ps( _mm_and_ps( shouldNlerp, _mm_set1_ps( 1.0f - i_t ) ), _mm_andnot_ps( shouldNlerp, weight_from_slerp ) );
+		const auto weight_to = _mm_or_ps( _mm_and_ps( shouldNlerp, _mm_set1_ps( i_t ) ), _mm_andnot_ps( shouldNlerp, weight_to_slerp ) );
+		return Blend( i_from, weight_from, i_to, weight_to );
+	}
+
+#else
+
+	inline float Acos_approximate( const float i_x )
+	{
+		auto polynomial = s_acosCoefficients[7];
+		for ( int i = 6; i >= 0; i-- )
+		{
+			polynomial = ( polynomial * i_x ) + s_acosCoefficients[i];
+		}
+		return eae6320::Math::Sqrt( 1.0f - i_x ) * polynomial;
+	}
+
+	inline float Sin_approximate( const float i_x )
+	{
+		const auto x_squared = i_x * i_x;
+		auto polynomial = s_sinCoefficients[5];
+		for ( int i = 4; i >= 0; i-- )
+		{
+			polynomial = ( polynomial * x_squared ) + s_sinCoefficients[i];
+		}
+		return i_x * polynomial;
+	}
+
+	void Blend( const eae6320::Math::cQuaternion::sArrays_const& i_from, const float i_weight_from,
+		const float i_to_w, const float i_to_x, const float i_to_y, const float i_to_z, const float i_weight_to,
+		const size_t i_index, const eae6320::Math::cQuaternion::sArrays& o_results )
+	{
+		const auto w = ( i_from.w[i_index] * i_weight_from ) + ( i_to_w * i_weight_to );
+		const auto x = ( i_from.x[i_index] * i_weight_from ) + ( i_to_x * i_weight_to );
+		const auto y = ( i_from.y[i_index] * i_weight_from ) + ( i_to_y * i_weight_to );
+		const auto z = ( i_from.z[i_index] * i_weight_from ) + ( i_to_z * i_weight_to );
+		const auto length_reciprocal = 1.0f / eae6320::Math::Sqrt( ( w * w ) + ( x * x ) + ( y * y ) + ( z * z ) );
+		o_results.w[i_index] = w * length_reciprocal;
+		o_results.x[i_index] = x * length_reciprocal;
+		o_results.y[i_index] = y * length_reciprocal;
+		o_results.z[i_index] = z * length_reciprocal;
+	}
+
+	// Returns i_to's component negated if needed to be on the shorter arc from i_from, and the (positive) dot product
+	inline float MakeShortestArc( const eae6320::Math::cQuaternion::sArrays_const& i_from, const eae6320::Math::cQuaternion::sArrays_const& i_to,
+		const size_t i_index, float& o_w, float& o_x, float& o_y, float& o_z )
+	{
+		const auto dot = ( i_from.w[i_index] * i_to.w[i_index] ) + ( i_from.x[i_index] * i_to.x[i_index] )
+			+ ( i_from.y[i_index] * i_to.y[i_index] ) + ( i_from.z[i_index] * i_to.z[i_index] );
+		const auto sign = dot < 0.0f ? -1.0f : 1.0f;
+		o_w = i_to.w[i_index] * sign;
+		o_x = i_to.x[i_index] * sign;
+		o_y = i_to.y[i_index] * sign;
+		o_z = i_to.z[i_index] * sign;
+		return dot * sign;
+	}
+
+#endif
 }
 
 // Interface
@@ -65,7 +305,7 @@ eae6320::Math::cQuaternion eae6320::Math::cQuaternion::GetInverse() const
 
 void eae6320::Math::cQuaternion::Normalize()
 {
-	const auto length = std::sqrt( ( m_w * m_w ) + ( m_x * m_x ) + ( m_y * m_y ) + ( m_z * m_z ) );
+	const auto length = Sqrt( ( m_w * m_w ) + ( m_x * m_x ) + ( m_y * m_y ) + ( m_z * m_z ) );
 	EAE6320_ASSERTF( length > s_epsilon, "Can't divide by zero" );
 	const auto length_reciprocal = 1.0f / length;
 	m_w *= length_reciprocal;
@@ -76,7 +316,7 @@ void eae6320::Math::cQuaternion::Normalize()
 
 eae6320::Math::cQuaternion eae6320::Math::cQuaternion::GetNormalized() const
 {
-	const auto length = std::sqrt( ( m_w * m_w ) + ( m_x * m_x ) + ( m_y * m_y ) + ( m_z * m_z ) );
+	const auto length = Sqrt( ( m_w * m_w ) + ( m_x * m_x ) + ( m_y * m_y ) + ( m_z * m_z ) );
 	EAE6320_ASSERTF( length > s_epsilon, "Can't divide by zero" );
 	const auto length_reciprocal = 1.0f / length;
 	return cQuaternion( m_w * length_reciprocal, m_x * length_reciprocal, m_y * length_reciprocal, m_z * length_reciprocal );
@@ -90,6 +330,132 @@ float eae6320::Math::Dot( const cQuaternion i_lhs, const cQuaternion i_rhs )
 	return ( i_lhs.m_w * i_rhs.m_w ) + ( i_lhs.m_x * i_rhs.m_x ) + ( i_lhs.m_y * i_rhs.m_y ) + ( i_lhs.m_z * i_rhs.m_z );
 }
 
+// Batches
+//--------
+
+eae6320::Math::cQuaternion::sArrays_const::sArrays_const( const float* const i_w, const float* const i_x, const float* const i_y, const float* const i_z )
+	:
+	w( i_w ), x( i_x ), y( i_y ), z( i_z )
+{
+
+}
+
+eae6320::Math::cQuaternion::sArrays_const::sArrays_const( const sArrays& i_arrays )
+	:
+	w( i_arrays.w ), x( i_arrays.x ), y( i_arrays.y ), z( i_arrays.z )
+{
+
+}
+
+void eae6320::Math::cQuaternion::Multiply( const sArrays_const& i_lhs, const sArrays_const& i_rhs, const size_t i_count, const sArrays& o_products )
+{
+#ifdef EAE6320_MATH_ISSSEENABLED
+	size_t i = 0;
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		Store( ::Multiply( Load( i_lhs, i ), Load( i_rhs, i ) ), i, o_products );
+	}
+	if ( i < i_count )
+	{
+		const auto count = i_count - i;
+		Store_partial( ::Multiply( Load_partial( i_lhs, i, count ), Load_partial( i_rhs, i, count ) ), i, count, o_products );
+	}
+#else
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		const auto product = CreateFromComponents( i_lhs.w[i], i_lhs.x[i], i_lhs.y[i], i_lhs.z[i] )
+			* CreateFromComponents( i_rhs.w[i], i_rhs.x[i], i_rhs.y[i], i_rhs.z[i] );
+		o_products.w[i] = product.m_w;
+		o_products.x[i] = product.m_x;
+		o_products.y[i] = product.m_y;
+		o_products.z[i] = product.m_z;
+	}
+#endif
+}
+
+void eae6320::Math::cQuaternion::Normalize( const sArrays& io_quaternions, const size_t i_count )
+{
+#ifdef EAE6320_MATH_ISSSEENABLED
+	size_t i = 0;
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		Store( ::Normalize( Load( io_quaternions, i ) ), i, io_quaternions );
+	}
+	if ( i < i_count )
+	{
+		const auto count = i_count - i;
+		Store_partial( ::Normalize( Load_partial( io_quaternions, i, count ) ), i, count, io_quaternions );
+	}
+#else
+	// Without SSE there is no reciprocal square root estimate, so this is the same as Normalize()
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		const auto w = io_quaternions.w[i], x = io_quaternions.x[i], y = io_quaternions.y[i], z = io_quaternions.z[i];
+		const auto length_reciprocal = 1.0f / eae6320::Math::Sqrt( ( w * w ) + ( x * x ) + ( y * y ) + ( z * z ) );
+		io_quaternions.w[i] = w * length_reciprocal;
+		io_quaternions.x[i] = x * length_reciprocal;
+		io_quaternions.y[i] = y * length_reciprocal;
+		io_quaternions.z[i] = z * length_reciprocal;
+	}
+#endif
+}
+
+void eae6320::Math::cQuaternion::Nlerp( const sArrays_const& i_from, const sArrays_const& i_to, const float i_t, const size_t i_count, const sArrays& o_results )
+{
+#ifdef EAE6320_MATH_ISSSEENABLED
+	size_t i = 0;
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		Store( ::Nlerp( Load( i_from, i ), Load( i_to, i ), i_t ), i, o_results );
+	}
+	if ( i < i_count )
+	{
+		const auto count = i_count - i;
+		Store_partial( ::Nlerp( Load_partial( i_from, i, count ), Load_partial( i_to, i, count ), i_t ), i, count, o_results );
+	}
+#else
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		float w, x, y, z;
+		MakeShortestArc( i_from, i_to, i, w, x, y, z );
+		Blend( i_from, 1.0f - i_t, w, x, y, z, i_t, i, o_results );
+	}
+#endif
+}
+
+void eae6320::Math::cQuaternion::Slerp( const sArrays_const& i_from, const sArrays_const& i_to, const float i_t, const size_t i_count, const sArrays& o_results )
+{
+#ifdef EAE6320_MATH_ISSSEENABLED
+	size_t i = 0;
+	for ( ; ( i + 4 ) <= i_count; i += 4 )
+	{
+		Store( ::Slerp( Load( i_from, i ), Load( i_to, i ), i_t ), i, o_results );
+	}
+	if ( i < i_count )
+	{
+		const auto count = i_count - i;
+		Store_partial( ::Slerp( Load_partial( i_from, i, count ), Load_partial( i_to, i, count ), i_t ), i, count, o_results );
+	}
+#else
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		float w, x, y, z;
+		auto cosine = MakeShortestArc( i_from, i_to, i, w, x, y, z );
+		cosine = cosine < 1.0f ? cosine : 1.0f;
+		if ( cosine > s_slerpCosineThreshold )
+		{
+			Blend( i_from, 1.0f - i_t, w, x, y, z, i_t, i, o_results );
+		}
+		else
+		{
+			// The division by sin( theta ) can be skipped because the result is normalized anyway
+			const auto theta = Acos_approximate( cosine );
+			Blend( i_from, Sin_approximate( ( 1.0f - i_t ) * theta ), w, x, y, z, Sin_approximate( i_t * theta ), i, o_results );
+		}
+	}
+#endif
+}
+
 // Access
 //-------
 
@@ -107,19 +473,44 @@ eae6320::Math::sVector eae6320::Math::cQuaternion::CalculateForwardDirection() c
 	return sVector( -_2xz - _2yw, -_2yz + _2xw, -1.0f + _2xx + _2yy );
 }
 
+float eae6320::Math::cQuaternion::GetW() const
+{
+	return m_w;
+}
+
+float eae6320::Math::cQuaternion::GetX() const
+{
+	return m_x;
+}
+
+float eae6320::Math::cQuaternion::GetY() const
+{
+	return m_y;
+}
+
+float eae6320::Math::cQuaternion::GetZ() const
+{
+	return m_z;
+}
+
 // Initialization / Shut Down
 //---------------------------
 
 eae6320::Math::cQuaternion::cQuaternion( const float i_angleInRadians, const sVector i_axisOfRotation_normalized )
 {
 	const auto theta_half = i_angleInRadians * 0.5f;
-	m_w = std::cos( theta_half );
-	const auto sin_theta_half = std::sin( theta_half );
+	m_w = Cos( theta_half );
+	const auto sin_theta_half = Sin( theta_half );
 	m_x = i_axisOfRotation_normalized.x * sin_theta_half;
 	m_y = i_axisOfRotation_normalized.y * sin_theta_half;
 	m_z = i_axisOfRotation_normalized.z * sin_theta_half;
 }
 
+eae6320::Math::cQuaternion eae6320::Math::cQuaternion::CreateFromComponents( const float i_w, const float i_x, const float i_y, const float i_z )
+{
+	return cQuaternion( i_w, i_x, i_y, i_z );
+}
+
 // Implementation
 //===============
 
@@ -5,6 +5,11 @@
 #ifndef EAE6320_MATH_CQUATERNION_H
 #define EAE6320_MATH_CQUATERNION_H
 
+// Includes
+//=========
+
+#include <cstddef>
+
 // Forward Declarations
 //=====================
 
@@ -55,6 +60,43 @@ namespace eae6320
 
 			friend float Dot( const cQuaternion i_lhs, const cQuaternion i_rhs );
 
+			// Batches
+			//--------
+
+			// Quaternions whose components are stored in four separate arrays (SoA),
+			// which lets the batch functions work on four of them at once
+			struct sArrays
+			{
+				float* w;
+				float* x;
+				float* y;
+				float* z;
+			};
+			struct sArrays_const
+			{
+				const float* w;
+				const float* x;
+				const float* y;
+				const float* z;
+
+				sArrays_const( const float* const i_w, const float* const i_x, const float* const i_y, const float* const i_z );
+				sArrays_const( const sArrays& i_arrays );
+			};
+
+			// o_products[i] = i_lhs[i] * i_rhs[i], with the same results as operator *();
+			// the products can be written over either input
+			static void Multiply( const sArrays_const& i_lhs, const sArrays_const& i_rhs, const size_t i_count, const sArrays& o_products );
+			// Instead of a square root and a division this uses a reciprocal square root estimate refined by one Newton-Raphson step,
+			// so the lengths are only 1 to within a few ulps (which is enough to keep an integrated orientation from drifting).
+			// With EAE6320_MATH_ISDETERMINISTIC defined it uses a square root and a division instead (see Configuration.h)
+			static void Normalize( const sArrays& io_quaternions, const size_t i_count );
+			// These interpolate from i_from[i] (when i_t is 0) to i_to[i] (when i_t is 1) along the shorter arc,
+			// and the results are normalized the same way as Normalize() and can be written over either input.
+			// Nlerp() is cheaper but doesn't rotate at a constant speed as i_t changes;
+			// Slerp() does, using polynomial approximations of acos and sin (the results are within about 4e-7 of an exact slerp)
+			static void Nlerp( const sArrays_const& i_from, const sArrays_const& i_to, const float i_t, const size_t i_count, const sArrays& o_results );
+			static void Slerp( const sArrays_const& i_from, const sArrays_const& i_to, const float i_t, const size_t i_count, const sArrays& o_results );
+
 			// Access
 			//-------
 
@@ -62,6 +104,12 @@ namespace eae6320
 			// if the transform is already available or will need to be calculated in the future
 			// it is more efficient to extract the forward direction from that
 			sVector CalculateForwardDirection() const;
+			// The raw components are only needed by code that stores quaternions in its own layout
+			// (e.g. the SoA arrays of a physics world)
+			float GetW() const;
+			float GetX() const;
+			float GetY() const;
+			float GetZ() const;
 
 			// Initialization / Shut Down
 			//---------------------------
@@ -69,6 +117,8 @@ namespace eae6320
 			cQuaternion() = default;	// Identity
 			cQuaternion( const float i_angleInRadians,	// A positive angle rotates counter-clockwise (right-handed) around the axis
 				const sVector i_axisOfRotation_normalized );
+			// The components are used as is, so the caller is responsible for normalizing them
+			static cQuaternion CreateFromComponents( const float i_w, const float i_x, const float i_y, const float i_z );
 
 			// Data
 			//=====
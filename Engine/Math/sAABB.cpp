@@ -0,0 +1,91 @@
+// Includes
+//=========
+
+#include "sAABB.h"
+
+#include "cMatrix_transformation.h"
+
+#include <cmath>
+
+// Interface
+//==========
+
+// Access
+//-------
+
+eae6320::Math::sVector eae6320::Math::sAABB::GetCenter() const
+{
+	return ( minimum + maximum ) * 0.5f;
+}
+
+eae6320::Math::sVector eae6320::Math::sAABB::GetExtents() const
+{
+	return ( maximum - minimum ) * 0.5f;
+}
+
+// Tests
+//------
+
+bool eae6320::Math::sAABB::Contains( const sVector i_point ) const
+{
+	// Use & rather than && to prevent branches (all six comparisons will be evaluated)
+	return ( i_point.x >= minimum.x ) & ( i_point.x <= maximum.x )
+		& ( i_point.y >= minimum.y ) & ( i_point.y <= maximum.y )
+		& ( i_point.z >= minimum.z ) & ( i_point.z <= maximum.z );
+}
+
+bool eae6320::Math::sAABB::Overlaps( const sAABB& i_other ) const
+{
+	return ( minimum.x <= i_other.maximum.x ) & ( maximum.x >= i_other.minimum.x )
+		& ( minimum.y <= i_other.maximum.y ) & ( maximum.y >= i_other.minimum.y )
+		& ( minimum.z <= i_other.maximum.z ) & ( maximum.z >= i_other.minimum.z );
+}
+
+// Transformation
+//---------------
+
+eae6320::Math::sAABB eae6320::Math::sAABB::GetTransformed( const cMatrix_transformation& i_transform ) const
+{
+	// The center is transformed like a point,
+	// and each new extent is the sum of the old extents scaled by the absolute rotation
+	const auto center = i_transform * GetCenter();
+	const auto extents = GetExtents();
+	const auto& right = i_transform.GetRightDirection();
+	const auto& up = i_transform.GetUpDirection();
+	const auto& back = i_transform.GetBackDirection();
+	const sVector extents_transformed(
+		( std::abs( right.x ) * extents.x ) + ( std::abs( up.x ) * extents.y ) + ( std::abs( back.x ) * extents.z ),
+		( std::abs( right.y ) * extents.x ) + ( std::abs( up.y ) * extents.y ) + ( std::abs( back.y ) * extents.z ),
+		( std::abs( right.z ) * extents.x ) + ( std::abs( up.z ) * extents.y ) + ( std::abs( back.z ) * extents.z ) );
+	return sAABB( center - extents_transformed, center + extents_transformed );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Math::sAABB::sAABB( const sVector i_minimum, const sVector i_maximum )
+	:
+	minimum( i_minimum ), maximum( i_maximum )
+{
+
+}
+
+eae6320::Math::sAABB eae6320::Math::sAABB::CreateFromPoints( const sVector* const i_points, const size_t i_count )
+{
+	if ( i_count == 0 )
+	{
+		return sAABB();
+	}
+	sAABB bounds( i_points[0], i_points[0] );
+	for ( size_t i = 1; i < i_count; i++ )
+	{
+		const auto& point = i_points[i];
+		bounds.minimum.x = point.x < bounds.minimum.x ? point.x : bounds.minimum.x;
+		bounds.minimum.y = point.y < bounds.minimum.y ? point.y : bounds.minimum.y;
+		bounds.minimum.z = point.z < bounds.minimum.z ? point.z : bounds.minimum.z;
+		bounds.maximum.x = point.x > bounds.maximum.x ? point.x : bounds.maximum.x;
+		bounds.maximum.y = point.y > bounds.maximum.y ? point.y : bounds.maximum.y;
+		bounds.maximum.z = point.z > bounds.maximum.z ? point.z : bounds.maximum.z;
+	}
+	return bounds;
+}
@@ -0,0 +1,73 @@
+/*
+	This struct represents an axis-aligned bounding box
+*/
+
+#ifndef EAE6320_MATH_SAABB_H
+#define EAE6320_MATH_SAABB_H
+
+// Includes
+//=========
+
+#include "sVector.h"
+
+#include <cstddef>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cMatrix_transformation;
+	}
+}
+
+// Struct Declaration
+//===================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		struct sAABB
+		{
+			// Data
+			//=====
+
+			sVector minimum;
+			sVector maximum;
+
+			// Interface
+			//==========
+
+			// Access
+			//-------
+
+			sVector GetCenter() const;
+			// Half of the size along each axis
+			sVector GetExtents() const;
+
+			// Tests
+			//------
+
+			bool Contains( const sVector i_point ) const;
+			bool Overlaps( const sAABB& i_other ) const;
+
+			// Transformation
+			//---------------
+
+			// The smallest axis-aligned box that contains this box after it is transformed
+			sAABB GetTransformed( const cMatrix_transformation& i_transform ) const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			sAABB() = default;
+			sAABB( const sVector i_minimum, const sVector i_maximum );
+			static sAABB CreateFromPoints( const sVector* const i_points, const size_t i_count );
+		};
+	}
+}
+
+#endif	// EAE6320_MATH_SAABB_H
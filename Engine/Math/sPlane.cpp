@@ -0,0 +1,31 @@
+// Includes
+//=========
+
+#include "sPlane.h"
+
+// Interface
+//==========
+
+// Distance
+//---------
+
+float eae6320::Math::sPlane::GetSignedDistance( const sVector i_point ) const
+{
+	// The products are summed in the same order as the batch culling kernels in cFrustum
+	return ( ( normal.x * i_point.x ) + ( normal.y * i_point.y ) + ( normal.z * i_point.z ) ) - distance;
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Math::sPlane::sPlane( const sVector i_normal, const float i_distance )
+	:
+	normal( i_normal ), distance( i_distance )
+{
+
+}
+
+eae6320::Math::sPlane eae6320::Math::sPlane::CreateFromPointAndNormal( const sVector i_point, const sVector i_normal )
+{
+	return sPlane( i_normal, Dot( i_normal, i_point ) );
+}
@@ -0,0 +1,49 @@
+/*
+	This struct represents an infinite plane
+*/
+
+#ifndef EAE6320_MATH_SPLANE_H
+#define EAE6320_MATH_SPLANE_H
+
+// Includes
+//=========
+
+#include "sVector.h"
+
+// Struct Declaration
+//===================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		struct sPlane
+		{
+			// Data
+			//=====
+
+			// Points on the plane satisfy Dot( normal, point ) == distance,
+			// and the normal points to the side with positive signed distances
+			sVector normal = sVector( 0.0f, 1.0f, 0.0f );
+			float distance = 0.0f;
+
+			// Interface
+			//==========
+
+			// Distance
+			//---------
+
+			// Only a distance in world units if the normal is normalized
+			float GetSignedDistance( const sVector i_point ) const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			sPlane() = default;
+			sPlane( const sVector i_normal, const float i_distance );
+			static sPlane CreateFromPointAndNormal( const sVector i_point, const sVector i_normal );
+		};
+	}
+}
+
+#endif	// EAE6320_MATH_SPLANE_H
@@ -0,0 +1,50 @@
+// Includes
+//=========
+
+#include "sSphere.h"
+
+#include "Functions.h"
+#include "sAABB.h"
+
+// Interface
+//==========
+
+// Tests
+//------
+
+bool eae6320::Math::sSphere::Contains( const sVector i_point ) const
+{
+	return ( i_point - center ).GetLength_Sqr() <= ( radius * radius );
+}
+
+bool eae6320::Math::sSphere::Overlaps( const sSphere& i_other ) const
+{
+	const auto radii = radius + i_other.radius;
+	return ( i_other.center - center ).GetLength_Sqr() <= ( radii * radii );
+}
+
+// Initialization / Clean Up
+//--------------------------
+
+eae6320::Math::sSphere::sSphere( const sVector i_center, const float i_radius )
+	:
+	center( i_center ), radius( i_radius )
+{
+
+}
+
+eae6320::Math::sSphere eae6320::Math::sSphere::CreateFromPoints( const sVector* const i_points, const size_t i_count )
+{
+	if ( i_count == 0 )
+	{
+		return sSphere();
+	}
+	const auto center = sAABB::CreateFromPoints( i_points, i_count ).GetCenter();
+	auto radius_squared = 0.0f;
+	for ( size_t i = 0; i < i_count; i++ )
+	{
+		const auto distance_squared = ( i_points[i] - center ).GetLength_Sqr();
+		radius_squared = distance_squared > radius_squared ? distance_squared : radius_squared;
+	}
+	return sSphere( center, Sqrt( radius_squared ) );
+}
@@ -0,0 +1,53 @@
+/*
+	This struct represents a bounding sphere
+*/
+
+#ifndef EAE6320_MATH_SSPHERE_H
+#define EAE6320_MATH_SSPHERE_H
+
+// Includes
+//=========
+
+#include "sVector.h"
+
+#include <cstddef>
+
+// Struct Declaration
+//===================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		struct sSphere
+		{
+			// Data
+			//=====
+
+			sVector center;
+			float radius = 0.0f;
+
+			// Interface
+			//==========
+
+			// Tests
+			//------
+
+			bool Contains( const sVector i_point ) const;
+			bool Overlaps( const sSphere& i_other ) const;
+
+			// Initialization / Clean Up
+			//--------------------------
+
+			sSphere() = default;
+			sSphere( const sVector i_center, const float i_radius );
+			// Centered on the bounding box of the points, which is cheap and usually close to the smallest sphere
+			static sSphere CreateFromPoints( const sVector* const i_points, const size_t i_count );
+		};
+
+		// An array of spheres is read four at a time by the batch culling kernels, one sphere per register
+		static_assert( sizeof( sSphere ) == ( 4 * sizeof( float ) ), "A sphere must be exactly x, y, z, and the radius" );
+	}
+}
+
+#endif	// EAE6320_MATH_SSPHERE_H
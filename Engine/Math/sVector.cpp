@@ -3,6 +3,8 @@
 
 #include "sVector.h"
 
+#include "Functions.h"
+
 #include <cmath>
 #include <Engine/Asserts/Asserts.h>
 
@@ -147,7 +149,7 @@ float eae6320::Math::sVector::GetLength() const
 {
 	const auto length_squared = ( x * x ) + ( y * y ) + ( z * z );
 	EAE6320_ASSERTF( length_squared >= 0.0f, "Can't take a square root of a negative number" );
-	return std::sqrt( length_squared );
+	return Sqrt( length_squared );
 }
 
 float eae6320::Math::sVector::GetLength_Sqr() const
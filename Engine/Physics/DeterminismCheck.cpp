@@ -0,0 +1,167 @@
+// Includes
+//=========
+
+#include "DeterminismCheck.h"
+
+#include "cRigidBodyWorld.h"
+#include "cStateHash.h"
+#include "sRigidBodyState.h"
+
+#include <Engine/Logging/Logging.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/Configuration.h>
+#include <Engine/PhysicsSystem/PhysicsSystem.h>
+#include <vector>
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// The standard library's distributions aren't specified exactly,
+	// so the scene is made from a linear congruential generator that is the same everywhere
+	class cRandom
+	{
+	public:
+
+		float Get( const float i_min, const float i_max )
+		{
+			m_state = ( m_state * 1664525u ) + 1013904223u;
+			// The top 24 bits are converted to a float exactly
+			return i_min + ( ( i_max - i_min ) * ( static_cast<float>( m_state >> 8 ) * ( 1.0f / 16777216.0f ) ) );
+		}
+
+		eae6320::Math::sVector GetVector( const float i_min, const float i_max )
+		{
+			const auto x = Get( i_min, i_max );
+			const auto y = Get( i_min, i_max );
+			const auto z = Get( i_min, i_max );
+			return eae6320::Math::sVector( x, y, z );
+		}
+
+	private:
+
+		uint32_t m_state = 6320u;
+	};
+
+	void AddToHash( const PlutoShe::Physics::Vector3& i_vector, eae6320::Physics::cStateHash& io_hash )
+	{
+		io_hash.Add( i_vector.m_x );
+		io_hash.Add( i_vector.m_y );
+		io_hash.Add( i_vector.m_z );
+	}
+}
+
+// Interface
+//==========
+
+uint64_t eae6320::Physics::DeterminismCheck::SimulateReferenceScene( const unsigned int i_tickCount )
+{
+	constexpr size_t rowLength = 8;
+	constexpr size_t bodyCount = rowLength * rowLength;
+	constexpr auto secondCountPerTick = 1.0f / 60.0f;
+
+	// Bodies
+	cRigidBodyWorld world;
+	std::vector<sRigidBodyState> states;
+	std::vector<PlutoShe::Physics::Collider> colliders;
+	{
+		cRandom random;
+		std::vector<PlutoShe::Physics::Vector3> hullPoints;
+		for ( size_t i = 0; i < bodyCount; i++ )
+		{
+			// A grid of bodies a little further apart than their size, all drifting and spinning, so that neighbors keep colliding
+			sRigidBodyState state;
+			state.position = Math::sVector( static_cast<float>( i % rowLength ) * 1.25f, random.Get( -0.25f, 0.25f ), static_cast<float>( i / rowLength ) * 1.25f );
+			state.velocity = random.GetVector( -1.0f, 1.0f );
+			state.acceleration = Math::sVector( 0.0f, random.Get( -0.5f, 0.5f ), 0.0f );
+			state.orientation = Math::cQuaternion( random.Get( -3.0f, 3.0f ), random.GetVector( 0.1f, 1.0f ).GetNormalized() );
+			state.angularVelocity_axis_local = random.GetVector( -1.0f, 1.0f ).GetNormalized();
+			// Some bodies don't spin so that they can fall asleep
+			state.angularSpeed = ( i % 3 ) == 0 ? 0.0f : random.Get( -4.0f, 4.0f );
+			world.AddBody( state );
+			states.push_back( state );
+
+			if ( ( i % 2 ) == 0 )
+			{
+				colliders.push_back( PlutoShe::Physics::Collider::CreateBox( random.GetVector( 0.3f, 0.5f ) ) );
+			}
+			else
+			{
+				hullPoints.clear();
+				for ( size_t j = 0; j < 12; j++ )
+				{
+					hullPoints.push_back( random.GetVector( -0.5f, 0.5f ) );
+				}
+				colliders.push_back( PlutoShe::Physics::Collider( hullPoints ) );
+			}
+		}
+	}
+
+	cStateHash hash;
+	for ( unsigned int tick = 0; tick < i_tickCount; tick++ )
+	{
+		world.Update( secondCountPerTick );
+		for ( auto& state : states )
+		{
+			state.Update( secondCountPerTick );
+		}
+		for ( size_t i = 0; i < bodyCount; i++ )
+		{
+			colliders[i].UpdateTransformation( world.PredictFutureTransform( i, 0.0f ) );
+		}
+		// Each body is tested against its neighbors in the grid
+		for ( size_t i = 0; i < bodyCount; i++ )
+		{
+			const size_t neighbors[] = { i + 1, i + rowLength };
+			for ( const auto j : neighbors )
+			{
+				if ( ( j >= bodyCount ) || ( ( j == ( i + 1 ) ) && ( ( j % rowLength ) == 0 ) ) )
+				{
+					continue;
+				}
+				PlutoShe::Physics::sContact contact;
+				if ( colliders[i].IsCollided( colliders[j], contact ) )
+				{
+					AddToHash( contact.m_normal, hash );
+					hash.Add( contact.m_depth );
+					// Push the bodies apart so that the contacts feed back into the simulation
+					const auto push = Math::sVector( contact.m_normal.m_x, contact.m_normal.m_y, contact.m_normal.m_z ) * ( contact.m_depth + 0.1f );
+					world.ApplyImpulse( i, -push );
+					world.ApplyImpulse( j, push );
+					world.AddContact( i, j );
+				}
+				else
+				{
+					PlutoShe::Physics::sDistanceResult distance;
+					colliders[i].Distance( colliders[j], distance );
+					hash.Add( distance.m_distance );
+					AddToHash( distance.m_pointOnA, hash );
+				}
+			}
+		}
+	}
+	world.AddToHash( hash );
+	for ( const auto& state : states )
+	{
+		hash.Add( state );
+	}
+	return hash.GetValue();
+}
+
+eae6320::cResult eae6320::Physics::DeterminismCheck::Run()
+{
+	const auto hash = SimulateReferenceScene( s_referenceTickCount );
+	if ( hash == s_referenceHash )
+	{
+		Logging::OutputMessage( "The simulation is deterministic (the reference scene's hash is %016llx)",
+			static_cast<unsigned long long>( hash ) );
+		return Results::Success;
+	}
+	else
+	{
+		Logging::OutputError( "The simulation isn't deterministic: The reference scene's hash is %016llx but should be %016llx",
+			static_cast<unsigned long long>( hash ), static_cast<unsigned long long>( s_referenceHash ) );
+		return Results::Failure;
+	}
+}
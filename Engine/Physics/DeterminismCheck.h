@@ -0,0 +1,49 @@
+/*
+	The determinism check simulates a fixed scene of rigid bodies and colliders
+	and hashes its state, so that builds that are supposed to simulate identically
+	(e.g. the Direct3D and OpenGL builds of a lockstep game, or builds from different compilers)
+	can be compared
+
+	It is only meaningful with EAE6320_MATH_ISDETERMINISTIC defined (see Engine/Math/Configuration.h);
+	otherwise the hash depends on the compiler, the CPU, and the C runtime
+*/
+
+#ifndef EAE6320_PHYSICS_DETERMINISMCHECK_H
+#define EAE6320_PHYSICS_DETERMINISMCHECK_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Physics
+	{
+		namespace DeterminismCheck
+		{
+			// The scene exercises sRigidBodyState::Update(), cRigidBodyWorld (including sleeping),
+			// the matrix and quaternion math, and GJK, EPA, and distance queries between colliders.
+			// Every tick's contacts and distances are hashed along with the final state of the bodies
+			uint64_t SimulateReferenceScene( const unsigned int i_tickCount );
+
+			constexpr unsigned int s_referenceTickCount = 600;
+			// The hash of the reference scene after s_referenceTickCount ticks,
+			// recorded from deterministic x64 builds made with GCC (-O0 to -O3, with and without FMA hardware).
+			// The "determinism" benchmark in Tools/PhysicsBenchmark prints the hash of the build it is in
+			// and is how the MSVC x64 and Win32 builds are checked against it
+			constexpr uint64_t s_referenceHash = 0x393bb39fd80376b7u;
+
+			// Simulates the reference scene and compares its hash to s_referenceHash,
+			// logging both if they are different.
+			// Games don't run it at startup, it simulates every tick of the scene and a mismatch is for the developer to look into
+			cResult Run();
+		}
+	}
+}
+
+#endif	// EAE6320_PHYSICS_DETERMINISMCHECK_H
@@ -0,0 +1,475 @@
+// Includes
+//=========
+
+#include "cRigidBodyWorld.h"
+
+#include "cStateHash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/Functions.h>
+
+// Interface
+//==========
+
+// Bodies
+//-------
+
+size_t eae6320::Physics::cRigidBodyWorld::AddBody( const sRigidBodyState& i_state )
+{
+	const auto body = m_angularSpeed.size();
+	m_position.Add( i_state.position );
+	m_velocity.Add( i_state.velocity );
+	m_acceleration.Add( i_state.acceleration );
+	m_orientationW.push_back( i_state.orientation.GetW() );
+	m_orientationX.push_back( i_state.orientation.GetX() );
+	m_orientationY.push_back( i_state.orientation.GetY() );
+	m_orientationZ.push_back( i_state.orientation.GetZ() );
+	m_angularVelocityAxis_local.Add( i_state.angularVelocity_axis_local );
+	m_angularSpeed.push_back( i_state.angularSpeed );
+	m_isAwake.push_back( 1 );
+	m_sleepTimer.push_back( 0.0f );
+	m_awakeBodyCount++;
+	return body;
+}
+
+void eae6320::Physics::cRigidBodyWorld::Clear()
+{
+	m_position.Clear();
+	m_velocity.Clear();
+	m_acceleration.Clear();
+	m_orientationW.clear();
+	m_orientationX.clear();
+	m_orientationY.clear();
+	m_orientationZ.clear();
+	m_angularVelocityAxis_local.Clear();
+	m_angularSpeed.clear();
+	m_isAwake.clear();
+	m_sleepTimer.clear();
+	m_contacts.clear();
+	m_awakeBodyCount = 0;
+}
+
+eae6320::Physics::sRigidBodyState eae6320::Physics::cRigidBodyWorld::GetBodyState( const size_t i_body ) const
+{
+	EAE6320_ASSERT( i_body < GetBodyCount() );
+	sRigidBodyState state;
+	state.position = m_position.Get( i_body );
+	state.velocity = m_velocity.Get( i_body );
+	state.acceleration = m_acceleration.Get( i_body );
+	state.orientation = GetOrientation( i_body );
+	state.angularVelocity_axis_local = m_angularVelocityAxis_local.Get( i_body );
+	state.angularSpeed = m_angularSpeed[i_body];
+	return state;
+}
+
+void eae6320::Physics::cRigidBodyWorld::SetBodyState( const size_t i_body, const sRigidBodyState& i_state )
+{
+	EAE6320_ASSERT( i_body < GetBodyCount() );
+	m_position.Set( i_body, i_state.position );
+	m_velocity.Set( i_body, i_state.velocity );
+	m_acceleration.Set( i_body, i_state.acceleration );
+	m_orientationW[i_body] = i_state.orientation.GetW();
+	m_orientationX[i_body] = i_state.orientation.GetX();
+	m_orientationY[i_body] = i_state.orientation.GetY();
+	m_orientationZ[i_body] = i_state.orientation.GetZ();
+	m_angularVelocityAxis_local.Set( i_body, i_state.angularVelocity_axis_local );
+	m_angularSpeed[i_body] = i_state.angularSpeed;
+	WakeBody( i_body );
+}
+
+eae6320::Math::sVector eae6320::Physics::cRigidBodyWorld::GetPosition( const size_t i_body ) const
+{
+	return m_position.Get( i_body );
+}
+
+eae6320::Math::sVector eae6320::Physics::cRigidBodyWorld::GetVelocity( const size_t i_body ) const
+{
+	return m_velocity.Get( i_body );
+}
+
+eae6320::Math::cQuaternion eae6320::Physics::cRigidBodyWorld::GetOrientation( const size_t i_body ) const
+{
+	return Math::cQuaternion::CreateFromComponents( m_orientationW[i_body], m_orientationX[i_body], m_orientationY[i_body], m_orientationZ[i_body] );
+}
+
+void eae6320::Physics::cRigidBodyWorld::SetVelocity( const size_t i_body, const Math::sVector& i_velocity )
+{
+	m_velocity.Set( i_body, i_velocity );
+	WakeBody( i_body );
+}
+
+void eae6320::Physics::cRigidBodyWorld::SetAcceleration( const size_t i_body, const Math::sVector& i_acceleration )
+{
+	m_acceleration.Set( i_body, i_acceleration );
+	WakeBody( i_body );
+}
+
+void eae6320::Physics::cRigidBodyWorld::ApplyImpulse( const size_t i_body, const Math::sVector& i_impulse )
+{
+	m_velocity.Set( i_body, m_velocity.Get( i_body ) + i_impulse );
+	WakeBody( i_body );
+}
+
+// Sleeping
+//---------
+
+void eae6320::Physics::cRigidBodyWorld::SetSleepSettings( const sSleepSettings& i_settings )
+{
+	m_sleepSettings = i_settings;
+	if ( !m_sleepSettings.isEnabled )
+	{
+		for ( size_t i = 0; i < GetBodyCount(); i++ )
+		{
+			WakeBody( i );
+		}
+	}
+}
+
+void eae6320::Physics::cRigidBodyWorld::AddContact( const size_t i_bodyA, const size_t i_bodyB )
+{
+	EAE6320_ASSERT( ( i_bodyA < GetBodyCount() ) && ( i_bodyB < GetBodyCount() ) );
+	m_contacts.push_back( std::make_pair( i_bodyA, i_bodyB ) );
+}
+
+void eae6320::Physics::cRigidBodyWorld::WakeBody( const size_t i_body )
+{
+	m_sleepTimer[i_body] = 0.0f;
+	if ( !m_isAwake[i_body] )
+	{
+		m_isAwake[i_body] = 1;
+		m_awakeBodyCount++;
+	}
+}
+
+eae6320::Math::cMatrix_transformation eae6320::Physics::cRigidBodyWorld::PredictFutureTransform( const size_t i_body, const float i_secondCountToExtrapolate ) const
+{
+	return GetBodyState( i_body ).PredictFutureTransform( i_secondCountToExtrapolate );
+}
+
+void eae6320::Physics::cRigidBodyWorld::PredictFutureTransforms( const float i_secondCountToExtrapolate, Math::cMatrix_transformation* const o_transforms ) const
+{
+	const auto bodyCount = GetBodyCount();
+	std::vector<float> predictedOrientations( bodyCount * 4 );
+	const Math::cQuaternion::sArrays orientations =
+		{ predictedOrientations.data(), predictedOrientations.data() + bodyCount, predictedOrientations.data() + ( bodyCount * 2 ), predictedOrientations.data() + ( bodyCount * 3 ) };
+	std::copy( m_orientationW.begin(), m_orientationW.end(), orientations.w );
+	std::copy( m_orientationX.begin(), m_orientationX.end(), orientations.x );
+	std::copy( m_orientationY.begin(), m_orientationY.end(), orientations.y );
+	std::copy( m_orientationZ.begin(), m_orientationZ.end(), orientations.z );
+	RotateSpinningOrientations( 0, bodyCount, i_secondCountToExtrapolate, orientations );
+	for ( size_t i = 0; i < bodyCount; i++ )
+	{
+		const auto position = Math::sVector(
+			m_position.x[i] + ( m_velocity.x[i] * i_secondCountToExtrapolate ),
+			m_position.y[i] + ( m_velocity.y[i] * i_secondCountToExtrapolate ),
+			m_position.z[i] + ( m_velocity.z[i] * i_secondCountToExtrapolate ) );
+		o_transforms[i] = Math::cMatrix_transformation( Math::cQuaternion::CreateFromComponents(
+			orientations.w[i], orientations.x[i], orientations.y[i], orientations.z[i] ), position );
+	}
+}
+
+// Simulation
+//-----------
+
+void eae6320::Physics::cRigidBodyWorld::Update( const float i_secondCountToIntegrate )
+{
+	if ( m_awakeBodyCount > 0 )
+	{
+		Integrate( i_secondCountToIntegrate );
+		// The timers were updated during integration, so bodies that came to rest this step fall asleep before the next one
+		if ( m_sleepSettings.isEnabled )
+		{
+			UpdateSleeping();
+		}
+	}
+	m_contacts.clear();
+}
+
+void eae6320::Physics::cRigidBodyWorld::SetWorkerThreadCount( const unsigned int i_threadCount )
+{
+	m_workerThreadCount = i_threadCount < 1 ? 1 : ( i_threadCount > s_maxWorkerThreadCount ? s_maxWorkerThreadCount : i_threadCount );
+}
+
+// Determinism
+//------------
+
+void eae6320::Physics::cRigidBodyWorld::AddToHash( cStateHash& io_hash ) const
+{
+	for ( size_t i = 0; i < GetBodyCount(); i++ )
+	{
+		io_hash.Add( GetBodyState( i ) );
+		io_hash.Add( static_cast<uint32_t>( m_isAwake[i] ) );
+		io_hash.Add( m_sleepTimer[i] );
+	}
+}
+
+// Implementation
+//===============
+
+void eae6320::Physics::cRigidBodyWorld::Integrate( const float i_secondCountToIntegrate )
+{
+	const auto bodyCount = GetBodyCount();
+	auto threadCount = static_cast<size_t>( m_workerThreadCount );
+	if ( threadCount > 1 )
+	{
+		const auto usefulThreadCount = bodyCount / s_minBodyCountPerThread;
+		threadCount = usefulThreadCount < threadCount ? usefulThreadCount : threadCount;
+	}
+	if ( threadCount <= 1 )
+	{
+		UpdateRange( 0, bodyCount, i_secondCountToIntegrate );
+		return;
+	}
+
+	// Every range is disjoint, so the threads never write the same cache line except at the boundaries
+	const auto bodyCountPerThread = ( bodyCount + threadCount - 1 ) / threadCount;
+	Concurrency::cThread threads[s_maxWorkerThreadCount];
+	bool wasThreadStarted[s_maxWorkerThreadCount] = {};
+	for ( size_t i = 1; i < threadCount; i++ )
+	{
+		const auto begin = i * bodyCountPerThread;
+		const auto end = ( begin + bodyCountPerThread ) < bodyCount ? ( begin + bodyCountPerThread ) : bodyCount;
+		wasThreadStarted[i] = threads[i].Start( [this, begin, end, i_secondCountToIntegrate]( void* const )
+			{
+				UpdateRange( begin, end, i_secondCountToIntegrate );
+			} );
+		if ( !wasThreadStarted[i] )
+		{
+			// Still integrate the range rather than leaving those bodies a frame behind
+			Logging::OutputError( "A rigid body world worker thread couldn't be started" );
+			UpdateRange( begin, end, i_secondCountToIntegrate );
+		}
+	}
+	UpdateRange( 0, bodyCountPerThread, i_secondCountToIntegrate );
+	for ( size_t i = 1; i < threadCount; i++ )
+	{
+		if ( wasThreadStarted[i] )
+		{
+			const auto result_threadStop = WaitForThreadToStop( threads[i] );
+			if ( !result_threadStop )
+			{
+				EAE6320_ASSERTF( false, "Couldn't wait for a rigid body world worker thread to stop" );
+				Logging::OutputError( "A rigid body world worker thread couldn't be waited for" );
+			}
+		}
+	}
+}
+
+void eae6320::Physics::cRigidBodyWorld::UpdateSleeping()
+{
+	const auto bodyCount = GetBodyCount();
+	const auto secondCountBeforeSleep = m_sleepSettings.secondCountBeforeSleep;
+
+	if ( m_contacts.empty() )
+	{
+		// Every body is its own island
+		for ( size_t i = 0; i < bodyCount; i++ )
+		{
+			if ( m_isAwake[i] && ( m_sleepTimer[i] >= secondCountBeforeSleep ) )
+			{
+				PutBodyToSleep( i );
+			}
+		}
+		return;
+	}
+
+	// Islands
+	{
+		m_islandParent.resize( bodyCount );
+		for ( size_t i = 0; i < bodyCount; i++ )
+		{
+			m_islandParent[i] = i;
+		}
+		for ( const auto& contact : m_contacts )
+		{
+			const auto islandA = FindIsland( contact.first );
+			const auto islandB = FindIsland( contact.second );
+			if ( islandA != islandB )
+			{
+				m_islandParent[islandA] = islandB;
+			}
+		}
+	}
+
+	// Every island sleeps as long as its most recently active body
+	m_islandSleepTimer.assign( bodyCount, secondCountBeforeSleep );
+	for ( size_t i = 0; i < bodyCount; i++ )
+	{
+		const auto island = FindIsland( i );
+		if ( m_sleepTimer[i] < m_islandSleepTimer[island] )
+		{
+			m_islandSleepTimer[island] = m_sleepTimer[i];
+		}
+	}
+	for ( size_t i = 0; i < bodyCount; i++ )
+	{
+		const auto shouldBeAwake = m_islandSleepTimer[FindIsland( i )] < secondCountBeforeSleep;
+		if ( shouldBeAwake && !m_isAwake[i] )
+		{
+			// Touched by an awake body
+			WakeBody( i );
+		}
+		else if ( !shouldBeAwake && m_isAwake[i] )
+		{
+			PutBodyToSleep( i );
+		}
+	}
+}
+
+void eae6320::Physics::cRigidBodyWorld::PutBodyToSleep( const size_t i_body )
+{
+	// Whatever motion is left is below the thresholds, dropping it keeps the body from drifting after it wakes up
+	m_isAwake[i_body] = 0;
+	m_awakeBodyCount--;
+	m_velocity.Set( i_body, Math::sVector() );
+	m_acceleration.Set( i_body, Math::sVector() );
+	m_angularSpeed[i_body] = 0.0f;
+}
+
+size_t eae6320::Physics::cRigidBodyWorld::FindIsland( size_t i_body )
+{
+	// Path halving keeps the trees flat without recursion
+	while ( m_islandParent[i_body] != i_body )
+	{
+		m_islandParent[i_body] = m_islandParent[m_islandParent[i_body]];
+		i_body = m_islandParent[i_body];
+	}
+	return i_body;
+}
+
+void eae6320::Physics::cRigidBodyWorld::UpdateRange( const size_t i_begin, const size_t i_end, const float i_secondCountToIntegrate )
+{
+	const auto dt = i_secondCountToIntegrate;
+	// Linear motion is split into plain loops over each array so that the compiler can vectorize them.
+	// Sleeping bodies have no motion left, so they go through the same loops without changing instead of branching
+	{
+		float* const positionX = m_position.x.data();
+		float* const positionY = m_position.y.data();
+		float* const positionZ = m_position.z.data();
+		float* const velocityX = m_velocity.x.data();
+		float* const velocityY = m_velocity.y.data();
+		float* const velocityZ = m_velocity.z.data();
+		const float* const accelerationX = m_acceleration.x.data();
+		const float* const accelerationY = m_acceleration.y.data();
+		const float* const accelerationZ = m_acceleration.z.data();
+		// Update position
+		for ( auto i = i_begin; i < i_end; i++ )
+		{
+			positionX[i] += velocityX[i] * dt;
+			positionY[i] += velocityY[i] * dt;
+			positionZ[i] += velocityZ[i] * dt;
+		}
+		// Update velocity
+		for ( auto i = i_begin; i < i_end; i++ )
+		{
+			velocityX[i] += accelerationX[i] * dt;
+			velocityY[i] += accelerationY[i] * dt;
+			velocityZ[i] += accelerationZ[i] * dt;
+		}
+		// Update sleep timers
+		// (a sleeping body has no motion so its timer stays past the limit, and it never holds its island awake by itself)
+		const float* const angularSpeed = m_angularSpeed.data();
+		float* const sleepTimer = m_sleepTimer.data();
+		const auto linearThreshold_sqr = m_sleepSettings.linearSpeedThreshold * m_sleepSettings.linearSpeedThreshold;
+		const auto angularThreshold_sqr = m_sleepSettings.angularSpeedThreshold * m_sleepSettings.angularSpeedThreshold;
+		for ( auto i = i_begin; i < i_end; i++ )
+		{
+			const auto speed_sqr = ( velocityX[i] * velocityX[i] ) + ( velocityY[i] * velocityY[i] ) + ( velocityZ[i] * velocityZ[i] );
+			const auto acceleration_sqr = ( accelerationX[i] * accelerationX[i] ) + ( accelerationY[i] * accelerationY[i] ) + ( accelerationZ[i] * accelerationZ[i] );
+			const auto isSlow = ( speed_sqr < linearThreshold_sqr ) & ( acceleration_sqr < linearThreshold_sqr ) & ( ( angularSpeed[i] * angularSpeed[i] ) < angularThreshold_sqr );
+			sleepTimer[i] = ( sleepTimer[i] + dt ) * static_cast<float>( isSlow );
+		}
+	}
+	// Update orientation
+	{
+		const Math::cQuaternion::sArrays orientations = { m_orientationW.data(), m_orientationX.data(), m_orientationY.data(), m_orientationZ.data() };
+		RotateSpinningOrientations( i_begin, i_end, dt, orientations );
+	}
+}
+
+void eae6320::Physics::cRigidBodyWorld::RotateSpinningOrientations( const size_t i_begin, const size_t i_end, const float i_secondCount,
+	const Math::cQuaternion::sArrays& io_orientations ) const
+{
+	// Most bodies don't spin, and for those the rotation is the identity and the orientation is already normalized.
+	// The spinning ones are gathered into chunks so that the batch quaternion functions can rotate them four at a time
+	constexpr size_t chunkSize = 256;
+	size_t bodies[chunkSize];
+	float orientationW[chunkSize], orientationX[chunkSize], orientationY[chunkSize], orientationZ[chunkSize];
+	float rotationW[chunkSize], rotationX[chunkSize], rotationY[chunkSize], rotationZ[chunkSize];
+	const Math::cQuaternion::sArrays chunk = { orientationW, orientationX, orientationY, orientationZ };
+	const float* const axisX = m_angularVelocityAxis_local.x.data();
+	const float* const axisY = m_angularVelocityAxis_local.y.data();
+	const float* const axisZ = m_angularVelocityAxis_local.z.data();
+	const float* const angularSpeed = m_angularSpeed.data();
+	for ( auto i = i_begin; i < i_end; )
+	{
+		size_t count = 0;
+		for ( ; ( i < i_end ) && ( count < chunkSize ); i++ )
+		{
+			if ( angularSpeed[i] == 0.0f )
+			{
+				continue;
+			}
+			// cQuaternion( angularSpeed * dt, axis ), written out per component
+			const auto theta_half = angularSpeed[i] * i_secondCount * 0.5f;
+			const auto sin_theta_half = Math::Sin( theta_half );
+			rotationW[count] = Math::Cos( theta_half );
+			rotationX[count] = axisX[i] * sin_theta_half;
+			rotationY[count] = axisY[i] * sin_theta_half;
+			rotationZ[count] = axisZ[i] * sin_theta_half;
+			orientationW[count] = io_orientations.w[i];
+			orientationX[count] = io_orientations.x[i];
+			orientationY[count] = io_orientations.y[i];
+			orientationZ[count] = io_orientations.z[i];
+			bodies[count] = i;
+			count++;
+		}
+		if ( count == 0 )
+		{
+			// The rest of the range isn't spinning
+			break;
+		}
+		const Math::cQuaternion::sArrays_const rotations( rotationW, rotationX, rotationY, rotationZ );
+		Math::cQuaternion::Multiply( chunk, rotations, count, chunk );
+		Math::cQuaternion::Normalize( chunk, count );
+		for ( size_t j = 0; j < count; j++ )
+		{
+			const auto body = bodies[j];
+			io_orientations.w[body] = orientationW[j];
+			io_orientations.x[body] = orientationX[j];
+			io_orientations.y[body] = orientationY[j];
+			io_orientations.z[body] = orientationZ[j];
+		}
+	}
+}
+
+void eae6320::Physics::cRigidBodyWorld::sVectorArray::Add( const Math::sVector& i_vector )
+{
+	x.push_back( i_vector.x );
+	y.push_back( i_vector.y );
+	z.push_back( i_vector.z );
+}
+
+eae6320::Math::sVector eae6320::Physics::cRigidBodyWorld::sVectorArray::Get( const size_t i_index ) const
+{
+	return Math::sVector( x[i_index], y[i_index], z[i_index] );
+}
+
+void eae6320::Physics::cRigidBodyWorld::sVectorArray::Set( const size_t i_index, const Math::sVector& i_vector )
+{
+	x[i_index] = i_vector.x;
+	y[i_index] = i_vector.y;
+	z[i_index] = i_vector.z;
+}
+
+void eae6320::Physics::cRigidBodyWorld::sVectorArray::Clear()
+{
+	x.clear();
+	y.clear();
+	z.clear();
+}
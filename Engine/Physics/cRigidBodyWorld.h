@@ -0,0 +1,173 @@
+/*
+	A rigid body world stores the state of many bodies in SoA arrays
+	so that they can all be integrated in one pass
+	(optionally split across worker threads)
+	instead of one sRigidBodyState::Update() call per object
+*/
+
+#ifndef EAE6320_PHYSICS_CRIGIDBODYWORLD_H
+#define EAE6320_PHYSICS_CRIGIDBODYWORLD_H
+
+// Includes
+//=========
+
+#include "sRigidBodyState.h"
+
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/Math/sVector.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cMatrix_transformation;
+	}
+	namespace Physics
+	{
+		class cStateHash;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Physics
+	{
+		// Bodies that stay slow for long enough fall asleep and are skipped by Update().
+		// Bodies touching each other form an island, and an island only sleeps when every body in it is ready to,
+		// so a resting stack stays asleep until something wakes one of its bodies
+		struct sSleepSettings
+		{
+			float linearSpeedThreshold = 0.05f;	// Distance per-second, also applied to the acceleration
+			float angularSpeedThreshold = 0.05f;	// Radians per-second
+			float secondCountBeforeSleep = 0.5f;
+			bool isEnabled = true;
+		};
+
+		class cRigidBodyWorld
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Bodies
+			//-------
+
+			// Bodies are identified by the index that is returned
+			size_t AddBody( const sRigidBodyState& i_state );
+			void Clear();
+			size_t GetBodyCount() const { return m_angularSpeed.size(); }
+
+			sRigidBodyState GetBodyState( const size_t i_body ) const;
+			void SetBodyState( const size_t i_body, const sRigidBodyState& i_state );
+			Math::sVector GetPosition( const size_t i_body ) const;
+			Math::sVector GetVelocity( const size_t i_body ) const;
+			Math::cQuaternion GetOrientation( const size_t i_body ) const;
+			// Every function that changes a body's motion also wakes it up
+			void SetVelocity( const size_t i_body, const Math::sVector& i_velocity );
+			void SetAcceleration( const size_t i_body, const Math::sVector& i_acceleration );
+			// Bodies don't have a mass, so an impulse is a change in velocity
+			void ApplyImpulse( const size_t i_body, const Math::sVector& i_impulse );
+			Math::cMatrix_transformation PredictFutureTransform( const size_t i_body, const float i_secondCountToExtrapolate ) const;
+			// Every body's predicted transform at once, o_transforms must have room for GetBodyCount() of them
+			void PredictFutureTransforms( const float i_secondCountToExtrapolate, Math::cMatrix_transformation* const o_transforms ) const;
+
+			// Simulation
+			//-----------
+
+			// Integrates every body the same way sRigidBodyState::Update() does
+			// (bodies that aren't spinning skip the orientation update instead of renormalizing an unchanged quaternion,
+			// and the others are renormalized with cQuaternion::Normalize( sArrays ), which can differ from Normalize() in the last bits)
+			void Update( const float i_secondCountToIntegrate );
+
+			// Sleeping
+			//---------
+
+			void SetSleepSettings( const sSleepSettings& i_settings );
+			const sSleepSettings& GetSleepSettings() const { return m_sleepSettings; }
+			// Pairs of bodies whose colliders touched (e.g. from PlutoShe::Physics::CollisionWorld::GetCollidingPairs()),
+			// they are used by the next Update() to build the islands and then forgotten
+			void AddContact( const size_t i_bodyA, const size_t i_bodyB );
+			void WakeBody( const size_t i_body );
+			bool IsBodyAwake( const size_t i_body ) const { return m_isAwake[i_body] != 0; }
+			size_t GetAwakeBodyCount() const { return m_awakeBodyCount; }
+			size_t GetSleepingBodyCount() const { return GetBodyCount() - m_awakeBodyCount; }
+
+			// 1 (the default) keeps everything on the calling thread,
+			// otherwise the bodies are split into that many ranges and all but one are handed to new threads
+			void SetWorkerThreadCount( const unsigned int i_threadCount );
+			unsigned int GetWorkerThreadCount() const { return m_workerThreadCount; }
+
+			// Determinism
+			//------------
+
+			// Adds every body's state (including whether it is asleep) to the hash,
+			// two worlds that hash the same after the same ticks are simulating identically
+			void AddToHash( cStateHash& io_hash ) const;
+
+			// Data
+			//=====
+
+		public:
+
+			static constexpr unsigned int s_maxWorkerThreadCount = 16;
+			// Below this many bodies per thread starting the threads costs more than it saves
+			static constexpr size_t s_minBodyCountPerThread = 4096;
+
+		private:
+
+			struct sVectorArray
+			{
+				std::vector<float> x, y, z;
+
+				void Add( const Math::sVector& i_vector );
+				Math::sVector Get( const size_t i_index ) const;
+				void Set( const size_t i_index, const Math::sVector& i_vector );
+				void Clear();
+			};
+
+			sVectorArray m_position;
+			sVectorArray m_velocity;
+			sVectorArray m_acceleration;
+			std::vector<float> m_orientationW, m_orientationX, m_orientationY, m_orientationZ;
+			sVectorArray m_angularVelocityAxis_local;
+			std::vector<float> m_angularSpeed;
+			unsigned int m_workerThreadCount = 1;
+
+			sSleepSettings m_sleepSettings;
+			std::vector<uint8_t> m_isAwake;
+			// How long each body has been below the sleep thresholds
+			std::vector<float> m_sleepTimer;
+			std::vector<std::pair<size_t, size_t>> m_contacts;
+			// Union-find parents, only valid while the islands are built
+			std::vector<size_t> m_islandParent;
+			std::vector<float> m_islandSleepTimer;
+			size_t m_awakeBodyCount = 0;
+
+			// Implementation
+			//===============
+
+		private:
+
+			void Integrate( const float i_secondCountToIntegrate );
+			void UpdateSleeping();
+			void PutBodyToSleep( const size_t i_body );
+			size_t FindIsland( size_t i_body );
+			void UpdateRange( const size_t i_begin, const size_t i_end, const float i_secondCountToIntegrate );
+			void RotateSpinningOrientations( const size_t i_begin, const size_t i_end, const float i_secondCount,
+				const Math::cQuaternion::sArrays& io_orientations ) const;
+		};
+	}
+}
+
+#endif	// EAE6320_PHYSICS_CRIGIDBODYWORLD_H
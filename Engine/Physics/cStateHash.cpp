@@ -0,0 +1,62 @@
+// Includes
+//=========
+
+#include "cStateHash.h"
+
+#include "sRigidBodyState.h"
+
+#include <cstring>
+
+// Interface
+//==========
+
+void eae6320::Physics::cStateHash::Add( const void* const i_data, const size_t i_byteCount )
+{
+	constexpr uint64_t prime = 1099511628211u;
+	const auto* const bytes = static_cast<const uint8_t*>( i_data );
+	for ( size_t i = 0; i < i_byteCount; i++ )
+	{
+		m_value = ( m_value ^ bytes[i] ) * prime;
+	}
+}
+
+void eae6320::Physics::cStateHash::Add( const float i_value )
+{
+	uint32_t bits;
+	static_assert( sizeof( bits ) == sizeof( i_value ), "A float must be 32 bits" );
+	memcpy( &bits, &i_value, sizeof( bits ) );
+	Add( bits );
+}
+
+void eae6320::Physics::cStateHash::Add( const uint32_t i_value )
+{
+	// The bytes are added from least to most significant so that the hash doesn't depend on the platform's byte order
+	const uint8_t bytes[] = { static_cast<uint8_t>( i_value ), static_cast<uint8_t>( i_value >> 8 ),
+		static_cast<uint8_t>( i_value >> 16 ), static_cast<uint8_t>( i_value >> 24 ) };
+	Add( bytes, sizeof( bytes ) );
+}
+
+void eae6320::Physics::cStateHash::Add( const Math::sVector& i_vector )
+{
+	Add( i_vector.x );
+	Add( i_vector.y );
+	Add( i_vector.z );
+}
+
+void eae6320::Physics::cStateHash::Add( const Math::cQuaternion& i_quaternion )
+{
+	Add( i_quaternion.GetW() );
+	Add( i_quaternion.GetX() );
+	Add( i_quaternion.GetY() );
+	Add( i_quaternion.GetZ() );
+}
+
+void eae6320::Physics::cStateHash::Add( const sRigidBodyState& i_state )
+{
+	Add( i_state.position );
+	Add( i_state.velocity );
+	Add( i_state.acceleration );
+	Add( i_state.orientation );
+	Add( i_state.angularVelocity_axis_local );
+	Add( i_state.angularSpeed );
+}
@@ -0,0 +1,67 @@
+/*
+	A state hash condenses the exact bits of a simulation's state into 64 bits
+	so that two simulations (e.g. on different machines, or a replay and the game it recorded)
+	can be compared cheaply every tick
+*/
+
+#ifndef EAE6320_PHYSICS_CSTATEHASH_H
+#define EAE6320_PHYSICS_CSTATEHASH_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Math
+	{
+		class cQuaternion;
+		struct sVector;
+	}
+	namespace Physics
+	{
+		struct sRigidBodyState;
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Physics
+	{
+		class cStateHash
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Floats are hashed by their bits, so values that compare equal can still hash differently (e.g. 0 and -0)
+			void Add( const void* const i_data, const size_t i_byteCount );
+			void Add( const float i_value );
+			void Add( const uint32_t i_value );
+			void Add( const Math::sVector& i_vector );
+			void Add( const Math::cQuaternion& i_quaternion );
+			void Add( const sRigidBodyState& i_state );
+
+			uint64_t GetValue() const { return m_value; }
+
+			// Data
+			//=====
+
+		private:
+
+			// FNV-1a
+			uint64_t m_value = 14695981039346656037u;
+		};
+	}
+}
+
+#endif	// EAE6320_PHYSICS_CSTATEHASH_H
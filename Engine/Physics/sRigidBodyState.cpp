@@ -3,6 +3,7 @@
 
 #include "sRigidBodyState.h"
 
+#include <Engine/Math/Configuration.h>
 #include <Engine/Math/cMatrix_transformation.h>
 
 // Interface
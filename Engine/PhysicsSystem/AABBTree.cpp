@@ -0,0 +1,616 @@
+#include "AABBTree.h"
+#include "Configuration.h"
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Math/cQuaternion.h>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+	// Slab test, returns the entry distance or a negative value when the ray misses
+	float RayEntryDistance(const PlutoShe::Physics::AABB& i_bounds, const PlutoShe::Physics::Vector3& i_origin,
+		const PlutoShe::Physics::Vector3& i_inverseDirection, float i_maxDistance, float* o_exitDistance = nullptr)
+	{
+		float tMin = 0.0f;
+		float tMax = i_maxDistance;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float origin = i_origin.Get(axis);
+			const float inverse = i_inverseDirection.Get(axis);
+			float t1 = (i_bounds.m_min.Get(axis) - origin) * inverse;
+			float t2 = (i_bounds.m_max.Get(axis) - origin) * inverse;
+			if (t1 > t2) { const float temp = t1; t1 = t2; t2 = temp; }
+			if (t1 > tMin) tMin = t1;
+			if (t2 < tMax) tMax = t2;
+			if (tMin > tMax) return -1.0f;
+		}
+		if (o_exitDistance) *o_exitDistance = tMax;
+		return tMin;
+	}
+
+	bool NormalizeRay(const PlutoShe::Physics::Vector3& i_direction, PlutoShe::Physics::Vector3& o_direction, PlutoShe::Physics::Vector3& o_inverseDirection)
+	{
+		o_direction = i_direction;
+		const float length = eae6320::Math::Sqrt(o_direction.dot(o_direction));
+		if (length <= 0.0f)
+		{
+			return false;
+		}
+		o_direction = o_direction / length;
+		o_inverseDirection = PlutoShe::Physics::Vector3(
+			o_direction.m_x != 0.0f ? 1.0f / o_direction.m_x : 1e30f,
+			o_direction.m_y != 0.0f ? 1.0f / o_direction.m_y : 1e30f,
+			o_direction.m_z != 0.0f ? 1.0f / o_direction.m_z : 1e30f);
+		return true;
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		PlutoShe::Physics::DynamicAABBTree::DynamicAABBTree(float i_fatMargin)
+			: m_root(s_nullNode), m_freeList(s_nullNode), m_fatMargin(i_fatMargin) { }
+
+		void PlutoShe::Physics::DynamicAABBTree::Insert(Collider* i_collider)
+		{
+			if (Contains(i_collider))
+			{
+				return;
+			}
+			const int leaf = AllocateNode();
+			m_nodes[leaf].m_bounds = i_collider->GetAABB().Fattened(m_fatMargin);
+			m_nodes[leaf].m_collider = i_collider;
+			m_nodes[leaf].m_height = 0;
+			m_leaves[i_collider] = leaf;
+			InsertLeaf(leaf);
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::Remove(Collider* i_collider)
+		{
+			auto it = m_leaves.find(i_collider);
+			if (it == m_leaves.end())
+			{
+				return;
+			}
+			RemoveLeaf(it->second);
+			FreeNode(it->second);
+			m_leaves.erase(it);
+		}
+
+		bool PlutoShe::Physics::DynamicAABBTree::Move(Collider* i_collider)
+		{
+			auto it = m_leaves.find(i_collider);
+			if (it == m_leaves.end())
+			{
+				return false;
+			}
+			const int leaf = it->second;
+			const AABB tight = i_collider->GetAABB();
+			if (m_nodes[leaf].m_bounds.Contains(tight))
+			{
+				return false;
+			}
+			RemoveLeaf(leaf);
+			m_nodes[leaf].m_bounds = tight.Fattened(m_fatMargin);
+			InsertLeaf(leaf);
+			return true;
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::Clear()
+		{
+			m_nodes.clear();
+			m_leaves.clear();
+			m_root = s_nullNode;
+			m_freeList = s_nullNode;
+		}
+
+		int PlutoShe::Physics::DynamicAABBTree::AllocateNode()
+		{
+			if (m_freeList == s_nullNode)
+			{
+				Node node;
+				node.m_parent = node.m_child1 = node.m_child2 = s_nullNode;
+				node.m_height = -1;
+				node.m_collider = nullptr;
+				m_nodes.push_back(node);
+				m_freeList = static_cast<int>(m_nodes.size()) - 1;
+				m_nodes[m_freeList].m_parent = s_nullNode;
+			}
+			const int node = m_freeList;
+			m_freeList = m_nodes[node].m_parent;
+			m_nodes[node].m_parent = s_nullNode;
+			m_nodes[node].m_child1 = s_nullNode;
+			m_nodes[node].m_child2 = s_nullNode;
+			m_nodes[node].m_height = 0;
+			m_nodes[node].m_collider = nullptr;
+			return node;
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::FreeNode(int i_node)
+		{
+			m_nodes[i_node].m_parent = m_freeList;
+			m_nodes[i_node].m_height = -1;
+			m_nodes[i_node].m_collider = nullptr;
+			m_freeList = i_node;
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::InsertLeaf(int i_leaf)
+		{
+			if (m_root == s_nullNode)
+			{
+				m_root = i_leaf;
+				m_nodes[m_root].m_parent = s_nullNode;
+				return;
+			}
+
+			// Walk down choosing the child that grows the least (surface area heuristic)
+			const AABB leafBounds = m_nodes[i_leaf].m_bounds;
+			int index = m_root;
+			while (!m_nodes[index].IsLeaf())
+			{
+				const int child1 = m_nodes[index].m_child1;
+				const int child2 = m_nodes[index].m_child2;
+				const float area = m_nodes[index].m_bounds.GetPerimeter();
+				const float combinedArea = AABB::Merge(m_nodes[index].m_bounds, leafBounds).GetPerimeter();
+
+				// Cost of creating a new parent for this node and the new leaf
+				const float cost = 2.0f * combinedArea;
+				// Minimum cost of pushing the leaf further down the tree
+				const float inheritanceCost = 2.0f * (combinedArea - area);
+
+				float cost1 = AABB::Merge(leafBounds, m_nodes[child1].m_bounds).GetPerimeter() + inheritanceCost;
+				if (!m_nodes[child1].IsLeaf())
+				{
+					cost1 -= m_nodes[child1].m_bounds.GetPerimeter();
+				}
+				float cost2 = AABB::Merge(leafBounds, m_nodes[child2].m_bounds).GetPerimeter() + inheritanceCost;
+				if (!m_nodes[child2].IsLeaf())
+				{
+					cost2 -= m_nodes[child2].m_bounds.GetPerimeter();
+				}
+
+				if (cost < cost1 && cost < cost2)
+				{
+					break;
+				}
+				index = cost1 < cost2 ? child1 : child2;
+			}
+
+			const int sibling = index;
+			const int oldParent = m_nodes[sibling].m_parent;
+			const int newParent = AllocateNode();
+			m_nodes[newParent].m_parent = oldParent;
+			m_nodes[newParent].m_bounds = AABB::Merge(leafBounds, m_nodes[sibling].m_bounds);
+			m_nodes[newParent].m_height = m_nodes[sibling].m_height + 1;
+			m_nodes[newParent].m_child1 = sibling;
+			m_nodes[newParent].m_child2 = i_leaf;
+			m_nodes[sibling].m_parent = newParent;
+			m_nodes[i_leaf].m_parent = newParent;
+
+			if (oldParent != s_nullNode)
+			{
+				if (m_nodes[oldParent].m_child1 == sibling)
+				{
+					m_nodes[oldParent].m_child1 = newParent;
+				}
+				else
+				{
+					m_nodes[oldParent].m_child2 = newParent;
+				}
+			}
+			else
+			{
+				m_root = newParent;
+			}
+
+			RefitAncestors(m_nodes[i_leaf].m_parent);
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::RemoveLeaf(int i_leaf)
+		{
+			if (i_leaf == m_root)
+			{
+				m_root = s_nullNode;
+				return;
+			}
+
+			const int parent = m_nodes[i_leaf].m_parent;
+			const int grandParent = m_nodes[parent].m_parent;
+			const int sibling = m_nodes[parent].m_child1 == i_leaf ? m_nodes[parent].m_child2 : m_nodes[parent].m_child1;
+
+			if (grandParent != s_nullNode)
+			{
+				// Replace the parent with the sibling
+				if (m_nodes[grandParent].m_child1 == parent)
+				{
+					m_nodes[grandParent].m_child1 = sibling;
+				}
+				else
+				{
+					m_nodes[grandParent].m_child2 = sibling;
+				}
+				m_nodes[sibling].m_parent = grandParent;
+				FreeNode(parent);
+				RefitAncestors(grandParent);
+			}
+			else
+			{
+				m_root = sibling;
+				m_nodes[sibling].m_parent = s_nullNode;
+				FreeNode(parent);
+			}
+			m_nodes[i_leaf].m_parent = s_nullNode;
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::RefitAncestors(int i_node)
+		{
+			int index = i_node;
+			while (index != s_nullNode)
+			{
+				index = Balance(index);
+
+				const int child1 = m_nodes[index].m_child1;
+				const int child2 = m_nodes[index].m_child2;
+				const int height1 = m_nodes[child1].m_height;
+				const int height2 = m_nodes[child2].m_height;
+				m_nodes[index].m_height = 1 + (height1 > height2 ? height1 : height2);
+				m_nodes[index].m_bounds = AABB::Merge(m_nodes[child1].m_bounds, m_nodes[child2].m_bounds);
+
+				index = m_nodes[index].m_parent;
+			}
+		}
+
+		// If the node is imbalanced, rotate the taller child up and return the node that took its place
+		int PlutoShe::Physics::DynamicAABBTree::Balance(int i_a)
+		{
+			Node& a = m_nodes[i_a];
+			if (a.IsLeaf() || a.m_height < 2)
+			{
+				return i_a;
+			}
+
+			const int iB = a.m_child1;
+			const int iC = a.m_child2;
+			Node& b = m_nodes[iB];
+			Node& c = m_nodes[iC];
+			const int balance = c.m_height - b.m_height;
+
+			// The child that is two levels taller gets rotated up
+			if (balance > 1 || balance < -1)
+			{
+				const int iUp = balance > 1 ? iC : iB;
+				const int iOther = balance > 1 ? iB : iC;
+				Node& up = m_nodes[iUp];
+				const int iF = up.m_child1;
+				const int iG = up.m_child2;
+				Node& f = m_nodes[iF];
+				Node& g = m_nodes[iG];
+
+				// Swap A and the rotated child
+				up.m_child1 = i_a;
+				up.m_parent = a.m_parent;
+				a.m_parent = iUp;
+
+				if (up.m_parent != s_nullNode)
+				{
+					if (m_nodes[up.m_parent].m_child1 == i_a)
+					{
+						m_nodes[up.m_parent].m_child1 = iUp;
+					}
+					else
+					{
+						m_nodes[up.m_parent].m_child2 = iUp;
+					}
+				}
+				else
+				{
+					m_root = iUp;
+				}
+
+				// The taller grandchild stays with the rotated node, the shorter one moves down to A
+				const int iKeep = f.m_height > g.m_height ? iF : iG;
+				const int iMove = f.m_height > g.m_height ? iG : iF;
+				up.m_child2 = iKeep;
+				if (balance > 1)
+				{
+					a.m_child2 = iMove;
+				}
+				else
+				{
+					a.m_child1 = iMove;
+				}
+				m_nodes[iMove].m_parent = i_a;
+
+				const Node& other = m_nodes[iOther];
+				const Node& moved = m_nodes[iMove];
+				a.m_bounds = AABB::Merge(other.m_bounds, moved.m_bounds);
+				a.m_height = 1 + (other.m_height > moved.m_height ? other.m_height : moved.m_height);
+				const Node& kept = m_nodes[iKeep];
+				up.m_bounds = AABB::Merge(a.m_bounds, kept.m_bounds);
+				up.m_height = 1 + (a.m_height > kept.m_height ? a.m_height : kept.m_height);
+				return iUp;
+			}
+			return i_a;
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::QueryPairs(std::vector<ColliderPair>& o_pairs) const
+		{
+			int stack[s_stackCapacity];
+			for (auto it = m_leaves.begin(); it != m_leaves.end(); ++it)
+			{
+				const int leaf = it->second;
+				const AABB& bounds = m_nodes[leaf].m_bounds;
+				int count = 0;
+				if (m_root != s_nullNode) stack[count++] = m_root;
+				while (count > 0)
+				{
+					const int index = stack[--count];
+					const Node& node = m_nodes[index];
+					if (!node.m_bounds.Overlaps(bounds))
+					{
+						continue;
+					}
+					if (node.IsLeaf())
+					{
+						// Each pair is reported once, from the leaf with the smaller index
+						if (index > leaf)
+						{
+							o_pairs.push_back(ColliderPair::Ordered(m_nodes[leaf].m_collider, node.m_collider));
+						}
+					}
+					else
+					{
+						EAE6320_ASSERT(count + 2 <= s_stackCapacity);
+						stack[count++] = node.m_child1;
+						stack[count++] = node.m_child2;
+					}
+				}
+			}
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::QueryAABB(const AABB& i_bounds, std::vector<Collider*>& o_colliders) const
+		{
+			// A box primitive has no vertices, so building one per query doesn't touch the heap
+			Vector3 center = (Vector3(i_bounds.m_min) + i_bounds.m_max) * 0.5f;
+			Collider box = Collider::createQueryBox((Vector3(i_bounds.m_max) - i_bounds.m_min) * 0.5f);
+			box.UpdateTransformation(eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(), eae6320::Math::sVector(center.m_x, center.m_y, center.m_z)));
+
+			int stack[s_stackCapacity];
+			int count = 0;
+			if (m_root != s_nullNode) stack[count++] = m_root;
+			while (count > 0)
+			{
+				const Node& node = m_nodes[stack[--count]];
+				if (!node.m_bounds.Overlaps(i_bounds))
+				{
+					continue;
+				}
+				if (node.IsLeaf())
+				{
+					if (node.m_collider->GetAABB().Overlaps(i_bounds) && box.IsCollided(*node.m_collider))
+					{
+						o_colliders.push_back(node.m_collider);
+					}
+				}
+				else
+				{
+					EAE6320_ASSERT(count + 2 <= s_stackCapacity);
+					stack[count++] = node.m_child1;
+					stack[count++] = node.m_child2;
+				}
+			}
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::QuerySphere(const Vector3& i_center, float i_radius, std::vector<Collider*>& o_colliders) const
+		{
+			AABB sphereBounds;
+			sphereBounds.m_min = Vector3(i_center.m_x - i_radius, i_center.m_y - i_radius, i_center.m_z - i_radius);
+			sphereBounds.m_max = Vector3(i_center.m_x + i_radius, i_center.m_y + i_radius, i_center.m_z + i_radius);
+			// A sphere with no radius is a point that doesn't need any vertices
+			Collider center = Collider::createQuerySphere(0.0f);
+			center.UpdateTransformation(eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(), eae6320::Math::sVector(i_center.m_x, i_center.m_y, i_center.m_z)));
+
+			int stack[s_stackCapacity];
+			int count = 0;
+			if (m_root != s_nullNode) stack[count++] = m_root;
+			while (count > 0)
+			{
+				const Node& node = m_nodes[stack[--count]];
+				if (!node.m_bounds.Overlaps(sphereBounds))
+				{
+					continue;
+				}
+				if (node.IsLeaf())
+				{
+					// The GJK distance from the center gives up as soon as the collider is known to be out of reach
+					sDistanceResult distance;
+					if (node.m_collider->GetAABB().Overlaps(sphereBounds) && center.Distance(*node.m_collider, distance, i_radius))
+					{
+						o_colliders.push_back(node.m_collider);
+					}
+				}
+				else
+				{
+					EAE6320_ASSERT(count + 2 <= s_stackCapacity);
+					stack[count++] = node.m_child1;
+					stack[count++] = node.m_child2;
+				}
+			}
+		}
+
+		bool PlutoShe::Physics::DynamicAABBTree::IsChild2Nearer(const Node& i_node, const Vector3& i_direction) const
+		{
+			// Compares the centers of the children along the direction, both are doubled so they don't need the halving
+			const AABB& bounds1 = m_nodes[i_node.m_child1].m_bounds;
+			const AABB& bounds2 = m_nodes[i_node.m_child2].m_bounds;
+			float projection = 0.0f;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				projection += (bounds2.m_min.Get(axis) + bounds2.m_max.Get(axis) - bounds1.m_min.Get(axis) - bounds1.m_max.Get(axis)) * i_direction.Get(axis);
+			}
+			return projection < 0.0f;
+		}
+
+		bool PlutoShe::Physics::DynamicAABBTree::CastAgainstCollider(Collider& i_collider, Collider& io_point, const Vector3& i_origin, const Vector3& i_direction,
+			const Vector3& i_inverseDirection, float i_radius, float i_maxDistance, sRaycastHit& o_hit)
+		{
+			// Nothing can be hit after the ray leaves the bounds, so the sweep stops there (which also keeps it finite for unbounded rays)
+			float sweepDistance;
+			if (RayEntryDistance(i_collider.GetAABB().Fattened(i_radius + PLUTOSHE_PHYSICS_CCD_TOLERANCE), i_origin, i_inverseDirection, i_maxDistance, &sweepDistance) < 0.0f)
+			{
+				return false;
+			}
+			// The point ends at the far end of the sweep and is swept back from the origin
+			Vector3 direction = i_direction;
+			Vector3 translation = direction * sweepDistance;
+			Vector3 end = Vector3(i_origin) + translation;
+			io_point.UpdateTransformation(eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(), eae6320::Math::sVector(end.m_x, end.m_y, end.m_z)));
+			sTimeOfImpactResult timeOfImpact;
+			if (!io_point.TimeOfImpact(i_collider, translation, Vector3(), timeOfImpact, i_radius))
+			{
+				return false;
+			}
+			o_hit.m_collider = &i_collider;
+			o_hit.m_distance = timeOfImpact.m_time * sweepDistance;
+			o_hit.m_point = timeOfImpact.m_point + timeOfImpact.m_normal * i_radius;
+			return true;
+		}
+
+		bool PlutoShe::Physics::DynamicAABBTree::Cast(Collider& io_point, const Vector3& i_origin, const Vector3& i_direction, float i_radius, float i_maxDistance, sRaycastHit& o_hit) const
+		{
+			Vector3 direction, inverseDirection;
+			if (!NormalizeRay(i_direction, direction, inverseDirection) || m_root == s_nullNode)
+			{
+				return false;
+			}
+
+			float closest = i_maxDistance;
+			bool hasHit = false;
+			int stack[s_stackCapacity];
+			int count = 0;
+			stack[count++] = m_root;
+			while (count > 0)
+			{
+				const Node& node = m_nodes[stack[--count]];
+				// The center of a sphere can only come within the radius of a box inflated by it
+				if (RayEntryDistance(i_radius > 0.0f ? node.m_bounds.Fattened(i_radius) : node.m_bounds, i_origin, inverseDirection, closest) < 0.0f)
+				{
+					continue;
+				}
+				if (node.IsLeaf())
+				{
+					if (CastAgainstCollider(*node.m_collider, io_point, i_origin, direction, inverseDirection, i_radius, closest, o_hit))
+					{
+						closest = o_hit.m_distance;
+						hasHit = true;
+					}
+				}
+				else
+				{
+					// The nearer child is popped first so that its hits cull the farther one
+					EAE6320_ASSERT(count + 2 <= s_stackCapacity);
+					const bool isChild2Nearer = IsChild2Nearer(node, direction);
+					stack[count++] = isChild2Nearer ? node.m_child1 : node.m_child2;
+					stack[count++] = isChild2Nearer ? node.m_child2 : node.m_child1;
+				}
+			}
+			return hasHit;
+		}
+
+		bool PlutoShe::Physics::DynamicAABBTree::Raycast(const Vector3& i_origin, const Vector3& i_direction, float i_maxDistance, sRaycastHit& o_hit) const
+		{
+			Collider point = Collider::createQuerySphere(0.0f);
+			return Cast(point, i_origin, i_direction, 0.0f, i_maxDistance, o_hit);
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::RaycastAll(const Vector3& i_origin, const Vector3& i_direction, float i_maxDistance, std::vector<sRaycastHit>& o_hits) const
+		{
+			Vector3 direction, inverseDirection;
+			if (!NormalizeRay(i_direction, direction, inverseDirection) || m_root == s_nullNode)
+			{
+				return;
+			}
+			Collider point = Collider::createQuerySphere(0.0f);
+			const size_t firstHit = o_hits.size();
+
+			int stack[s_stackCapacity];
+			int count = 0;
+			stack[count++] = m_root;
+			while (count > 0)
+			{
+				const Node& node = m_nodes[stack[--count]];
+				if (RayEntryDistance(node.m_bounds, i_origin, inverseDirection, i_maxDistance) < 0.0f)
+				{
+					continue;
+				}
+				if (node.IsLeaf())
+				{
+					sRaycastHit hit;
+					if (CastAgainstCollider(*node.m_collider, point, i_origin, direction, inverseDirection, 0.0f, i_maxDistance, hit))
+					{
+						o_hits.push_back(hit);
+					}
+				}
+				else
+				{
+					EAE6320_ASSERT(count + 2 <= s_stackCapacity);
+					stack[count++] = node.m_child1;
+					stack[count++] = node.m_child2;
+				}
+			}
+			std::sort(o_hits.begin() + firstHit, o_hits.end(), [](const sRaycastHit& i_lhs, const sRaycastHit& i_rhs) { return i_lhs.m_distance < i_rhs.m_distance; });
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::RaycastBatch(const sRay* i_rays, size_t i_rayCount, sRaycastHit* o_hits) const
+		{
+			// Rays only share the point collider that is swept along them.
+			// Walking the tree once with packets of rays was tried, but the sweeps at the leaves cost more than the walk
+			// and each ray ordering the children by its own direction ends up sweeping fewer leaves
+			Collider point = Collider::createQuerySphere(0.0f);
+			for (size_t i = 0; i < i_rayCount; i++)
+			{
+				o_hits[i] = sRaycastHit();
+				Cast(point, i_rays[i].m_origin, i_rays[i].m_direction, 0.0f, i_rays[i].m_maxDistance, o_hits[i]);
+			}
+		}
+
+		bool PlutoShe::Physics::DynamicAABBTree::SphereCast(const Vector3& i_origin, float i_radius, const Vector3& i_direction, float i_maxDistance, sRaycastHit& o_hit) const
+		{
+			Collider point = Collider::createQuerySphere(0.0f);
+			return Cast(point, i_origin, i_direction, i_radius, i_maxDistance, o_hit);
+		}
+
+		void PlutoShe::Physics::DynamicAABBTree::QueryBox(const eae6320::Math::cMatrix_transformation& i_transform, const Vector3& i_halfExtents, std::vector<Collider*>& o_colliders) const
+		{
+			Collider box = Collider::createQueryBox(i_halfExtents);
+			box.UpdateTransformation(i_transform);
+			const AABB boxBounds = box.GetAABB();
+
+			int stack[s_stackCapacity];
+			int count = 0;
+			if (m_root != s_nullNode) stack[count++] = m_root;
+			while (count > 0)
+			{
+				const Node& node = m_nodes[stack[--count]];
+				if (!node.m_bounds.Overlaps(boxBounds))
+				{
+					continue;
+				}
+				if (node.IsLeaf())
+				{
+					if (node.m_collider->GetAABB().Overlaps(boxBounds) && box.Overlaps(*node.m_collider))
+					{
+						o_colliders.push_back(node.m_collider);
+					}
+				}
+				else
+				{
+					EAE6320_ASSERT(count + 2 <= s_stackCapacity);
+					stack[count++] = node.m_child1;
+					stack[count++] = node.m_child2;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "PhysicsSystem.h"
+#include "Broadphase.h"
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		struct sRaycastHit
+		{
+			// nullptr when a batched ray hit nothing
+			Collider* m_collider = nullptr;
+			// Distance along the normalized ray direction
+			float m_distance = 0;
+			Vector3 m_point;
+		};
+
+		struct sRay
+		{
+			Vector3 m_origin;
+			// Doesn't have to be normalized
+			Vector3 m_direction;
+			float m_maxDistance = FLT_MAX;
+		};
+
+		// Dynamic bounding volume hierarchy keyed by collider.
+		// Leaves store fat AABBs so small movements don't touch the tree,
+		// and AVL-style rotations keep it balanced while colliders are inserted, moved and removed.
+		class DynamicAABBTree
+		{
+		public:
+			DynamicAABBTree(float i_fatMargin = 0.1f);
+
+			void Insert(Collider* i_collider);
+			void Remove(Collider* i_collider);
+			// Returns true if the collider left its fat AABB and had to be re-inserted
+			bool Move(Collider* i_collider);
+			void Clear();
+			bool Contains(const Collider* i_collider) const { return m_leaves.find(const_cast<Collider*>(i_collider)) != m_leaves.end(); }
+
+			// Every pair of leaves whose fat AABBs overlap
+			void QueryPairs(std::vector<ColliderPair>& o_pairs) const;
+			// Colliders that actually overlap the box (GJK against the box after the tree walk)
+			void QueryAABB(const AABB& i_bounds, std::vector<Collider*>& o_colliders) const;
+			// Colliders that actually overlap the sphere (GJK distance from the center after the tree walk)
+			void QuerySphere(const Vector3& i_center, float i_radius, std::vector<Collider*>& o_colliders) const;
+			// Colliders that actually overlap the oriented box
+			void QueryBox(const eae6320::Math::cMatrix_transformation& i_transform, const Vector3& i_halfExtents, std::vector<Collider*>& o_colliders) const;
+			// Closest collider hit by the ray within i_maxDistance, i_direction doesn't have to be normalized.
+			// Hits are found by conservative advancement, so distances are within PLUTOSHE_PHYSICS_CCD_TOLERANCE
+			bool Raycast(const Vector3& i_origin, const Vector3& i_direction, float i_maxDistance, sRaycastHit& o_hit) const;
+			// Every collider hit by the ray, sorted by distance
+			void RaycastAll(const Vector3& i_origin, const Vector3& i_direction, float i_maxDistance, std::vector<sRaycastHit>& o_hits) const;
+			// Closest hit of every ray, a ray that hits nothing gets a hit without a collider
+			void RaycastBatch(const sRay* i_rays, size_t i_rayCount, sRaycastHit* o_hits) const;
+			// Closest collider touched by a sphere moving along the ray, m_point is where the sphere touches it
+			bool SphereCast(const Vector3& i_origin, float i_radius, const Vector3& i_direction, float i_maxDistance, sRaycastHit& o_hit) const;
+
+			size_t GetSize() const { return m_leaves.size(); }
+			int GetHeight() const { return m_root == s_nullNode ? 0 : m_nodes[m_root].m_height; }
+
+		private:
+			static constexpr int s_nullNode = -1;
+			static constexpr int s_stackCapacity = 256;
+
+			struct Node
+			{
+				AABB m_bounds;
+				Collider* m_collider;
+				// Doubles as the next free node while the node is in the free list
+				int m_parent;
+				int m_child1;
+				int m_child2;
+				// Leaf = 0, free node = -1
+				int m_height;
+
+				bool IsLeaf() const { return m_child1 == s_nullNode; }
+			};
+
+			// Closest hit of a ray, or of a sphere moving along it when i_radius > 0.
+			// io_point is a sphere primitive with no radius, it is moved to the end of every sweep
+			bool Cast(Collider& io_point, const Vector3& i_origin, const Vector3& i_direction, float i_radius, float i_maxDistance, sRaycastHit& o_hit) const;
+			// Whether child2 comes before child1 along the direction
+			bool IsChild2Nearer(const Node& i_node, const Vector3& i_direction) const;
+			// Ray (or sphere when i_radius > 0) against a single collider, o_hit is only written on a hit closer than i_maxDistance
+			static bool CastAgainstCollider(Collider& i_collider, Collider& io_point, const Vector3& i_origin, const Vector3& i_direction,
+				const Vector3& i_inverseDirection, float i_radius, float i_maxDistance, sRaycastHit& o_hit);
+
+			int AllocateNode();
+			void FreeNode(int i_node);
+			void InsertLeaf(int i_leaf);
+			void RemoveLeaf(int i_leaf);
+			int Balance(int i_node);
+			void RefitAncestors(int i_node);
+
+			std::vector<Node> m_nodes;
+			std::unordered_map<Collider*, int> m_leaves;
+			int m_root;
+			int m_freeList;
+			float m_fatMargin;
+		};
+	}
+}
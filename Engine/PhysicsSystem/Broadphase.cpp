@@ -0,0 +1,143 @@
+#include "Broadphase.h"
+#include <algorithm>
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		PlutoShe::Physics::SweepAndPrune::SweepAndPrune() : m_sweepAxis(0) { }
+
+		void PlutoShe::Physics::SweepAndPrune::AddCollider(Collider* i_collider)
+		{
+			Proxy proxy;
+			proxy.m_collider = i_collider;
+			proxy.m_bounds = i_collider->GetAABB();
+			m_proxies.push_back(proxy);
+			// Put the new proxy at its sorted position right away so the next update stays incremental
+			for (size_t i = m_proxies.size() - 1; i > 0 && GetMin(m_proxies[i - 1]) > GetMin(m_proxies[i]); i--)
+			{
+				std::swap(m_proxies[i - 1], m_proxies[i]);
+			}
+		}
+
+		void PlutoShe::Physics::SweepAndPrune::RemoveCollider(Collider* i_collider)
+		{
+			for (size_t i = 0; i < m_proxies.size(); i++)
+			{
+				if (m_proxies[i].m_collider == i_collider)
+				{
+					// erase() instead of swap-and-pop keeps the sorted order intact
+					m_proxies.erase(m_proxies.begin() + i);
+					return;
+				}
+			}
+		}
+
+		void PlutoShe::Physics::SweepAndPrune::Clear()
+		{
+			m_proxies.clear();
+			m_candidatePairs.clear();
+			m_stats = sBroadphaseStats();
+		}
+
+		void PlutoShe::Physics::SweepAndPrune::Update()
+		{
+			m_stats = sBroadphaseStats();
+			m_candidatePairs.clear();
+
+			for (size_t i = 0; i < m_proxies.size(); i++)
+			{
+				m_proxies[i].m_bounds = m_proxies[i].m_collider->GetAABB();
+			}
+			ChooseSweepAxis();
+			SortProxies();
+
+			// Sweep: every proxy only has to be tested against the proxies that start before it ends
+			const int axisY = (m_sweepAxis + 1) % 3;
+			const int axisZ = (m_sweepAxis + 2) % 3;
+			for (size_t i = 0; i < m_proxies.size(); i++)
+			{
+				const Proxy& a = m_proxies[i];
+				const float maxA = GetMax(a);
+				for (size_t j = i + 1; j < m_proxies.size(); j++)
+				{
+					const Proxy& b = m_proxies[j];
+					if (GetMin(b) > maxA)
+					{
+						break;
+					}
+					m_stats.m_boundsTestCount++;
+					if (a.m_bounds.m_min.Get(axisY) <= b.m_bounds.m_max.Get(axisY) && a.m_bounds.m_max.Get(axisY) >= b.m_bounds.m_min.Get(axisY)
+						&& a.m_bounds.m_min.Get(axisZ) <= b.m_bounds.m_max.Get(axisZ) && a.m_bounds.m_max.Get(axisZ) >= b.m_bounds.m_min.Get(axisZ))
+					{
+						// Pairs are always reported in the same order so per-pair data (contacts, caches) stays keyed consistently
+						m_candidatePairs.push_back(ColliderPair::Ordered(a.m_collider, b.m_collider));
+					}
+				}
+			}
+
+			const size_t n = m_proxies.size();
+			m_stats.m_proxyCount = n;
+			m_stats.m_bruteForcePairCount = n > 1 ? n * (n - 1) / 2 : 0;
+			m_stats.m_candidatePairCount = m_candidatePairs.size();
+		}
+
+		void PlutoShe::Physics::SweepAndPrune::ChooseSweepAxis()
+		{
+			// Sweep along the axis where the centers are spread out the most,
+			// for the top-down shooter that is usually x or z since everything stays near the ground
+			if (m_proxies.size() < 2)
+			{
+				return;
+			}
+			float sum[3] = { 0, 0, 0 };
+			float sumSqr[3] = { 0, 0, 0 };
+			for (size_t i = 0; i < m_proxies.size(); i++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					const float center = (m_proxies[i].m_bounds.m_min.Get(axis) + m_proxies[i].m_bounds.m_max.Get(axis)) * 0.5f;
+					sum[axis] += center;
+					sumSqr[axis] += center * center;
+				}
+			}
+			const float invCount = 1.0f / static_cast<float>(m_proxies.size());
+			int bestAxis = m_sweepAxis;
+			float bestVariance = sumSqr[m_sweepAxis] * invCount - (sum[m_sweepAxis] * invCount) * (sum[m_sweepAxis] * invCount);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const float variance = sumSqr[axis] * invCount - (sum[axis] * invCount) * (sum[axis] * invCount);
+				// Require a clear win before switching so the axis doesn't flip back and forth and lose the coherent order
+				if (variance > bestVariance * 1.5f)
+				{
+					bestVariance = variance;
+					bestAxis = axis;
+				}
+			}
+			if (bestAxis != m_sweepAxis)
+			{
+				m_sweepAxis = bestAxis;
+				// The old order means nothing on the new axis, so do a full sort once
+				std::sort(m_proxies.begin(), m_proxies.end(), [this](const Proxy& i_lhs, const Proxy& i_rhs) { return GetMin(i_lhs) < GetMin(i_rhs); });
+			}
+		}
+
+		void PlutoShe::Physics::SweepAndPrune::SortProxies()
+		{
+			// Insertion sort, cheap when the previous frame's order is almost right
+			for (size_t i = 1; i < m_proxies.size(); i++)
+			{
+				const Proxy key = m_proxies[i];
+				const float keyMin = GetMin(key);
+				size_t j = i;
+				while (j > 0 && GetMin(m_proxies[j - 1]) > keyMin)
+				{
+					m_proxies[j] = m_proxies[j - 1];
+					j--;
+					m_stats.m_sortSwapCount++;
+				}
+				m_proxies[j] = key;
+			}
+		}
+	}
+}
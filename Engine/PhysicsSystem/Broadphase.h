@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "PhysicsSystem.h"
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		// Two colliders whose bounds overlap and that should be handed to GJK
+		struct ColliderPair
+		{
+			Collider* m_A;
+			Collider* m_B;
+
+			ColliderPair() : m_A(nullptr), m_B(nullptr) {}
+			ColliderPair(Collider* i_A, Collider* i_B) : m_A(i_A), m_B(i_B) {}
+			// m_A gets the collider with the smaller id, so a pair is the same every run and whichever way around it was found
+			static ColliderPair Ordered(Collider* i_A, Collider* i_B) { return i_A->GetId() < i_B->GetId() ? ColliderPair(i_A, i_B) : ColliderPair(i_B, i_A); }
+		};
+
+		// Orders maps keyed by both colliders of a pair by id instead of by address, so iterating them gives the same order every run
+		struct sColliderPairIdLess
+		{
+			bool operator()(const std::pair<const Collider*, const Collider*>& i_lhs, const std::pair<const Collider*, const Collider*>& i_rhs) const
+			{
+				return i_lhs.first != i_rhs.first ? i_lhs.first->GetId() < i_rhs.first->GetId() : i_lhs.second->GetId() < i_rhs.second->GetId();
+			}
+		};
+
+		struct sBroadphaseStats
+		{
+			// Number of colliders currently registered
+			size_t m_proxyCount = 0;
+			// Pairs a brute force n * (n - 1) / 2 loop would have run GJK on
+			size_t m_bruteForcePairCount = 0;
+			// AABB vs AABB tests the sweep actually performed
+			size_t m_boundsTestCount = 0;
+			// Pairs that survived the broadphase and go to the narrowphase
+			size_t m_candidatePairCount = 0;
+			// Swaps made by the incremental insertion sort, low values mean the order was coherent
+			size_t m_sortSwapCount = 0;
+		};
+
+		// Sweep and prune over world-space AABBs.
+		// The proxies are kept sorted by their minimum along the sweep axis,
+		// and because objects barely move between two steps the order is repaired with an insertion sort,
+		// which is close to O(n) for coherent scenes.
+		class SweepAndPrune
+		{
+		public:
+			SweepAndPrune();
+
+			void AddCollider(Collider* i_collider);
+			void RemoveCollider(Collider* i_collider);
+			void Clear();
+
+			// Refresh all bounds, re-sort and sweep; the candidate pairs are rebuilt
+			void Update();
+
+			const std::vector<ColliderPair>& GetCandidatePairs() const { return m_candidatePairs; }
+			const sBroadphaseStats& GetStats() const { return m_stats; }
+			size_t GetSize() const { return m_proxies.size(); }
+
+		private:
+			struct Proxy
+			{
+				Collider* m_collider;
+				AABB m_bounds;
+			};
+
+			void ChooseSweepAxis();
+			void SortProxies();
+			float GetMin(const Proxy& i_proxy) const { return i_proxy.m_bounds.m_min.Get(m_sweepAxis); }
+			float GetMax(const Proxy& i_proxy) const { return i_proxy.m_bounds.m_max.Get(m_sweepAxis); }
+
+			std::vector<Proxy> m_proxies;
+			std::vector<ColliderPair> m_candidatePairs;
+			sBroadphaseStats m_stats;
+			int m_sweepAxis;
+		};
+	}
+}
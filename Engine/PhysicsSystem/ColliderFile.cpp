@@ -0,0 +1,303 @@
+// ColliderFile.cpp : Loads built collider files, see ColliderFormat.h for the layout
+//
+
+#include "PhysicsSystem.h"
+#include "ColliderFormat.h"
+#include "SupportKernels.h"
+#include <cstring>
+#include <utility>
+
+namespace
+{
+	// The sections are read in place, so the runtime types have to match what the builder wrote
+	static_assert(sizeof(PlutoShe::Physics::Vector3) == 3 * sizeof(float), "Vector3 has to be three packed floats");
+	static_assert(sizeof(PlutoShe::Physics::sFacePlane) == 4 * sizeof(float), "sFacePlane has to be four packed floats");
+
+	eae6320::cResult LoadColliderFile(const std::string& i_path, std::shared_ptr<eae6320::Platform::sDataFromFile>& o_file)
+	{
+		std::string errorMessage;
+		o_file = std::make_shared<eae6320::Platform::sDataFromFile>();
+		auto resultReadBinaryFile = eae6320::Platform::LoadBinaryFile(i_path.c_str(), *o_file, &errorMessage);
+		if (!resultReadBinaryFile)
+		{
+			eae6320::Logging::OutputError("Couldn't read binary file at path %s", i_path.c_str());
+		}
+		return resultReadBinaryFile;
+	}
+
+	bool IsCompactFile(const eae6320::Platform::sDataFromFile& i_file)
+	{
+		uint32_t magic = 0;
+		if (i_file.size >= sizeof(magic))
+		{
+			memcpy(&magic, i_file.data, sizeof(magic));
+		}
+		return magic == PlutoShe::Physics::ColliderFormat::s_magic;
+	}
+
+	// Returns 0 if the header or the hull headers can't be used
+	uint32_t GetHullCount(const eae6320::Platform::sDataFromFile& i_file, const std::string& i_path)
+	{
+		using namespace PlutoShe::Physics::ColliderFormat;
+		if (i_file.size < sizeof(sHeader))
+		{
+			eae6320::Logging::OutputError("Wrong file size at path %s", i_path.c_str());
+			return 0;
+		}
+		// LoadBinaryFile() allocates with malloc(), which is aligned enough for every section
+		const auto& header = *static_cast<const sHeader*>(i_file.data);
+		if (header.m_version != s_version)
+		{
+			eae6320::Logging::OutputError("Collider file at path %s is version %u instead of %u, it has to be rebuilt",
+				i_path.c_str(), header.m_version, s_version);
+			return 0;
+		}
+		if (header.m_hullCount == 0 || header.m_hullCount > (i_file.size - sizeof(sHeader)) / sizeof(sHullHeader))
+		{
+			eae6320::Logging::OutputError("Corrupted collider file at path %s", i_path.c_str());
+			return 0;
+		}
+		return header.m_hullCount;
+	}
+
+	// A section of i_count elements fits in the file after the hull headers and starts aligned
+	bool IsSectionValid(const eae6320::Platform::sDataFromFile& i_file, uint32_t i_offset, size_t i_count, size_t i_elementSize)
+	{
+		using namespace PlutoShe::Physics::ColliderFormat;
+		if (i_count == 0)
+		{
+			return true;
+		}
+		const size_t sectionsBegin = sizeof(sHeader) + static_cast<const sHeader*>(i_file.data)->m_hullCount * sizeof(sHullHeader);
+		return i_offset % s_sectionAlignment == 0
+			&& i_offset >= sectionsBegin
+			&& i_offset <= i_file.size && i_count <= (i_file.size - i_offset) / i_elementSize;
+	}
+
+	bool IsAdjacencyValid(const uint32_t* i_offsets, const uint16_t* i_adjacency, size_t i_vertexCount, size_t i_adjacencyCount)
+	{
+		bool isValid = i_offsets[0] == 0 && i_offsets[i_vertexCount] == i_adjacencyCount;
+		for (size_t i = 0; isValid && i < i_vertexCount; i++)
+		{
+			isValid = i_offsets[i] <= i_offsets[i + 1];
+		}
+		for (size_t i = 0; isValid && i < i_adjacencyCount; i++)
+		{
+			isValid = i_adjacency[i] < i_vertexCount;
+		}
+		return isValid;
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		eae6320::cResult PlutoShe::Physics::Collider::InitData(std::string i_path)
+		{
+			std::shared_ptr<eae6320::Platform::sDataFromFile> dataFromFile;
+			if (!LoadColliderFile(i_path, dataFromFile))
+			{
+				return eae6320::Results::Failure;
+			}
+			if (!IsCompactFile(*dataFromFile))
+			{
+				return initFromLegacyFile(*dataFromFile, i_path);
+			}
+			const uint32_t hullCount = GetHullCount(*dataFromFile, i_path);
+			if (hullCount != 1)
+			{
+				if (hullCount > 1)
+				{
+					eae6320::Logging::OutputError("Collider file at path %s holds %u hulls, it has to be loaded into a ColliderList", i_path.c_str(), hullCount);
+				}
+				return eae6320::Results::Failure;
+			}
+			return initFromCompactFile(dataFromFile, 0, i_path);
+		}
+
+		eae6320::cResult PlutoShe::Physics::Collider::initFromCompactFile(std::shared_ptr<const eae6320::Platform::sDataFromFile> i_file, uint32_t i_hullIndex, const std::string& i_path)
+		{
+			using ColliderFormat::sHeader;
+			using ColliderFormat::sHullHeader;
+			const auto* const data = static_cast<const uint8_t*>(i_file->data);
+			const auto& header = reinterpret_cast<const sHullHeader*>(data + sizeof(sHeader))[i_hullIndex];
+			const size_t vertexCount = header.m_vertexCount;
+			// The padding is baked into the file, so it has to match what the support kernels were compiled with
+			if (header.m_paddedVertexCount != SupportKernels::GetPaddedCount(vertexCount)
+				|| !IsSectionValid(*i_file, header.m_verticesOffset, vertexCount, sizeof(Vector3))
+				|| !IsSectionValid(*i_file, header.m_soaVerticesOffset, header.m_paddedVertexCount * size_t(3), sizeof(float))
+				|| !IsSectionValid(*i_file, header.m_facePlanesOffset, header.m_faceCount, sizeof(sFacePlane)))
+			{
+				eae6320::Logging::OutputError("Corrupted collider file at path %s", i_path.c_str());
+				return eae6320::Results::InvalidFile;
+			}
+
+			sHullView hull;
+			if (vertexCount > 0)
+			{
+				hull.m_vertices = reinterpret_cast<const Vector3*>(data + header.m_verticesOffset);
+				hull.m_soaVertices = reinterpret_cast<const float*>(data + header.m_soaVerticesOffset);
+			}
+			hull.m_vertexCount = vertexCount;
+			hull.m_paddedVertexCount = header.m_paddedVertexCount;
+			if (header.m_faceCount > 0)
+			{
+				hull.m_facePlanes = reinterpret_cast<const sFacePlane*>(data + header.m_facePlanesOffset);
+				hull.m_faceCount = header.m_faceCount;
+			}
+			if (header.m_adjacencyCount > 0)
+			{
+				if (IsSectionValid(*i_file, header.m_adjacencyOffsetsOffset, vertexCount + 1, sizeof(uint32_t))
+					&& IsSectionValid(*i_file, header.m_adjacencyOffset, header.m_adjacencyCount, sizeof(uint16_t)))
+				{
+					const auto* const offsets = reinterpret_cast<const uint32_t*>(data + header.m_adjacencyOffsetsOffset);
+					const auto* const adjacency = reinterpret_cast<const uint16_t*>(data + header.m_adjacencyOffset);
+					// Hill climbing trusts these indices, so they are checked once here instead
+					if (IsAdjacencyValid(offsets, adjacency, vertexCount, header.m_adjacencyCount))
+					{
+						hull.m_adjacencyOffsets = offsets;
+						hull.m_adjacency = adjacency;
+					}
+				}
+				if (!hull.m_adjacency)
+				{
+					// The hull still works without it, the support function falls back to scanning every vertex
+					eae6320::Logging::OutputError("Corrupted adjacency at path %s", i_path.c_str());
+				}
+			}
+			hull.m_localBounds.m_min = Vector3(header.m_boundsMin[0], header.m_boundsMin[1], header.m_boundsMin[2]);
+			hull.m_localBounds.m_max = Vector3(header.m_boundsMax[0], header.m_boundsMax[1], header.m_boundsMax[2]);
+			hull.m_localCenter = Vector3(header.m_center[0], header.m_center[1], header.m_center[2]);
+			hull.m_sphereCenter = Vector3(header.m_boundingSphere[0], header.m_boundingSphere[1], header.m_boundingSphere[2]);
+			hull.m_sphereRadius = header.m_boundingSphere[3];
+
+			m_shape = eShape::Hull;
+			m_vertices.clear();
+			m_adjacencyOffsets.clear();
+			m_adjacency.clear();
+			m_soaVertices.clear();
+			m_hull = hull;
+			m_file = i_file;
+			updateCachedBounds();
+			return eae6320::Results::Success;
+		}
+
+		eae6320::cResult PlutoShe::Physics::Collider::initFromLegacyFile(const eae6320::Platform::sDataFromFile& i_file, const std::string& i_path)
+		{
+			// A uint16_t vertex count and the vertices, then optionally a uint32_t adjacency count, the offsets and the neighbors.
+			// A file that ends anywhere else is corrupted, and the collider is only changed once all of it has been read
+			const auto* const data = static_cast<const uint8_t*>(i_file.data);
+			const size_t fileSize = i_file.size;
+			uint16_t vertexCount = 0;
+			if (fileSize < sizeof(vertexCount))
+			{
+				eae6320::Logging::OutputError("Wrong file size at path %s", i_path.c_str());
+				return eae6320::Results::InvalidFile;
+			}
+			std::memcpy(&vertexCount, data, sizeof(vertexCount));
+			size_t offset = sizeof(vertexCount);
+			if ((fileSize - offset) / sizeof(Vector3) < vertexCount)
+			{
+				eae6320::Logging::OutputError("Wrong file size at path %s", i_path.c_str());
+				return eae6320::Results::InvalidFile;
+			}
+			// The vertices are only 2 byte aligned in the file, so every one is copied out through floats
+			std::vector<Vector3> vertices(vertexCount);
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				float position[3];
+				std::memcpy(position, data + offset, sizeof(position));
+				vertices[i] = Vector3(position[0], position[1], position[2]);
+				offset += sizeof(position);
+			}
+
+			// Hull adjacency is optional, older collider files end after the vertices
+			std::vector<uint32_t> adjacencyOffsets;
+			std::vector<uint16_t> adjacency;
+			if (offset < fileSize)
+			{
+				uint32_t adjacencyCount = 0;
+				if (fileSize - offset < sizeof(adjacencyCount))
+				{
+					eae6320::Logging::OutputError("Wrong adjacency size at path %s", i_path.c_str());
+					return eae6320::Results::InvalidFile;
+				}
+				std::memcpy(&adjacencyCount, data + offset, sizeof(adjacencyCount));
+				offset += sizeof(adjacencyCount);
+				if (adjacencyCount > 0)
+				{
+					const size_t offsetsSize = (vertexCount + size_t(1)) * sizeof(uint32_t);
+					if (fileSize - offset < offsetsSize || (fileSize - offset - offsetsSize) / sizeof(uint16_t) < adjacencyCount)
+					{
+						eae6320::Logging::OutputError("Wrong adjacency size at path %s", i_path.c_str());
+						return eae6320::Results::InvalidFile;
+					}
+					adjacencyOffsets.resize(vertexCount + size_t(1));
+					std::memcpy(&adjacencyOffsets[0], data + offset, offsetsSize);
+					offset += offsetsSize;
+					adjacency.resize(adjacencyCount);
+					std::memcpy(&adjacency[0], data + offset, adjacencyCount * sizeof(uint16_t));
+					offset += adjacencyCount * sizeof(uint16_t);
+					if (!IsAdjacencyValid(&adjacencyOffsets[0], &adjacency[0], vertexCount, adjacencyCount))
+					{
+						// The hull still works without it, the support function falls back to scanning every vertex
+						eae6320::Logging::OutputError("Corrupted adjacency at path %s", i_path.c_str());
+						adjacencyOffsets.clear();
+						adjacency.clear();
+					}
+				}
+			}
+			if (offset != fileSize)
+			{
+				eae6320::Logging::OutputError("Wrong file size at path %s", i_path.c_str());
+				return eae6320::Results::InvalidFile;
+			}
+
+			m_shape = eShape::Hull;
+			m_vertices = std::move(vertices);
+			m_adjacencyOffsets = std::move(adjacencyOffsets);
+			m_adjacency = std::move(adjacency);
+			// The adjacency is in place before the vertices are refreshed so that the hull picks it up
+			RefreshVertices();
+			return eae6320::Results::Success;
+		}
+
+		eae6320::cResult PlutoShe::Physics::ColliderList::InitData(std::string i_path)
+		{
+			m_colliders.clear();
+			std::shared_ptr<eae6320::Platform::sDataFromFile> dataFromFile;
+			if (!LoadColliderFile(i_path, dataFromFile))
+			{
+				return eae6320::Results::Failure;
+			}
+			if (!IsCompactFile(*dataFromFile))
+			{
+				Collider collider;
+				const auto result = collider.initFromLegacyFile(*dataFromFile, i_path);
+				if (result)
+				{
+					m_colliders.push_back(collider);
+				}
+				return result;
+			}
+			const uint32_t hullCount = GetHullCount(*dataFromFile, i_path);
+			if (hullCount == 0)
+			{
+				return eae6320::Results::Failure;
+			}
+			// Every collider points into the same file
+			m_colliders.resize(hullCount);
+			for (uint32_t i = 0; i < hullCount; i++)
+			{
+				const auto result = m_colliders[i].initFromCompactFile(dataFromFile, i, i_path);
+				if (!result)
+				{
+					m_colliders.clear();
+					return result;
+				}
+			}
+			return eae6320::Results::Success;
+		}
+	}
+}
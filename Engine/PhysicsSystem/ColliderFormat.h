@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		// Layout of a built collider file, written by ColliderBuilder and read in place by Collider::InitData() and ColliderList::InitData().
+		// Everything the queries need is precomputed, so a loaded file is used as is: the runtime only points into it.
+		// The file is a header, one hull header per convex hull, then sections. Every section starts at a multiple of s_sectionAlignment
+		// and nothing in it is a pointer, so the same bytes work whether the file is read into memory or mapped.
+		// Files from before the header (a uint16_t vertex count, the vertices, then optional adjacency) are still loaded
+		namespace ColliderFormat
+		{
+			// "PCOL" read as a little-endian uint32_t. Legacy files start with their vertex count instead,
+			// one would need 17232 vertices and a first x coordinate with the right low bytes to be mistaken for it
+			constexpr uint32_t s_magic = 0x4C4F4350;
+			// Version 2 holds several hulls, e.g. the convex decomposition of a concave mesh
+			constexpr uint32_t s_version = 2;
+			constexpr uint32_t s_sectionAlignment = 16;
+
+			inline uint32_t AlignSection(uint32_t i_offset) { return (i_offset + s_sectionAlignment - 1) / s_sectionAlignment * s_sectionAlignment; }
+
+			struct sHeader
+			{
+				uint32_t m_magic;
+				uint32_t m_version;
+				// m_hullCount sHullHeader follow this header
+				uint32_t m_hullCount;
+				uint32_t m_reserved;
+
+				// Local space bounds of every hull together, the w components are unused
+				float m_boundsMin[4];
+				float m_boundsMax[4];
+			};
+			static_assert(sizeof(sHeader) % s_sectionAlignment == 0, "The hull headers have to start aligned right after the header");
+
+			// Offsets are from the start of the file, a section with a count of 0 has an offset of 0
+			struct sHullHeader
+			{
+				uint32_t m_vertexCount;
+				// Size of each SoA array, see SupportKernels::GetPaddedCount()
+				uint32_t m_paddedVertexCount;
+				uint32_t m_faceCount;
+				// Size of the packed neighbor list, 0 when the hull is degenerate and has no adjacency
+				uint32_t m_adjacencyCount;
+
+				// Local space, the w components are unused
+				float m_boundsMin[4];
+				float m_boundsMax[4];
+				// Average of the vertices, it is inside the hull and GJK starts from it
+				float m_center[4];
+				// xyz is the center, w the radius. Queries test it before running GJK on the hull
+				float m_boundingSphere[4];
+
+				// Vector3 array
+				uint32_t m_verticesOffset;
+				// All x, then all y, then all z, each one m_paddedVertexCount floats
+				uint32_t m_soaVerticesOffset;
+				// sFacePlane array, outward normals
+				uint32_t m_facePlanesOffset;
+				// m_vertexCount + 1 uint32_t, neighbors of vertex i are [offsets[i], offsets[i + 1]) in the neighbor list
+				uint32_t m_adjacencyOffsetsOffset;
+				// uint16_t vertex indices
+				uint32_t m_adjacencyOffset;
+				uint32_t m_padding[3];
+			};
+			static_assert(sizeof(sHullHeader) % s_sectionAlignment == 0, "Every hull header has to stay aligned");
+		}
+	}
+}
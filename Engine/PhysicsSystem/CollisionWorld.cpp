@@ -0,0 +1,492 @@
+#include "CollisionWorld.h"
+#include "Configuration.h"
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Concurrency/cThread.h>
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+	template<class tPairMap>
+	void ErasePairsWithCollider(tPairMap& io_map, const PlutoShe::Physics::Collider* i_collider)
+	{
+		for (auto it = io_map.begin(); it != io_map.end();)
+		{
+			if (it->first.first == i_collider || it->first.second == i_collider)
+			{
+				it = io_map.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	// Pairs are always stored with the smaller id in m_A (ColliderPair::Ordered()), so this orders a pair set the same way every run
+	bool IsPairLess(const PlutoShe::Physics::ColliderPair& i_lhs, const PlutoShe::Physics::ColliderPair& i_rhs)
+	{
+		return i_lhs.m_A != i_rhs.m_A ? i_lhs.m_A->GetId() < i_rhs.m_A->GetId() : i_lhs.m_B->GetId() < i_rhs.m_B->GetId();
+	}
+
+	bool ContainsPair(const std::vector<PlutoShe::Physics::ColliderPair>& i_pairSet, const PlutoShe::Physics::ColliderPair& i_pair)
+	{
+		return std::binary_search(i_pairSet.begin(), i_pairSet.end(), i_pair, IsPairLess);
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		void PlutoShe::Physics::CollisionWorld::AddCollider(Collider* i_collider)
+		{
+			EAE6320_ASSERTF(i_collider->GetId() != Collider::s_queryColliderId, "Query colliders share one id and can't be added to a collision world");
+			m_colliders.push_back(i_collider);
+			m_broadphase.AddCollider(i_collider);
+			m_queryTree.Insert(i_collider);
+		}
+
+		void PlutoShe::Physics::CollisionWorld::AddColliderList(ColliderList& i_colliderList)
+		{
+			for (size_t i = 0; i < i_colliderList.GetSize(); i++)
+			{
+				AddCollider(i_colliderList.GetColliderPointerByIndex(static_cast<int>(i)));
+			}
+		}
+
+		void PlutoShe::Physics::CollisionWorld::RemoveCollider(Collider* i_collider)
+		{
+			m_colliders.erase(std::remove(m_colliders.begin(), m_colliders.end(), i_collider), m_colliders.end());
+			m_broadphase.RemoveCollider(i_collider);
+			m_queryTree.Remove(i_collider);
+			ErasePairsWithCollider(m_manifolds, i_collider);
+			ErasePairsWithCollider(m_warmStarts, i_collider);
+			m_sweepStarts.erase(i_collider);
+			// A removed collider gets no end event, the pointer may not be valid by the next step
+			m_previousPairSet.erase(std::remove_if(m_previousPairSet.begin(), m_previousPairSet.end(),
+				[i_collider](const ColliderPair& i_pair) { return i_pair.m_A == i_collider || i_pair.m_B == i_collider; }), m_previousPairSet.end());
+		}
+
+		void PlutoShe::Physics::CollisionWorld::Clear()
+		{
+			m_colliders.clear();
+			m_broadphase.Clear();
+			m_queryTree.Clear();
+			m_collidingPairs.clear();
+			m_manifolds.clear();
+			m_warmStarts.clear();
+			m_sweepStarts.clear();
+			m_sweepHits.clear();
+			m_pairSet.clear();
+			m_previousPairSet.clear();
+			m_collisionEvents.clear();
+			m_narrowphaseStats = sNarrowphaseStats();
+			m_coldSeparatedTestCount = 0;
+			m_coldSeparatedIterationCount = 0;
+		}
+
+		void PlutoShe::Physics::CollisionWorld::Step()
+		{
+			m_broadphase.Update();
+			for (size_t i = 0; i < m_colliders.size(); i++)
+			{
+				m_queryTree.Move(m_colliders[i]);
+			}
+			m_collidingPairs.clear();
+
+			const std::vector<ColliderPair>& candidates = m_broadphase.GetCandidatePairs();
+			m_narrowphaseStats = sNarrowphaseStats();
+			m_stepCount++;
+			m_candidateWarmStarts.resize(candidates.size());
+			for (size_t i = 0; i < candidates.size(); i++)
+			{
+				sWarmStartEntry& warmStartEntry = m_warmStarts[std::make_pair(candidates[i].m_A, candidates[i].m_B)];
+				warmStartEntry.m_lastUsedStep = m_stepCount;
+				m_candidateWarmStarts[i] = &warmStartEntry;
+			}
+
+			RunNarrowphase();
+
+			// The buffers hold consecutive chunks of the candidates, so reading them in order is the single-threaded order
+			size_t warmIterationCount = 0;
+			for (size_t t = 0; t < m_workerThreadCount; t++)
+			{
+				const std::vector<sPairResult>& results = m_threadBuffers[t].m_results;
+				for (size_t i = 0; i < results.size(); i++)
+				{
+					const sPairResult& result = results[i];
+					const ColliderPair& pair = candidates[result.m_pairIndex];
+					if (result.m_isSleeping)
+					{
+						// Neither collider moved since they fell asleep, so the pair is still touching exactly when it was last step
+						m_narrowphaseStats.m_sleepingPairCount++;
+						if (WasCollidingLastStep(pair))
+						{
+							m_collidingPairs.push_back(pair);
+							auto manifold = m_manifolds.find(std::make_pair(pair.m_A, pair.m_B));
+							if (manifold != m_manifolds.end())
+							{
+								manifold->second.SetLastUpdatedStep(m_stepCount);
+							}
+						}
+						continue;
+					}
+
+					m_narrowphaseStats.m_testCount++;
+					const int iterationCount = result.m_queryInfo.m_iterationCount;
+					m_narrowphaseStats.m_iterationCount += iterationCount;
+					if (static_cast<size_t>(iterationCount) > m_narrowphaseStats.m_maxIterationCount)
+					{
+						m_narrowphaseStats.m_maxIterationCount = iterationCount;
+					}
+					if (result.m_queryInfo.m_exit == sGJKQueryInfo::eExit::IterationCap)
+					{
+						m_narrowphaseStats.m_iterationCapExitCount++;
+					}
+					else if (result.m_queryInfo.IsDegenerate())
+					{
+						m_narrowphaseStats.m_degenerateExitCount++;
+					}
+					if (result.m_isWarm)
+					{
+						m_narrowphaseStats.m_warmStartHitCount++;
+						warmIterationCount += iterationCount;
+					}
+					else if (!result.m_isCollided)
+					{
+						m_coldSeparatedTestCount++;
+						m_coldSeparatedIterationCount += iterationCount;
+					}
+
+					if (result.m_isCollided && result.m_isTrigger)
+					{
+						m_collidingPairs.push_back(pair);
+					}
+					else if (result.m_isCollided)
+					{
+						m_collidingPairs.push_back(pair);
+						ContactManifold& manifold = m_manifolds[std::make_pair(pair.m_A, pair.m_B)];
+						manifold.Refresh(*pair.m_A, *pair.m_B);
+						manifold.AddContact(*pair.m_A, *pair.m_B, result.m_contact);
+						manifold.SetLastUpdatedStep(m_stepCount);
+					}
+				}
+			}
+			if (m_narrowphaseStats.m_testCount > 0)
+			{
+				m_narrowphaseStats.m_warmStartHitRate = static_cast<float>(m_narrowphaseStats.m_warmStartHitCount) / static_cast<float>(m_narrowphaseStats.m_testCount);
+			}
+			if (m_narrowphaseStats.m_warmStartHitCount > 0 && m_coldSeparatedTestCount > 0)
+			{
+				m_narrowphaseStats.m_averageIterationsSaved = static_cast<float>(m_coldSeparatedIterationCount) / static_cast<float>(m_coldSeparatedTestCount)
+					- static_cast<float>(warmIterationCount) / static_cast<float>(m_narrowphaseStats.m_warmStartHitCount);
+			}
+
+			// Warm starts of pairs the broadphase no longer reports are stale
+			for (auto it = m_warmStarts.begin(); it != m_warmStarts.end();)
+			{
+				if (it->second.m_lastUsedStep != m_stepCount)
+				{
+					it = m_warmStarts.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+			// Manifolds of pairs that stopped touching this step are dropped
+			for (auto it = m_manifolds.begin(); it != m_manifolds.end();)
+			{
+				if (it->second.GetLastUpdatedStep() != m_stepCount)
+				{
+					it = m_manifolds.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+
+			m_pairSet = m_collidingPairs;
+			std::sort(m_pairSet.begin(), m_pairSet.end(), IsPairLess);
+			SweepFastColliders();
+			UpdateCollisionEvents();
+		}
+
+		void PlutoShe::Physics::CollisionWorld::SetWorkerThreadCount(unsigned int i_threadCount)
+		{
+			m_workerThreadCount = i_threadCount < 1 ? 1 : (i_threadCount > s_maxWorkerThreadCount ? s_maxWorkerThreadCount : i_threadCount);
+		}
+
+		void PlutoShe::Physics::CollisionWorld::RunNarrowphase()
+		{
+			const size_t pairCount = m_candidateWarmStarts.size();
+			size_t threadCount = m_workerThreadCount;
+			if (threadCount > 1)
+			{
+				const size_t usefulThreadCount = pairCount / s_minPairCountPerThread;
+				threadCount = usefulThreadCount < threadCount ? usefulThreadCount : threadCount;
+			}
+			for (size_t t = 0; t < s_maxWorkerThreadCount; t++)
+			{
+				m_threadBuffers[t].m_results.clear();
+			}
+			if (threadCount <= 1)
+			{
+				TestPairs(0, pairCount, m_threadBuffers[0]);
+				return;
+			}
+
+			// Every pair only writes to its own warm start entry and to the buffer of the thread testing it.
+			// The colliders are shared between threads but queries only read them
+			const size_t pairCountPerThread = (pairCount + threadCount - 1) / threadCount;
+			eae6320::Concurrency::cThread threads[s_maxWorkerThreadCount];
+			bool wasThreadStarted[s_maxWorkerThreadCount] = {};
+			for (size_t t = 1; t < threadCount; t++)
+			{
+				const size_t begin = t * pairCountPerThread;
+				const size_t end = (begin + pairCountPerThread) < pairCount ? (begin + pairCountPerThread) : pairCount;
+				sThreadBuffer* buffer = &m_threadBuffers[t];
+				wasThreadStarted[t] = threads[t].Start([this, begin, end, buffer](void* const)
+					{
+						TestPairs(begin, end, *buffer);
+					});
+				if (!wasThreadStarted[t])
+				{
+					eae6320::Logging::OutputError("A narrowphase worker thread couldn't be started");
+					TestPairs(begin, end, *buffer);
+				}
+			}
+			TestPairs(0, pairCountPerThread, m_threadBuffers[0]);
+			for (size_t t = 1; t < threadCount; t++)
+			{
+				if (wasThreadStarted[t])
+				{
+					WaitForThreadToStop(threads[t]);
+				}
+			}
+		}
+
+		void PlutoShe::Physics::CollisionWorld::RaycastBatch(const sRay* i_rays, size_t i_rayCount, sRaycastHit* o_hits) const
+		{
+			size_t threadCount = m_workerThreadCount;
+			if (threadCount > 1)
+			{
+				const size_t usefulThreadCount = i_rayCount / s_minRayCountPerThread;
+				threadCount = usefulThreadCount < threadCount ? usefulThreadCount : threadCount;
+			}
+			if (threadCount <= 1)
+			{
+				m_queryTree.RaycastBatch(i_rays, i_rayCount, o_hits);
+				return;
+			}
+
+			// Every chunk writes its own hits, the tree and the colliders are only read
+			const size_t rayCountPerThread = (i_rayCount + threadCount - 1) / threadCount;
+			eae6320::Concurrency::cThread threads[s_maxWorkerThreadCount];
+			bool wasThreadStarted[s_maxWorkerThreadCount] = {};
+			for (size_t t = 1; t < threadCount; t++)
+			{
+				const size_t begin = t * rayCountPerThread;
+				const size_t end = (begin + rayCountPerThread) < i_rayCount ? (begin + rayCountPerThread) : i_rayCount;
+				const DynamicAABBTree* tree = &m_queryTree;
+				wasThreadStarted[t] = threads[t].Start([tree, i_rays, o_hits, begin, end](void* const)
+					{
+						tree->RaycastBatch(i_rays + begin, end - begin, o_hits + begin);
+					});
+				if (!wasThreadStarted[t])
+				{
+					eae6320::Logging::OutputError("A raycast worker thread couldn't be started");
+					m_queryTree.RaycastBatch(i_rays + begin, end - begin, o_hits + begin);
+				}
+			}
+			m_queryTree.RaycastBatch(i_rays, rayCountPerThread, o_hits);
+			for (size_t t = 1; t < threadCount; t++)
+			{
+				if (wasThreadStarted[t])
+				{
+					WaitForThreadToStop(threads[t]);
+				}
+			}
+		}
+
+		void PlutoShe::Physics::CollisionWorld::TestPairs(size_t i_begin, size_t i_end, sThreadBuffer& o_buffer)
+		{
+			const std::vector<ColliderPair>& candidates = m_broadphase.GetCandidatePairs();
+			for (size_t i = i_begin; i < i_end; i++)
+			{
+				Collider& a = *candidates[i].m_A;
+				Collider& b = *candidates[i].m_B;
+				sPairResult result;
+				result.m_pairIndex = i;
+				if (!a.IsAwake() && !b.IsAwake())
+				{
+					result.m_isSleeping = true;
+				}
+				else
+				{
+					sGJKWarmStart& warmStart = m_candidateWarmStarts[i]->m_warmStart;
+					result.m_isWarm = warmStart.m_isValid;
+					result.m_isTrigger = a.IsTrigger() || b.IsTrigger();
+					result.m_isCollided = result.m_isTrigger ? a.Overlaps(b, &warmStart, &result.m_queryInfo)
+						: a.IsCollided(b, result.m_contact, &warmStart, &result.m_queryInfo);
+				}
+				o_buffer.m_results.push_back(result);
+			}
+		}
+
+		void PlutoShe::Physics::CollisionWorld::SweepFastColliders()
+		{
+			m_sweepHits.clear();
+			for (size_t i = 0; i < m_colliders.size(); i++)
+			{
+				Collider* fastCollider = m_colliders[i];
+				if (!fastCollider->IsFast())
+				{
+					continue;
+				}
+				Vector3 end = fastCollider->GetTransformation().GetTranslation();
+				auto sweepStart = m_sweepStarts.find(fastCollider);
+				if (sweepStart == m_sweepStarts.end())
+				{
+					// Nothing to sweep from on the first step
+					sSweepStart& newSweepStart = m_sweepStarts[fastCollider];
+					newSweepStart.m_translation = end;
+					newSweepStart.m_lastUsedStep = m_stepCount;
+					continue;
+				}
+				Vector3 translation = end - sweepStart->second.m_translation;
+				sweepStart->second.m_translation = end;
+				sweepStart->second.m_lastUsedStep = m_stepCount;
+				if (translation.dot(translation) <= PLUTOSHE_PHYSICS_CCD_TOLERANCE * PLUTOSHE_PHYSICS_CCD_TOLERANCE)
+				{
+					continue;
+				}
+
+				// Everything the collider passed over during the step
+				const AABB endBounds = fastCollider->GetAABB();
+				AABB startBounds;
+				startBounds.m_min = Vector3(endBounds.m_min) - translation;
+				startBounds.m_max = Vector3(endBounds.m_max) - translation;
+				m_sweepCandidates.clear();
+				m_queryTree.QueryAABB(AABB::Merge(startBounds, endBounds), m_sweepCandidates);
+
+				sSweepHit earliestHit;
+				for (size_t j = 0; j < m_sweepCandidates.size(); j++)
+				{
+					Collider* other = m_sweepCandidates[j];
+					// Pairs that still overlap were already reported by the discrete test.
+					// The other collider is treated as static at its current pose even if it is fast too
+					if (other == fastCollider || ContainsPair(m_pairSet, ColliderPair::Ordered(fastCollider, other)))
+					{
+						continue;
+					}
+					m_narrowphaseStats.m_sweepTestCount++;
+					sTimeOfImpactResult timeOfImpact;
+					if (fastCollider->TimeOfImpact(*other, translation, Vector3(), timeOfImpact)
+						&& (!earliestHit.m_other || timeOfImpact.m_time < earliestHit.m_timeOfImpact.m_time))
+					{
+						earliestHit.m_fastCollider = fastCollider;
+						earliestHit.m_other = other;
+						earliestHit.m_timeOfImpact = timeOfImpact;
+					}
+				}
+				if (earliestHit.m_other)
+				{
+					m_narrowphaseStats.m_sweepHitCount++;
+					m_sweepHits.push_back(earliestHit);
+					m_collidingPairs.push_back(ColliderPair::Ordered(fastCollider, earliestHit.m_other));
+				}
+			}
+			if (!m_sweepHits.empty())
+			{
+				// Two fast colliders can hit each other, so the same pair may have been added twice
+				m_pairSet = m_collidingPairs;
+				std::sort(m_pairSet.begin(), m_pairSet.end(), IsPairLess);
+				m_pairSet.erase(std::unique(m_pairSet.begin(), m_pairSet.end(),
+					[](const ColliderPair& i_lhs, const ColliderPair& i_rhs) { return i_lhs.m_A == i_rhs.m_A && i_lhs.m_B == i_rhs.m_B; }), m_pairSet.end());
+			}
+
+			// Sweep starts of colliders that are no longer fast are stale
+			for (auto it = m_sweepStarts.begin(); it != m_sweepStarts.end();)
+			{
+				if (it->second.m_lastUsedStep != m_stepCount)
+				{
+					it = m_sweepStarts.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		void PlutoShe::Physics::CollisionWorld::UpdateCollisionEvents()
+		{
+			// Both sets are sorted, so one merge pass finds the pairs that are in both, only in this step or only in the last
+			m_collisionEvents.clear();
+			size_t current = 0, previous = 0;
+			while (current < m_pairSet.size() || previous < m_previousPairSet.size())
+			{
+				sCollisionEvent collisionEvent;
+				if (previous >= m_previousPairSet.size() || (current < m_pairSet.size() && IsPairLess(m_pairSet[current], m_previousPairSet[previous])))
+				{
+					collisionEvent.m_A = m_pairSet[current].m_A;
+					collisionEvent.m_B = m_pairSet[current].m_B;
+					collisionEvent.m_type = sCollisionEvent::eType::Begin;
+					current++;
+				}
+				else if (current >= m_pairSet.size() || IsPairLess(m_previousPairSet[previous], m_pairSet[current]))
+				{
+					collisionEvent.m_A = m_previousPairSet[previous].m_A;
+					collisionEvent.m_B = m_previousPairSet[previous].m_B;
+					collisionEvent.m_type = sCollisionEvent::eType::End;
+					previous++;
+				}
+				else
+				{
+					collisionEvent.m_A = m_pairSet[current].m_A;
+					collisionEvent.m_B = m_pairSet[current].m_B;
+					collisionEvent.m_type = sCollisionEvent::eType::Stay;
+					current++;
+					previous++;
+				}
+				collisionEvent.m_isTrigger = collisionEvent.m_A->IsTrigger() || collisionEvent.m_B->IsTrigger();
+				m_collisionEvents.push_back(collisionEvent);
+			}
+			m_previousPairSet.swap(m_pairSet);
+
+			if (m_collisionEventCallback)
+			{
+				for (size_t i = 0; i < m_collisionEvents.size(); i++)
+				{
+					m_collisionEventCallback(m_collisionEvents[i]);
+				}
+			}
+		}
+
+		bool PlutoShe::Physics::CollisionWorld::WasCollidingLastStep(const ColliderPair& i_pair) const
+		{
+			return ContainsPair(m_previousPairSet, i_pair);
+		}
+
+		const ContactManifold* PlutoShe::Physics::CollisionWorld::GetManifold(const Collider* i_A, const Collider* i_B) const
+		{
+			auto it = m_manifolds.find(i_A->GetId() < i_B->GetId() ? std::make_pair(i_A, i_B) : std::make_pair(i_B, i_A));
+			return it != m_manifolds.end() ? &it->second : nullptr;
+		}
+
+		bool PlutoShe::Physics::CollisionWorld::IsColliding(const Collider* i_collider) const
+		{
+			for (size_t i = 0; i < m_collidingPairs.size(); i++)
+			{
+				if (m_collidingPairs[i].m_A == i_collider || m_collidingPairs[i].m_B == i_collider)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <vector>
+#include <map>
+#include <utility>
+#include <functional>
+#include "PhysicsSystem.h"
+#include "Broadphase.h"
+#include "AABBTree.h"
+#include "ContactManifold.h"
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		struct sNarrowphaseStats
+		{
+			// GJK calls made by the last step, compare against sBroadphaseStats::m_bruteForcePairCount
+			size_t m_testCount = 0;
+			// Tests that started from the pair's cached direction
+			size_t m_warmStartHitCount = 0;
+			// Support calls made by all the tests
+			size_t m_iterationCount = 0;
+			// The slowest test, watch this one for frame spikes
+			size_t m_maxIterationCount = 0;
+			// Tests stopped by PLUTOSHE_PHYSICS_GJK_MAX_ITERATIONS
+			size_t m_iterationCapExitCount = 0;
+			// Tests that stopped because the hulls were touching (no progress or a zero search direction)
+			size_t m_degenerateExitCount = 0;
+			// Candidate pairs whose colliders were both asleep, they kept last step's result without a test
+			size_t m_sleepingPairCount = 0;
+			// Time of impact queries made for fast colliders, and how many of them found an impact the discrete test missed
+			size_t m_sweepTestCount = 0;
+			size_t m_sweepHitCount = 0;
+			float m_warmStartHitRate = 0;
+			// Average support calls of separated pairs tested cold (over every step so far) minus the average of this step's warm tests
+			float m_averageIterationsSaved = 0;
+		};
+
+		// A fast collider that passed through another one during the last step
+		struct sSweepHit
+		{
+			Collider* m_fastCollider = nullptr;
+			Collider* m_other = nullptr;
+			sTimeOfImpactResult m_timeOfImpact;
+		};
+
+		// Change in the touching state of a pair between two steps
+		struct sCollisionEvent
+		{
+			enum class eType : uint8_t
+			{
+				Begin,
+				Stay,
+				End,
+			};
+
+			Collider* m_A = nullptr;
+			Collider* m_B = nullptr;
+			eType m_type = eType::Begin;
+			// At least one of the colliders is a trigger, so the pair has no manifold
+			bool m_isTrigger = false;
+		};
+		using fCollisionEventCallback = std::function<void(const sCollisionEvent&)>;
+
+		// Owns nothing, it only keeps pointers to the colliders that were registered,
+		// so a collider has to be removed before it is destroyed or moved in memory
+		class CollisionWorld
+		{
+		public:
+			void AddCollider(Collider* i_collider);
+			void AddColliderList(ColliderList& i_colliderList);
+			void RemoveCollider(Collider* i_collider);
+			void Clear();
+
+			// Broadphase first, then GJK only on the candidate pairs (split across the worker threads).
+			// The results are merged in candidate order, so they don't depend on the worker thread count.
+			// Fast colliders (Collider::IsFast()) are also swept from where they were at the previous step,
+			// a sweep hit is added to the colliding pairs (without a manifold) and to GetSweepHits()
+			void Step();
+
+			// Scene queries go through the AABB tree, which is refreshed by Step()
+			bool Raycast(const Vector3& i_origin, const Vector3& i_direction, float i_maxDistance, sRaycastHit& o_hit) const { return m_queryTree.Raycast(i_origin, i_direction, i_maxDistance, o_hit); }
+			void QueryAABB(const AABB& i_bounds, std::vector<Collider*>& o_colliders) const { m_queryTree.QueryAABB(i_bounds, o_colliders); }
+			void QuerySphere(const Vector3& i_center, float i_radius, std::vector<Collider*>& o_colliders) const { m_queryTree.QuerySphere(i_center, i_radius, o_colliders); }
+			void QueryBox(const eae6320::Math::cMatrix_transformation& i_transform, const Vector3& i_halfExtents, std::vector<Collider*>& o_colliders) const { m_queryTree.QueryBox(i_transform, i_halfExtents, o_colliders); }
+			void RaycastAll(const Vector3& i_origin, const Vector3& i_direction, float i_maxDistance, std::vector<sRaycastHit>& o_hits) const { m_queryTree.RaycastAll(i_origin, i_direction, i_maxDistance, o_hits); }
+			// Large batches are split across the worker threads, every ray gets the same hit as a single Raycast()
+			void RaycastBatch(const sRay* i_rays, size_t i_rayCount, sRaycastHit* o_hits) const;
+			bool SphereCast(const Vector3& i_origin, float i_radius, const Vector3& i_direction, float i_maxDistance, sRaycastHit& o_hit) const { return m_queryTree.SphereCast(i_origin, i_radius, i_direction, i_maxDistance, o_hit); }
+
+			const std::vector<ColliderPair>& GetCollidingPairs() const { return m_collidingPairs; }
+			// Earliest impact of every fast collider that would otherwise have tunneled during the last step
+			const std::vector<sSweepHit>& GetSweepHits() const { return m_sweepHits; }
+			// This step's colliding pairs diffed against the last step's, one event per pair sorted by pair
+			const std::vector<sCollisionEvent>& GetCollisionEvents() const { return m_collisionEvents; }
+			// Called for every event at the end of Step(), once GetCollisionEvents() is complete
+			void SetCollisionEventCallback(fCollisionEventCallback i_callback) { m_collisionEventCallback = i_callback; }
+			bool IsColliding(const Collider* i_collider) const;
+			// Contact manifold of a colliding pair, or nullptr if the pair isn't touching
+			const ContactManifold* GetManifold(const Collider* i_A, const Collider* i_B) const;
+			const std::map<std::pair<const Collider*, const Collider*>, ContactManifold, sColliderPairIdLess>& GetManifolds() const { return m_manifolds; }
+			const sBroadphaseStats& GetBroadphaseStats() const { return m_broadphase.GetStats(); }
+			// GJK calls made by the last step, compare against GetBroadphaseStats().m_bruteForcePairCount
+			size_t GetNarrowphaseTestCount() const { return m_narrowphaseStats.m_testCount; }
+			const sNarrowphaseStats& GetNarrowphaseStats() const { return m_narrowphaseStats; }
+
+			// 1 (the default) keeps the narrowphase and batched queries on the calling thread,
+			// otherwise the candidate pairs (or rays) are split into that many chunks and all but one are handed to new threads
+			void SetWorkerThreadCount(unsigned int i_threadCount);
+			unsigned int GetWorkerThreadCount() const { return m_workerThreadCount; }
+
+			static constexpr unsigned int s_maxWorkerThreadCount = 16;
+			// Below this many pairs (rays) per thread starting the threads costs more than it saves. The narrowphase benchmark
+			// prints the break-even: starting and joining a thread costs about 5 of its pairs or 2 of its rays, the margin covers
+			// cheaper pairs (e.g. sphere against sphere) and shorter rays than the benchmark's and slower thread creation
+			static constexpr size_t s_minPairCountPerThread = 32;
+			static constexpr size_t s_minRayCountPerThread = 16;
+
+		private:
+			struct sWarmStartEntry
+			{
+				sGJKWarmStart m_warmStart;
+				uint64_t m_lastUsedStep = 0;
+			};
+			// Everything the narrowphase found out about one candidate pair
+			struct sPairResult
+			{
+				size_t m_pairIndex = 0;
+				sContact m_contact;
+				sGJKQueryInfo m_queryInfo;
+				bool m_isCollided = false;
+				bool m_isWarm = false;
+				// Both colliders are asleep, the pair wasn't tested
+				bool m_isSleeping = false;
+				bool m_isTrigger = false;
+			};
+			// Every worker thread only writes to its own buffer, and on its own cache line
+			struct alignas(64) sThreadBuffer
+			{
+				std::vector<sPairResult> m_results;
+			};
+
+			void RunNarrowphase();
+			void TestPairs(size_t i_begin, size_t i_end, sThreadBuffer& o_buffer);
+			void SweepFastColliders();
+			void UpdateCollisionEvents();
+			bool WasCollidingLastStep(const ColliderPair& i_pair) const;
+
+			std::vector<Collider*> m_colliders;
+			SweepAndPrune m_broadphase;
+			DynamicAABBTree m_queryTree;
+			std::vector<ColliderPair> m_collidingPairs;
+			// m_collidingPairs sorted, and the same for the previous step
+			std::vector<ColliderPair> m_pairSet;
+			std::vector<ColliderPair> m_previousPairSet;
+			std::vector<sCollisionEvent> m_collisionEvents;
+			fCollisionEventCallback m_collisionEventCallback;
+			std::map<std::pair<const Collider*, const Collider*>, ContactManifold, sColliderPairIdLess> m_manifolds;
+			// One entry per broadphase pair, dropped as soon as the pair leaves the broadphase
+			std::map<std::pair<const Collider*, const Collider*>, sWarmStartEntry, sColliderPairIdLess> m_warmStarts;
+			// The entry of every candidate pair, looked up before the threads start because the map can't be shared
+			std::vector<sWarmStartEntry*> m_candidateWarmStarts;
+			sThreadBuffer m_threadBuffers[s_maxWorkerThreadCount];
+			unsigned int m_workerThreadCount = 1;
+			struct sSweepStart
+			{
+				Vector3 m_translation;
+				uint64_t m_lastUsedStep = 0;
+			};
+			// Where every fast collider was at the end of the previous step, dropped once the collider stops being fast
+			std::map<const Collider*, sSweepStart> m_sweepStarts;
+			std::vector<sSweepHit> m_sweepHits;
+			std::vector<Collider*> m_sweepCandidates;
+			sNarrowphaseStats m_narrowphaseStats;
+			// Running totals of the separated pairs that had nothing to start from, the baseline for m_averageIterationsSaved
+			uint64_t m_coldSeparatedTestCount = 0;
+			uint64_t m_coldSeparatedIterationCount = 0;
+			uint64_t m_stepCount = 0;
+		};
+	}
+}
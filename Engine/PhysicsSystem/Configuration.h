@@ -0,0 +1,26 @@
+/*
+	This file provides configurable settings
+	that can be used to control the collision queries
+*/
+
+#ifndef PLUTOSHE_PHYSICS_CONFIGURATION_H
+#define PLUTOSHE_PHYSICS_CONFIGURATION_H
+
+// GJK normally ends in a handful of iterations,
+// the cap only matters for nearly touching or degenerate hulls that would otherwise spin and cause frame spikes.
+// A query that hits the cap reports the pair as colliding because no separating axis was found
+#define PLUTOSHE_PHYSICS_GJK_MAX_ITERATIONS 32
+
+// Support points closer than this (in world units) to a point already in the simplex mean GJK stopped making progress,
+// which only happens when the origin lies on the boundary of the Minkowski difference (the hulls are touching).
+// The search direction test uses it relative to the size of the Minkowski difference instead
+#define PLUTOSHE_PHYSICS_GJK_TOLERANCE 1.0e-5f
+
+// Continuous collision detection stops advancing once the colliders are this close (in world units) and reports an impact
+#define PLUTOSHE_PHYSICS_CCD_TOLERANCE 1.0e-3f
+
+// Every conservative advancement step is a distance query, grazing sweeps that converge slowly give up here.
+// A sweep that hits the cap reports no impact, the discrete test still catches the pair if it ends up overlapping
+#define PLUTOSHE_PHYSICS_CCD_MAX_ITERATIONS 20
+
+#endif	// PLUTOSHE_PHYSICS_CONFIGURATION_H
@@ -0,0 +1,121 @@
+#include "ContactManifold.h"
+
+namespace
+{
+	// Points that separate or slide further than this are no longer trusted
+	constexpr float s_breakingThreshold = 0.02f;
+	// A new point this close to a cached one replaces it instead of taking a new slot
+	constexpr float s_mergeThreshold = 0.02f;
+
+	PlutoShe::Physics::Vector3 TransformToLocal(const eae6320::Math::cMatrix_transformation& i_localToWorld, const PlutoShe::Physics::Vector3& i_point)
+	{
+		// Colliders only ever have rotation and translation, so the camera helper's rigid inverse is exact here
+		auto worldToLocal = eae6320::Math::cMatrix_transformation::CreateWorldToCameraTransform(i_localToWorld);
+		return worldToLocal * i_point;
+	}
+
+	PlutoShe::Physics::Vector3 TransformToWorld(const eae6320::Math::cMatrix_transformation& i_localToWorld, const PlutoShe::Physics::Vector3& i_point)
+	{
+		auto localToWorld = i_localToWorld;
+		return localToWorld * i_point;
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		void PlutoShe::Physics::ContactManifold::Refresh(const Collider& i_A, const Collider& i_B)
+		{
+			for (int i = m_pointCount - 1; i >= 0; i--)
+			{
+				sContactPoint& point = m_points[i];
+				point.m_pointOnA = TransformToWorld(i_A.GetTransformation(), point.m_localPointA);
+				point.m_pointOnB = TransformToWorld(i_B.GetTransformation(), point.m_localPointB);
+				Vector3 separation = point.m_pointOnA - point.m_pointOnB;
+				point.m_depth = separation.dot(m_normal);
+
+				Vector3 lateral = separation - m_normal * point.m_depth;
+				if (point.m_depth < -s_breakingThreshold || lateral.dot(lateral) > s_breakingThreshold * s_breakingThreshold)
+				{
+					m_points[i] = m_points[m_pointCount - 1];
+					m_pointCount--;
+				}
+				else
+				{
+					point.m_lifetime++;
+				}
+			}
+		}
+
+		void PlutoShe::Physics::ContactManifold::AddContact(const Collider& i_A, const Collider& i_B, const sContact& i_contact)
+		{
+			m_normal = i_contact.m_normal;
+
+			sContactPoint newPoint;
+			newPoint.m_pointOnA = i_contact.m_pointOnA;
+			newPoint.m_pointOnB = i_contact.m_pointOnB;
+			newPoint.m_localPointA = TransformToLocal(i_A.GetTransformation(), i_contact.m_pointOnA);
+			newPoint.m_localPointB = TransformToLocal(i_B.GetTransformation(), i_contact.m_pointOnB);
+			newPoint.m_depth = i_contact.m_depth;
+
+			for (int i = 0; i < m_pointCount; i++)
+			{
+				Vector3 offset = m_points[i].m_localPointA - newPoint.m_localPointA;
+				if (offset.dot(offset) < s_mergeThreshold * s_mergeThreshold)
+				{
+					newPoint.m_lifetime = m_points[i].m_lifetime;
+					m_points[i] = newPoint;
+					return;
+				}
+			}
+
+			if (m_pointCount < s_maxPointCount)
+			{
+				m_points[m_pointCount++] = newPoint;
+			}
+			else
+			{
+				m_points[ChoosePointToReplace(newPoint)] = newPoint;
+			}
+		}
+
+		int PlutoShe::Physics::ContactManifold::ChoosePointToReplace(const sContactPoint& i_newPoint) const
+		{
+			// The deepest point is always kept, of the rest the one whose removal leaves the largest area goes
+			int deepest = 0;
+			for (int i = 1; i < s_maxPointCount; i++)
+			{
+				if (m_points[i].m_depth > m_points[deepest].m_depth)
+				{
+					deepest = i;
+				}
+			}
+
+			Vector3 p0 = m_points[0].m_localPointA;
+			Vector3 p1 = m_points[1].m_localPointA;
+			Vector3 p2 = m_points[2].m_localPointA;
+			Vector3 p3 = m_points[3].m_localPointA;
+			Vector3 n = i_newPoint.m_localPointA;
+			Vector3 crosses[s_maxPointCount] = {
+				(n - p1).cross(p3 - p2),
+				(n - p0).cross(p3 - p2),
+				(n - p0).cross(p3 - p1),
+				(n - p0).cross(p2 - p1),
+			};
+
+			int replace = deepest == 0 ? 1 : 0;
+			float largestArea = -1.0f;
+			for (int i = 0; i < s_maxPointCount; i++)
+			{
+				const float area = crosses[i].dot(crosses[i]);
+				if (i != deepest && area > largestArea)
+				{
+					largestArea = area;
+					replace = i;
+				}
+			}
+			return replace;
+		}
+	}
+}
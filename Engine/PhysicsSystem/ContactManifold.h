@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include "PhysicsSystem.h"
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		struct sContactPoint
+		{
+			// Anchors in each collider's local space, used to follow the point while the colliders move
+			Vector3 m_localPointA;
+			Vector3 m_localPointB;
+			// World space positions as of the last refresh
+			Vector3 m_pointOnA;
+			Vector3 m_pointOnB;
+			float m_depth = 0;
+			// Number of steps this point has survived
+			int m_lifetime = 0;
+		};
+
+		// Up to four contact points for one collider pair that persist from step to step.
+		// EPA only finds one point per query, so the manifold accumulates them over a few steps
+		// and drops points once the colliders have slid or separated too far for them to be valid.
+		class ContactManifold
+		{
+		public:
+			static constexpr int s_maxPointCount = 4;
+
+			ContactManifold() : m_pointCount(0), m_lastUpdatedStep(0) { }
+
+			// Moves the cached points with the colliders and removes the stale ones
+			void Refresh(const Collider& i_A, const Collider& i_B);
+			// Merges a new EPA contact into the manifold
+			void AddContact(const Collider& i_A, const Collider& i_B, const sContact& i_contact);
+			void Clear() { m_pointCount = 0; }
+
+			int GetPointCount() const { return m_pointCount; }
+			const sContactPoint& GetPoint(int i_index) const { return m_points[i_index]; }
+			// Points from A to B
+			const Vector3& GetNormal() const { return m_normal; }
+
+			uint64_t GetLastUpdatedStep() const { return m_lastUpdatedStep; }
+			void SetLastUpdatedStep(uint64_t i_step) { m_lastUpdatedStep = i_step; }
+
+		private:
+			int ChoosePointToReplace(const sContactPoint& i_newPoint) const;
+
+			sContactPoint m_points[s_maxPointCount];
+			int m_pointCount;
+			Vector3 m_normal;
+			uint64_t m_lastUpdatedStep;
+		};
+	}
+}
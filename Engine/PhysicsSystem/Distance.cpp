@@ -0,0 +1,268 @@
+// Distance.cpp : GJK distance query, finds the point of the Minkowski difference closest to the origin
+//
+
+#include "PhysicsSystem.h"
+#include "Configuration.h"
+#include <cmath>
+
+namespace
+{
+	// Stop when the support point can't bring the estimate closer by more than this fraction (of the squared distance).
+	// Curved shapes only approach the answer, so anything much tighter is lost in float round-off
+	constexpr float s_relativeTolerance = 1.0e-5f;
+
+	// Closest point to the origin on triangle abc (Real-Time Collision Detection, 5.1.5),
+	// o_weights are the barycentric coordinates and are 0 for the vertices that aren't needed
+	PlutoShe::Physics::Vector3 ClosestPointOnTriangle(PlutoShe::Physics::Vector3 i_a, PlutoShe::Physics::Vector3 i_b, PlutoShe::Physics::Vector3 i_c, float o_weights[3])
+	{
+		PlutoShe::Physics::Vector3 ab = i_b - i_a;
+		PlutoShe::Physics::Vector3 ac = i_c - i_a;
+		PlutoShe::Physics::Vector3 ao = i_a.Negate();
+		const float d1 = ab.dot(ao);
+		const float d2 = ac.dot(ao);
+		o_weights[0] = o_weights[1] = o_weights[2] = 0;
+		if (d1 <= 0 && d2 <= 0)
+		{
+			o_weights[0] = 1;
+			return i_a;
+		}
+		PlutoShe::Physics::Vector3 bo = i_b.Negate();
+		const float d3 = ab.dot(bo);
+		const float d4 = ac.dot(bo);
+		if (d3 >= 0 && d4 <= d3)
+		{
+			o_weights[1] = 1;
+			return i_b;
+		}
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0 && d1 >= 0 && d3 <= 0)
+		{
+			const float v = d1 / (d1 - d3);
+			o_weights[0] = 1 - v;
+			o_weights[1] = v;
+			return i_a + ab * v;
+		}
+		PlutoShe::Physics::Vector3 co = i_c.Negate();
+		const float d5 = ab.dot(co);
+		const float d6 = ac.dot(co);
+		if (d6 >= 0 && d5 <= d6)
+		{
+			o_weights[2] = 1;
+			return i_c;
+		}
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0 && d2 >= 0 && d6 <= 0)
+		{
+			const float w = d2 / (d2 - d6);
+			o_weights[0] = 1 - w;
+			o_weights[2] = w;
+			return i_a + ac * w;
+		}
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+		{
+			const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			o_weights[1] = 1 - w;
+			o_weights[2] = w;
+			return i_b + (i_c - i_b) * w;
+		}
+		const float denominator = 1.0f / (va + vb + vc);
+		const float v = vb * denominator;
+		const float w = vc * denominator;
+		o_weights[0] = 1 - v - w;
+		o_weights[1] = v;
+		o_weights[2] = w;
+		return i_a + ab * v + ac * w;
+	}
+
+	// Closest point to the origin on the simplex. The simplex is reduced to the points that support it,
+	// returns false if the origin is inside the tetrahedron
+	bool ReduceToClosestPoint(PlutoShe::Physics::Simplex& io_simplex, PlutoShe::Physics::Vector3& o_closest, float o_weights[4])
+	{
+		using namespace PlutoShe::Physics;
+		float weights[4] = { 1, 0, 0, 0 };
+		const size_t size = io_simplex.GetSize();
+		if (size == 1)
+		{
+			o_closest = io_simplex.m_points[0];
+		}
+		else if (size == 2)
+		{
+			Vector3 a = io_simplex.m_points[0];
+			Vector3 ab = io_simplex.m_points[1] - a;
+			const float lengthSqr = ab.dot(ab);
+			float t = lengthSqr > 0 ? -a.dot(ab) / lengthSqr : 0;
+			t = t < 0 ? 0 : (t > 1 ? 1 : t);
+			weights[0] = 1 - t;
+			weights[1] = t;
+			o_closest = a + ab * t;
+		}
+		else if (size == 3)
+		{
+			o_closest = ClosestPointOnTriangle(io_simplex.m_points[0], io_simplex.m_points[1], io_simplex.m_points[2], weights);
+		}
+		else
+		{
+			// Test the faces the origin is in front of, a flat tetrahedron has no inside so every face is tested
+			const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+			float bestDistanceSqr = -1;
+			for (int i = 0; i < 4; i++)
+			{
+				Vector3 a = io_simplex.m_points[faces[i][0]];
+				Vector3 normal = (io_simplex.m_points[faces[i][1]] - a).cross(io_simplex.m_points[faces[i][2]] - a);
+				const float originSide = normal.dot(a.Negate());
+				const float oppositeSide = normal.dot(io_simplex.m_points[faces[i][3]] - a);
+				if (originSide * oppositeSide > 0)
+				{
+					continue;
+				}
+				float faceWeights[3];
+				Vector3 closest = ClosestPointOnTriangle(a, io_simplex.m_points[faces[i][1]], io_simplex.m_points[faces[i][2]], faceWeights);
+				const float distanceSqr = closest.dot(closest);
+				if (bestDistanceSqr < 0 || distanceSqr < bestDistanceSqr)
+				{
+					bestDistanceSqr = distanceSqr;
+					o_closest = closest;
+					weights[faces[i][0]] = faceWeights[0];
+					weights[faces[i][1]] = faceWeights[1];
+					weights[faces[i][2]] = faceWeights[2];
+					weights[faces[i][3]] = 0;
+				}
+			}
+			if (bestDistanceSqr < 0)
+			{
+				return false;
+			}
+		}
+
+		// Keep only the points the closest point depends on, in their original order
+		Simplex reduced;
+		int reducedCount = 0;
+		for (size_t i = 0; i < size; i++)
+		{
+			if (weights[i] > 0)
+			{
+				reduced.Add(io_simplex.m_points[i], io_simplex.GetSupportA(i));
+				o_weights[reducedCount++] = weights[i];
+			}
+		}
+		io_simplex = reduced;
+		return true;
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		bool Collider::Distance(Collider& i_B, sDistanceResult& o_result, float i_maxDistance)
+		{
+			return RunDistance(i_B, Vector3(), Vector3(), o_result, i_maxDistance);
+		}
+
+		bool Collider::RunDistance(Collider& i_B, Vector3 i_offsetA, Vector3 i_offsetB, sDistanceResult& o_result, float i_maxDistance)
+		{
+			constexpr float toleranceSqr = PLUTOSHE_PHYSICS_GJK_TOLERANCE * PLUTOSHE_PHYSICS_GJK_TOLERANCE;
+			o_result = sDistanceResult();
+			// Translating A and B translates every point of the Minkowski difference by the difference of the offsets
+			Vector3 offset = i_offsetA - i_offsetB;
+			// The centroids are inside the hulls, so their difference is a point of the Minkowski difference to start from
+			Vector3 closest = this->Center() - i_B.Center() + offset;
+			Simplex simplex;
+			float weights[4] = { 1, 0, 0, 0 };
+			sSupportHint hint;
+			const float maxDistanceSqr = i_maxDistance * i_maxDistance;
+
+			for (int iteration = 0; iteration < PLUTOSHE_PHYSICS_GJK_MAX_ITERATIONS; iteration++)
+			{
+				const float closestSqr = closest.dot(closest);
+				if (closestSqr <= toleranceSqr)
+				{
+					o_result.m_isOverlapping = true;
+					break;
+				}
+
+				Vector3 supportA;
+				Vector3 support = supportFunction(*this, i_B, closest.Negate(), supportA, hint) + offset;
+				supportA = supportA + i_offsetA;
+				// closest . support / |closest| is a lower bound of the distance,
+				// once it passes the max distance the exact value doesn't matter
+				const float lowerBound = closest.dot(support);
+				if (lowerBound > 0 && lowerBound * lowerBound > maxDistanceSqr * closestSqr)
+				{
+					return false;
+				}
+				if (closestSqr - lowerBound <= s_relativeTolerance * closestSqr)
+				{
+					break;
+				}
+				bool isDuplicate = false;
+				for (size_t i = 0; i < simplex.GetSize(); i++)
+				{
+					Vector3 offset = support - simplex.m_points[i];
+					if (offset.dot(offset) <= toleranceSqr)
+					{
+						isDuplicate = true;
+					}
+				}
+				if (isDuplicate)
+				{
+					break;
+				}
+
+				// A nearly flat simplex can round to a point farther away than the last one,
+				// the estimate has to shrink every iteration so the last one is kept and the query ends there
+				// (the starting point isn't on the Minkowski difference, so the first support point is exempt)
+				Simplex previousSimplex = simplex;
+				const Vector3 previousClosest = closest;
+				float previousWeights[4] = { weights[0], weights[1], weights[2], weights[3] };
+				simplex.Add(support, supportA);
+				if (!ReduceToClosestPoint(simplex, closest, weights))
+				{
+					o_result.m_isOverlapping = true;
+					break;
+				}
+				if (previousSimplex.GetSize() > 0 && closest.dot(closest) >= closestSqr)
+				{
+					simplex = previousSimplex;
+					closest = previousClosest;
+					for (int i = 0; i < 4; i++)
+					{
+						weights[i] = previousWeights[i];
+					}
+					break;
+				}
+			}
+
+			if (o_result.m_isOverlapping)
+			{
+				o_result.m_distance = 0;
+				o_result.m_pointOnA = this->Center() + i_offsetA;
+				o_result.m_pointOnB = i_B.Center() + i_offsetB;
+				return true;
+			}
+
+			o_result.m_distance = eae6320::Math::Sqrt(closest.dot(closest));
+			if (o_result.m_distance > i_maxDistance)
+			{
+				return false;
+			}
+			if (simplex.GetSize() == 0)
+			{
+				// Converged on the starting point, which isn't a support point, so there are no witnesses yet
+				o_result.m_pointOnA = this->Center() + i_offsetA;
+				o_result.m_pointOnB = i_B.Center() + i_offsetB;
+				return true;
+			}
+			// The Minkowski point is a - b, so the same weights applied to the A side give both witness points
+			Vector3 pointOnA;
+			for (size_t i = 0; i < simplex.GetSize(); i++)
+			{
+				pointOnA = pointOnA + simplex.GetSupportA(i) * weights[i];
+			}
+			o_result.m_pointOnA = pointOnA;
+			o_result.m_pointOnB = pointOnA - closest;
+			return true;
+		}
+	}
+}
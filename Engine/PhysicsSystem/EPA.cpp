@@ -0,0 +1,206 @@
+// EPA.cpp : Expanding Polytope Algorithm, run on the simplex GJK terminates with
+//
+
+#include "PhysicsSystem.h"
+#include <cmath>
+
+namespace
+{
+	struct sPolytopeFace
+	{
+		int m_a, m_b, m_c;
+		PlutoShe::Physics::Vector3 m_normal;
+		float m_distance;
+	};
+
+	struct sPolytopeEdge
+	{
+		int m_from, m_to;
+	};
+
+	constexpr int s_maxIterations = 64;
+	constexpr float s_convergenceTolerance = 1.0e-4f;
+	constexpr float s_degenerateTolerance = 1.0e-10f;
+
+	// Builds a face whose normal points away from the interior point
+	bool MakeFace(std::vector<PlutoShe::Physics::Vector3>& i_points, int i_a, int i_b, int i_c,
+		PlutoShe::Physics::Vector3& i_interior, sPolytopeFace& o_face)
+	{
+		PlutoShe::Physics::Vector3 ab = i_points[i_b] - i_points[i_a];
+		PlutoShe::Physics::Vector3 ac = i_points[i_c] - i_points[i_a];
+		PlutoShe::Physics::Vector3 normal = ab.cross(ac);
+		const float lengthSqr = normal.dot(normal);
+		if (lengthSqr < s_degenerateTolerance)
+		{
+			return false;
+		}
+		normal = normal / eae6320::Math::Sqrt(lengthSqr);
+		if (normal.dot(i_interior - i_points[i_a]) > 0)
+		{
+			normal = normal.Negate();
+			const int temp = i_b; i_b = i_c; i_c = temp;
+		}
+		o_face.m_a = i_a;
+		o_face.m_b = i_b;
+		o_face.m_c = i_c;
+		o_face.m_normal = normal;
+		o_face.m_distance = normal.dot(i_points[i_a]);
+		return true;
+	}
+
+	void AddHorizonEdge(std::vector<sPolytopeEdge>& io_edges, int i_from, int i_to)
+	{
+		// An edge shared by two removed faces is seen twice in opposite directions and isn't on the horizon
+		for (size_t i = 0; i < io_edges.size(); i++)
+		{
+			if (io_edges[i].m_from == i_to && io_edges[i].m_to == i_from)
+			{
+				io_edges.erase(io_edges.begin() + i);
+				return;
+			}
+		}
+		sPolytopeEdge edge;
+		edge.m_from = i_from;
+		edge.m_to = i_to;
+		io_edges.push_back(edge);
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		bool Collider::RunEPA(Collider& i_B, Simplex& i_simplex, sContact& o_contact)
+		{
+			// If the polytope can't be built the pair is still colliding, but only a rough contact can be reported
+			o_contact.m_normal = i_B.Center() - this->Center();
+			const float centerDistance = eae6320::Math::Sqrt(o_contact.m_normal.dot(o_contact.m_normal));
+			o_contact.m_normal = centerDistance > 0 ? o_contact.m_normal / centerDistance : Vector3(0, 1, 0);
+			o_contact.m_depth = 0;
+			o_contact.m_pointOnA = this->Center();
+			o_contact.m_pointOnB = i_B.Center();
+			if (i_simplex.GetSize() != 4)
+			{
+				return false;
+			}
+
+			std::vector<Vector3> points;
+			std::vector<Vector3> supportsA;
+			for (size_t i = 0; i < 4; i++)
+			{
+				points.push_back(i_simplex.m_points[i]);
+				supportsA.push_back(i_simplex.GetSupportA(i));
+			}
+			// The centroid of the starting tetrahedron stays inside the polytope while it grows
+			Vector3 interior = (points[0] + points[1] + points[2] + points[3]) / 4.0f;
+
+			std::vector<sPolytopeFace> faces;
+			const int tetrahedron[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+			for (int i = 0; i < 4; i++)
+			{
+				sPolytopeFace face;
+				if (!MakeFace(points, tetrahedron[i][0], tetrahedron[i][1], tetrahedron[i][2], interior, face))
+				{
+					return false;
+				}
+				faces.push_back(face);
+			}
+
+			std::vector<sPolytopeEdge> horizon;
+			sSupportHint hint;
+			size_t closest = 0;
+			for (int iteration = 0; iteration < s_maxIterations; iteration++)
+			{
+				closest = 0;
+				for (size_t i = 1; i < faces.size(); i++)
+				{
+					if (faces[i].m_distance < faces[closest].m_distance)
+					{
+						closest = i;
+					}
+				}
+
+				Vector3 supportA;
+				Vector3 support = supportFunction(*this, i_B, faces[closest].m_normal, supportA, hint);
+				if (support.dot(faces[closest].m_normal) - faces[closest].m_distance < s_convergenceTolerance)
+				{
+					break;
+				}
+
+				const int newIndex = static_cast<int>(points.size());
+				points.push_back(support);
+				supportsA.push_back(supportA);
+
+				horizon.clear();
+				for (size_t i = 0; i < faces.size();)
+				{
+					if (faces[i].m_normal.dot(support - points[faces[i].m_a]) > 0)
+					{
+						AddHorizonEdge(horizon, faces[i].m_a, faces[i].m_b);
+						AddHorizonEdge(horizon, faces[i].m_b, faces[i].m_c);
+						AddHorizonEdge(horizon, faces[i].m_c, faces[i].m_a);
+						faces[i] = faces.back();
+						faces.pop_back();
+					}
+					else
+					{
+						i++;
+					}
+				}
+
+				if (horizon.empty())
+				{
+					return false;
+				}
+				for (size_t i = 0; i < horizon.size(); i++)
+				{
+					sPolytopeFace face;
+					if (MakeFace(points, horizon[i].m_from, horizon[i].m_to, newIndex, interior, face))
+					{
+						faces.push_back(face);
+					}
+				}
+				if (faces.empty())
+				{
+					return false;
+				}
+			}
+
+			closest = 0;
+			for (size_t i = 1; i < faces.size(); i++)
+			{
+				if (faces[i].m_distance < faces[closest].m_distance)
+				{
+					closest = i;
+				}
+			}
+			sPolytopeFace& face = faces[closest];
+
+			// Barycentric coordinates of the origin's projection on the closest face
+			// give the matching points on the two colliders
+			Vector3 projection = face.m_normal * face.m_distance;
+			Vector3 v0 = points[face.m_b] - points[face.m_a];
+			Vector3 v1 = points[face.m_c] - points[face.m_a];
+			Vector3 v2 = projection - points[face.m_a];
+			const float d00 = v0.dot(v0);
+			const float d01 = v0.dot(v1);
+			const float d11 = v1.dot(v1);
+			const float d20 = v2.dot(v0);
+			const float d21 = v2.dot(v1);
+			const float denominator = d00 * d11 - d01 * d01;
+			float v = 1.0f / 3.0f, w = 1.0f / 3.0f;
+			if (std::abs(denominator) > s_degenerateTolerance)
+			{
+				v = (d11 * d20 - d01 * d21) / denominator;
+				w = (d00 * d21 - d01 * d20) / denominator;
+			}
+			const float u = 1.0f - v - w;
+
+			o_contact.m_normal = face.m_normal;
+			o_contact.m_depth = face.m_distance;
+			o_contact.m_pointOnA = supportsA[face.m_a] * u + supportsA[face.m_b] * v + supportsA[face.m_c] * w;
+			o_contact.m_pointOnB = o_contact.m_pointOnA - projection;
+			return true;
+		}
+	}
+}
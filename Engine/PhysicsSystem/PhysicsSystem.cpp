@@ -2,65 +2,400 @@
 //
 
 #include "PhysicsSystem.h"
+#include "SupportKernels.h"
+#include "Configuration.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 
 namespace PlutoShe
 {
 	namespace Physics
 	{
-		Vector3 Collider::getFarthestPointInDirection(Vector3 i_dir)
+		namespace
 		{
-			int selection = 0;
-			float maxDist = (m_transformation * m_vertices[0]).dot(i_dir);
-			for (size_t i = 1; i < m_vertices.size(); i++)
+			// Below this the SIMD linear scan beats walking the hull, GJK's support directions flip from one side
+			// of the hull to the other so the walk rarely starts next to the answer (see the hillclimbing benchmark)
+			constexpr size_t s_minVertexCountForHillClimbing = 256;
+			std::atomic<uint64_t> s_nextColliderId(0);
+		}
+
+		int Collider::climbToFarthestVertex(Vector3& i_localDir, int& io_hint)
+		{
+			const int vertexCount = static_cast<int>(m_hull.m_vertexCount);
+			const uint32_t* offsets = m_hull.m_adjacencyOffsets;
+			int current = io_hint;
+			// Interior vertices have no neighbors and can't be climbed from
+			if (current < 0 || current >= vertexCount || offsets[current] == offsets[current + 1])
+			{
+				current = -1;
+				for (int i = 0; i < vertexCount; i++)
+				{
+					if (offsets[i] != offsets[i + 1])
+					{
+						current = i;
+						break;
+					}
+				}
+				if (current < 0)
+				{
+					return -1;
+				}
+			}
+
+			float currentDist = i_localDir.dot(m_hull.m_vertices[current]);
+			// The hull is convex, so a vertex with no better neighbor is the global maximum.
+			// Every step strictly increases the distance, so the walk can't revisit a vertex and the bound is only a safety net
+			for (int step = 0; step < vertexCount; step++)
+			{
+				int best = current;
+				for (uint32_t i = offsets[current]; i < offsets[current + 1]; i++)
+				{
+					const int neighbor = m_hull.m_adjacency[i];
+					const float dist = i_localDir.dot(m_hull.m_vertices[neighbor]);
+					if (dist > currentDist)
+					{
+						currentDist = dist;
+						best = neighbor;
+					}
+				}
+				if (best == current)
+				{
+					io_hint = current;
+					return current;
+				}
+				current = best;
+			}
+			return -1;
+		}
+
+		Vector3 Collider::getFarthestPointInDirection(Vector3 i_dir, int& io_hint)
+		{
+			if (m_shape != eShape::Hull)
 			{
-				float dist = (m_transformation * m_vertices[i]).dot(i_dir);
-				if (dist > maxDist)
+				return getPrimitiveSupport(i_dir);
+			}
+			// dot(M * v, d) == dot(v, transpose(M) * d), so the direction is moved into local space once
+			// and only the winning vertex is transformed back
+			Vector3 localDir(Vector3(m_transformation.GetRightDirection()).dot(i_dir),
+				Vector3(m_transformation.GetUpDirection()).dot(i_dir),
+				Vector3(m_transformation.GetBackDirection()).dot(i_dir));
+			return m_transformation * m_hull.m_vertices[getFarthestVertexIndex(localDir, io_hint)];
+		}
+
+		int Collider::getFarthestVertexIndex(Vector3& i_localDir, int& io_hint)
+		{
+			if (m_hull.m_vertexCount >= s_minVertexCountForHillClimbing && m_hull.m_adjacencyOffsets)
+			{
+				const int selection = climbToFarthestVertex(i_localDir, io_hint);
+				if (selection >= 0)
 				{
-					maxDist = dist;
-					selection = (int)i;
+					return selection;
 				}
 			}
-			return m_transformation * m_vertices[selection];
+
+			// Queries only read the collider, the SoA copy is kept up to date by RefreshVertices() and UpdateTransformation()
+			const size_t paddedCount = m_hull.m_paddedVertexCount;
+			const float* x = m_hull.m_soaVertices;
+			return SupportKernels::GetFindMaxDot()(x, x + paddedCount, x + 2 * paddedCount, paddedCount, i_localDir.m_x, i_localDir.m_y, i_localDir.m_z);
+		}
+
+		void Collider::updateSoaVertices()
+		{
+			const size_t vertexCount = m_vertices.size();
+			const size_t paddedCount = SupportKernels::GetPaddedCount(vertexCount);
+			m_soaVertices.resize(paddedCount * 3);
+			for (size_t i = 0; i < paddedCount; i++)
+			{
+				// The padding repeats the first vertex, it ties with it and loses on index
+				const Vector3& v = m_vertices[i < vertexCount ? i : 0];
+				m_soaVertices[i] = v.m_x;
+				m_soaVertices[paddedCount + i] = v.m_y;
+				m_soaVertices[2 * paddedCount + i] = v.m_z;
+			}
+
+			// Collider files have these precomputed, vertex arrays pay for them here once per edit instead of every update
+			Vector3 boundsMin = m_vertices.empty() ? Vector3() : m_vertices[0];
+			Vector3 boundsMax = boundsMin;
+			Vector3 localCenter;
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				const Vector3& v = m_vertices[i];
+				boundsMin = Vector3(std::min(boundsMin.m_x, v.m_x), std::min(boundsMin.m_y, v.m_y), std::min(boundsMin.m_z, v.m_z));
+				boundsMax = Vector3(std::max(boundsMax.m_x, v.m_x), std::max(boundsMax.m_y, v.m_y), std::max(boundsMax.m_z, v.m_z));
+				localCenter = localCenter + v;
+			}
+			m_hull.m_localBounds.m_min = boundsMin;
+			m_hull.m_localBounds.m_max = boundsMax;
+			m_hull.m_localCenter = vertexCount > 0 ? localCenter / float(vertexCount) : Vector3();
+			float radiusSqr = 0;
+			for (size_t i = 0; i < vertexCount; i++)
+			{
+				Vector3 offset = m_vertices[i] - m_hull.m_localCenter;
+				radiusSqr = std::max(radiusSqr, offset.dot(offset));
+			}
+			m_hull.m_sphereCenter = m_hull.m_localCenter;
+			m_hull.m_sphereRadius = eae6320::Math::Sqrt(radiusSqr);
+			m_hull.m_facePlanes = nullptr;
+			m_hull.m_faceCount = 0;
+			pointHullAtVectors();
 		}
 
-		Vector3 Collider::supportFunction(Collider&i_A, Collider&i_B, Vector3 i_dir)
+		void Collider::pointHullAtVectors()
 		{
-			auto a = i_A.getFarthestPointInDirection(i_dir);
-			auto b = i_B.getFarthestPointInDirection(i_dir.Negate());
+			m_hull.m_vertexCount = m_vertices.size();
+			m_hull.m_vertices = m_vertices.empty() ? nullptr : &m_vertices[0];
+			m_hull.m_paddedVertexCount = m_soaVertices.size() / 3;
+			m_hull.m_soaVertices = m_soaVertices.empty() ? nullptr : &m_soaVertices[0];
+			const bool hasAdjacency = !m_adjacency.empty() && m_adjacencyOffsets.size() == m_vertices.size() + 1;
+			m_hull.m_adjacencyOffsets = hasAdjacency ? &m_adjacencyOffsets[0] : nullptr;
+			m_hull.m_adjacency = hasAdjacency ? &m_adjacency[0] : nullptr;
+		}
+
+		Vector3 Collider::supportFunction(Collider&i_A, Collider&i_B, Vector3 i_dir, sSupportHint& io_hint)
+		{
+			auto a = i_A.getFarthestPointInDirection(i_dir, io_hint.m_indexA);
+			auto b = i_B.getFarthestPointInDirection(i_dir.Negate(), io_hint.m_indexB);
 			return a - b;	
 		}
 
+		Vector3 Collider::supportFunction(Collider& i_A, Collider& i_B, Vector3 i_dir, Vector3& o_supportA, sSupportHint& io_hint)
+		{
+			o_supportA = i_A.getFarthestPointInDirection(i_dir, io_hint.m_indexA);
+			auto b = i_B.getFarthestPointInDirection(i_dir.Negate(), io_hint.m_indexB);
+			return o_supportA - b;
+		}
+
+		void Collider::RefreshVertices()
+		{
+			// The vectors take over from the file the collider was loaded from
+			m_file.reset();
+			updateSoaVertices();
+			updateCachedBounds();
+		}
+
+		void Collider::updateCachedBounds()
+		{
+			// Keeps up with vectors edited without RefreshVertices(), as long as it is cheap to
+			if (m_shape == eShape::Hull && !m_file && m_hull.m_vertexCount != m_vertices.size())
+			{
+				updateSoaVertices();
+			}
+			else if (m_shape == eShape::Hull && !m_file)
+			{
+				pointHullAtVectors();
+			}
+			updateBoundingSphere();
+
+			if (m_shape != eShape::Hull)
+			{
+				m_worldCenter = m_transformation.GetTranslation();
+			}
+			else
+			{
+				if (m_hull.m_vertexCount == 0)
+				{
+					m_worldCenter = m_transformation.GetTranslation();
+					m_worldBounds.m_min = m_worldCenter;
+					m_worldBounds.m_max = m_worldCenter;
+					return;
+				}
+				m_worldCenter = m_transformation * m_hull.m_localCenter;
+			}
 
-		Vector3 Collider::Center()
+			// The exact bounds are the support points along the six world axes
+			int hint = -1;
+			m_worldBounds.m_min = Vector3(getFarthestPointInDirection(Vector3(-1, 0, 0), hint).m_x,
+				getFarthestPointInDirection(Vector3(0, -1, 0), hint).m_y,
+				getFarthestPointInDirection(Vector3(0, 0, -1), hint).m_z);
+			m_worldBounds.m_max = Vector3(getFarthestPointInDirection(Vector3(1, 0, 0), hint).m_x,
+				getFarthestPointInDirection(Vector3(0, 1, 0), hint).m_y,
+				getFarthestPointInDirection(Vector3(0, 0, 1), hint).m_z);
+		}
+
+		void Collider::updateBoundingSphere()
 		{
-			Vector3 center;
-			int count = 0;
-			for (size_t i = 0; i < m_vertices.size(); i++)
+			Vector3 localCenter;
+			float localRadius = 0;
+			switch (m_shape)
 			{
-				center = center + m_transformation * m_vertices[i];
-				count++;
+			case eShape::Sphere: localRadius = m_radius; break;
+			case eShape::Capsule: localRadius = m_radius + m_halfHeight; break;
+			case eShape::Box: localRadius = eae6320::Math::Sqrt(Vector3(m_halfExtents).dot(m_halfExtents)); break;
+			default:
+				localCenter = m_hull.m_sphereCenter;
+				localRadius = m_hull.m_sphereRadius;
+				break;
 			}
-			return center / float(count);
+			m_worldSphereCenter = m_transformation * localCenter;
+			// A scaled transformation grows the sphere by its largest axis scale
+			const float scaleSqr = std::max(Vector3(m_transformation.GetRightDirection()).dot(Vector3(m_transformation.GetRightDirection())),
+				std::max(Vector3(m_transformation.GetUpDirection()).dot(Vector3(m_transformation.GetUpDirection())),
+					Vector3(m_transformation.GetBackDirection()).dot(Vector3(m_transformation.GetBackDirection()))));
+			m_worldSphereRadius = localRadius * eae6320::Math::Sqrt(scaleSqr);
+		}
+
+		bool Collider::areBoundingSpheresSeparated(const Collider& i_B) const
+		{
+			// GJK counts colliders within its tolerance as touching, so the spheres have to leave them to it
+			const float reach = m_worldSphereRadius + i_B.m_worldSphereRadius + PLUTOSHE_PHYSICS_GJK_TOLERANCE;
+			Vector3 offset = Vector3(i_B.m_worldSphereCenter) - m_worldSphereCenter;
+			return offset.dot(offset) > reach * reach;
 		}
 
 		bool Collider::IsCollided(Collider&i_B)
 		{
-			Vector3 dir = i_B.Center() - this->Center();
+			if (const fPairTest pairTest = GetPairTest(m_shape, i_B.m_shape))
+			{
+				return pairTest(*this, i_B, nullptr);
+			}
+			if (areBoundingSpheresSeparated(i_B))
+			{
+				return false;
+			}
 			Simplex simplex;
-			simplex.Clear();
-			while (true)
+			return RunGJK(i_B, simplex);
+		}
+
+		bool Collider::IsCollided(Collider& i_B, sContact& o_contact, sGJKWarmStart* io_warmStart, sGJKQueryInfo* o_info)
+		{
+			if (const fPairTest pairTest = GetPairTest(m_shape, i_B.m_shape))
 			{
-				simplex.Add(supportFunction(*this, i_B, dir));
+				const bool isCollided = pairTest(*this, i_B, &o_contact);
+				if (o_info)
+				{
+					o_info->m_iterationCount = 0;
+					o_info->m_exit = isCollided ? sGJKQueryInfo::eExit::Intersecting : sGJKQueryInfo::eExit::Separated;
+				}
+				return isCollided;
+			}
+			if (areBoundingSpheresSeparated(i_B))
+			{
+				if (o_info)
+				{
+					o_info->m_iterationCount = 0;
+					o_info->m_exit = sGJKQueryInfo::eExit::Separated;
+				}
+				return false;
+			}
+			Simplex simplex;
+			if (!RunGJK(i_B, simplex, io_warmStart, o_info))
+			{
+				return false;
+			}
+			RunEPA(i_B, simplex, o_contact);
+			return true;
+		}
 
-				if (simplex.GetLast().dot(dir) < 0) {
-					return false;
+		bool Collider::Overlaps(Collider& i_B, sGJKWarmStart* io_warmStart, sGJKQueryInfo* o_info)
+		{
+			if (const fPairTest pairTest = GetPairTest(m_shape, i_B.m_shape))
+			{
+				const bool isCollided = pairTest(*this, i_B, nullptr);
+				if (o_info)
+				{
+					o_info->m_iterationCount = 0;
+					o_info->m_exit = isCollided ? sGJKQueryInfo::eExit::Intersecting : sGJKQueryInfo::eExit::Separated;
 				}
-				else {
-					if (simplex.ContainsOrigin(dir)) {
-						return true;
+				return isCollided;
+			}
+			if (areBoundingSpheresSeparated(i_B))
+			{
+				if (o_info)
+				{
+					o_info->m_iterationCount = 0;
+					o_info->m_exit = sGJKQueryInfo::eExit::Separated;
+				}
+				return false;
+			}
+			Simplex simplex;
+			return RunGJK(i_B, simplex, io_warmStart, o_info);
+		}
+
+		bool Collider::RunGJK(Collider& i_B, Simplex& o_simplex, sGJKWarmStart* io_warmStart, sGJKQueryInfo* o_info)
+		{
+			constexpr float toleranceSqr = PLUTOSHE_PHYSICS_GJK_TOLERANCE * PLUTOSHE_PHYSICS_GJK_TOLERANCE;
+			Vector3 dir = i_B.Center() - this->Center();
+			if (io_warmStart && io_warmStart->m_isValid && io_warmStart->m_direction.dot(io_warmStart->m_direction) > 0)
+			{
+				dir = io_warmStart->m_direction;
+			}
+			if (dir.dot(dir) <= 0)
+			{
+				// Concentric colliders, any direction works to start with
+				dir = Vector3(1, 0, 0);
+			}
+			o_simplex.Clear();
+			sSupportHint hint = io_warmStart ? io_warmStart->m_supportHint : sSupportHint();
+
+			int iterationCount = 0;
+			sGJKQueryInfo::eExit exitReason = sGJKQueryInfo::eExit::IterationCap;
+			bool isCollided = true;
+			// Squared size of the Minkowski difference seen so far, the degenerate direction test is relative to it
+			float extentSqr = 0;
+			while (iterationCount < PLUTOSHE_PHYSICS_GJK_MAX_ITERATIONS)
+			{
+				// The origin lies on the current simplex feature, so the hulls are touching.
+				// The direction comes out of cross products and grows with the simplex: its length is |a| for a point,
+				// |ab|^2 * distance for a segment and |ab x ac| for a triangle, so the limit is scaled to match
+				float limitSqr = toleranceSqr * extentSqr;
+				if (o_simplex.GetSize() == 2) limitSqr *= extentSqr * extentSqr;
+				else if (o_simplex.GetSize() == 3) limitSqr *= extentSqr;
+				if (dir.dot(dir) <= limitSqr)
+				{
+					exitReason = sGJKQueryInfo::eExit::DegenerateDirection;
+					break;
+				}
+
+				Vector3 supportA;
+				Vector3 support = supportFunction(*this, i_B, dir, supportA, hint);
+				iterationCount++;
+				extentSqr = std::max(extentSqr, support.dot(support));
+				if (support.dot(dir) < 0)
+				{
+					isCollided = false;
+					exitReason = sGJKQueryInfo::eExit::Separated;
+					break;
+				}
+				// A support point that is already in the simplex means the origin sits on the boundary
+				bool isDuplicate = false;
+				for (size_t i = 0; i < o_simplex.GetSize(); i++)
+				{
+					Vector3 offset = support - o_simplex.m_points[i];
+					if (offset.dot(offset) <= toleranceSqr)
+					{
+						isDuplicate = true;
 					}
 				}
+				if (isDuplicate)
+				{
+					exitReason = sGJKQueryInfo::eExit::NoProgress;
+					break;
+				}
+
+				o_simplex.Add(support, supportA);
+				if (o_simplex.ContainsOrigin(dir))
+				{
+					exitReason = sGJKQueryInfo::eExit::Intersecting;
+					break;
+				}
+			}
+
+			if (io_warmStart)
+			{
+				// Only a separating axis is worth reusing, for overlapping pairs the center to center direction
+				// converges faster than the last search direction
+				io_warmStart->m_direction = dir;
+				io_warmStart->m_isValid = !isCollided;
+				io_warmStart->m_supportHint = hint;
+			}
+			if (o_info)
+			{
+				o_info->m_iterationCount = iterationCount;
+				o_info->m_exit = exitReason;
 			}
+			return isCollided;
 		}
 
 		bool Simplex::ContainsOrigin(Vector3 &t_direction)
@@ -113,13 +448,13 @@ namespace PlutoShe
 				}
 				else if (ndac > 0)
 				{
-					this->m_points[1] = d;
+					this->Copy(1, 3);
 					this->RemoveD();
 					t_direction = normal_dac;
 				}
 				else if (ndbc > 0)
 				{
-					this->m_points[0] = d;
+					this->Copy(0, 3);
 					this->RemoveD();
 					t_direction = normal_dbc;
 				}
@@ -132,57 +467,63 @@ namespace PlutoShe
 			return false;
 		}
 
-		eae6320::cResult PlutoShe::Physics::Collider::InitData(std::string i_path)
-		{
-			auto result = eae6320::Results::Success;
-			std::string errorMessage;
-			eae6320::Platform::sDataFromFile dataFromFile;
+		PlutoShe::Physics::Collider::Collider() : Collider(s_nextColliderId++) {}
+		PlutoShe::Physics::Collider::Collider(uint64_t i_id) : m_worldSphereRadius(0), m_isAwake(true), m_isFast(false), m_isTrigger(false), m_shape(eShape::Hull), m_radius(0), m_halfHeight(0), m_id(i_id) { m_vertices.clear(); updateCachedBounds(); }
+		PlutoShe::Physics::Collider::Collider(std::vector<Vector3>& i_v) : m_worldSphereRadius(0), m_isAwake(true), m_isFast(false), m_isTrigger(false), m_shape(eShape::Hull), m_radius(0), m_halfHeight(0), m_id(s_nextColliderId++) { m_vertices = i_v; RefreshVertices(); }
+		PlutoShe::Physics::Collider::Collider(const Collider& i_v) : Collider(i_v.m_id == s_queryColliderId ? s_queryColliderId : s_nextColliderId++) { *this = i_v; }
+		PlutoShe::Physics::Collider::Collider(std::string i_path) : m_worldSphereRadius(0), m_isAwake(true), m_isFast(false), m_isTrigger(false), m_shape(eShape::Hull), m_radius(0), m_halfHeight(0), m_id(s_nextColliderId++) { InitData(i_path); }
 
-			auto resultReadBinaryFile = eae6320::Platform::LoadBinaryFile(i_path.c_str(), dataFromFile, &errorMessage);
-			if (!resultReadBinaryFile)
-			{
-				result = resultReadBinaryFile;
-				eae6320::Logging::OutputError("Couldn't read binary file at path %s", i_path.c_str());
-				return result;
-			}
-
-			auto currentOffset = reinterpret_cast<uintptr_t>(dataFromFile.data);
-			uint16_t vertexCount;
-			size_t sizeS = 0;
-			if (sizeS + sizeof(uint16_t) > dataFromFile.size)
+		Collider& PlutoShe::Physics::Collider::operator =(const Collider& i_v)
+		{
+			if (&i_v != this)
 			{
-				eae6320::Logging::OutputError("Wrong file size at path %s", i_path.c_str());
-				return result;
+				copyShape(i_v);
+				m_transformation = i_v.m_transformation;
+				m_worldCenter = i_v.m_worldCenter;
+				m_worldBounds = i_v.m_worldBounds;
+				m_worldSphereCenter = i_v.m_worldSphereCenter;
+				m_worldSphereRadius = i_v.m_worldSphereRadius;
+				m_isAwake = i_v.m_isAwake;
+				m_isFast = i_v.m_isFast;
+				m_isTrigger = i_v.m_isTrigger;
 			}
+			return *this;
+		}
 
-			memcpy(&vertexCount, reinterpret_cast<void*>(currentOffset), sizeof(uint16_t));
-			
-			currentOffset += sizeof(uint16_t);
-			sizeS += sizeof(uint16_t);
-			if (sizeS + vertexCount * sizeof(Vector3) > dataFromFile.size)
+		void PlutoShe::Physics::Collider::copyShape(const Collider& i_v)
+		{
+			m_shape = i_v.m_shape;
+			m_radius = i_v.m_radius;
+			m_halfHeight = i_v.m_halfHeight;
+			m_halfExtents = i_v.m_halfExtents;
+			m_vertices = i_v.m_vertices;
+			m_adjacencyOffsets = i_v.m_adjacencyOffsets;
+			m_adjacency = i_v.m_adjacency;
+			m_soaVertices = i_v.m_soaVertices;
+			// The precomputed values are copied as they are, only the pointers into the vectors have to move
+			m_hull = i_v.m_hull;
+			m_file = i_v.m_file;
+			if (!m_file)
 			{
-				eae6320::Logging::OutputError("Wrong file size at path %s", i_path.c_str());
-				return result;
+				pointHullAtVectors();
 			}
-
-			m_vertices.resize(vertexCount);
-			memcpy(&m_vertices[0], reinterpret_cast<void*>(currentOffset), vertexCount * sizeof(Vector3));
-			return result;
 		}
 
-		PlutoShe::Physics::Collider::Collider() { m_vertices.clear(); }
-		PlutoShe::Physics::Collider::Collider(std::vector<Vector3>& i_v) { m_vertices = i_v; }
-		PlutoShe::Physics::Collider::Collider(const Collider& i_v) { m_vertices = i_v.m_vertices; }
-		PlutoShe::Physics::Collider::Collider(std::string i_path) { InitData(i_path); }
-
 		void PlutoShe::Physics::Collider::UpdateTransformation(eae6320::Math::cMatrix_transformation i_t)
 		{
+			// Only an actual edit wakes the collider, so owners can keep pushing the transform of a sleeping body every frame
+			if (std::memcmp(&m_transformation, &i_t, sizeof(i_t)) != 0)
+			{
+				m_isAwake = true;
+			}
 			m_transformation = i_t;
+			updateCachedBounds();
 		}
 
 		PlutoShe::Physics::ColliderList::ColliderList() { m_colliders.clear(); }
 		PlutoShe::Physics::ColliderList::ColliderList(const Collider& i_c) { m_colliders.clear(); m_colliders.push_back(i_c); }
 		PlutoShe::Physics::ColliderList::ColliderList(const ColliderList& i_c) { m_colliders = i_c.m_colliders; }
+		PlutoShe::Physics::ColliderList::ColliderList(std::string i_path) { InitData(i_path); }
 
 
 		void PlutoShe::Physics::ColliderList::UpdateTransformation(eae6320::Math::cMatrix_transformation i_t)
@@ -215,6 +556,11 @@ namespace PlutoShe
 			return m_colliders[i_index]; 
 		}
 
+		Collider* PlutoShe::Physics::ColliderList::GetColliderPointerByIndex(int i_index)
+		{
+			return &m_colliders[i_index];
+		}
+
 		size_t PlutoShe::Physics::ColliderList::GetSize() { return m_colliders.size(); }
 
 		void PlutoShe::Physics::ColliderList::AddCollider(Collider i_c) { m_colliders.push_back(i_c); }
@@ -1,7 +1,12 @@
 #pragma once
 #include <vector>
+#include <cstdint>
+#include <cfloat>
+#include <memory>
 #include <Engine/Math/sVector.h>
 #include <Engine/Math/cMatrix_transformation.h>
+// Sqrt(), and the floating point settings of the deterministic mode (see Engine/Math/Configuration.h)
+#include <Engine/Math/Functions.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/Logging/Logging.h>
 #include <string>
@@ -42,6 +47,7 @@ namespace PlutoShe
 			{
 				return m_x * i_v.m_x + m_y * i_v.m_y + m_z * i_v.m_z;
 			}
+			float Get(int i_axis) const { return i_axis == 0 ? m_x : (i_axis == 1 ? m_y : m_z); }
 
 			friend Vector3 operator *(eae6320::Math::cMatrix_transformation &i_m, const Vector3 &i_rhs) 
 			{
@@ -50,46 +56,328 @@ namespace PlutoShe
 
 		};
 
+		// World-space axis aligned bounding box
+		struct AABB
+		{
+			Vector3 m_min, m_max;
+
+			bool Overlaps(const AABB& i_other) const
+			{
+				return (m_min.m_x <= i_other.m_max.m_x) & (m_max.m_x >= i_other.m_min.m_x)
+					& (m_min.m_y <= i_other.m_max.m_y) & (m_max.m_y >= i_other.m_min.m_y)
+					& (m_min.m_z <= i_other.m_max.m_z) & (m_max.m_z >= i_other.m_min.m_z);
+			}
+			bool Contains(const AABB& i_other) const
+			{
+				return (m_min.m_x <= i_other.m_min.m_x) & (m_max.m_x >= i_other.m_max.m_x)
+					& (m_min.m_y <= i_other.m_min.m_y) & (m_max.m_y >= i_other.m_max.m_y)
+					& (m_min.m_z <= i_other.m_min.m_z) & (m_max.m_z >= i_other.m_max.m_z);
+			}
+			// Half of the surface area, only used to compare the cost of tree nodes
+			float GetPerimeter() const
+			{
+				const float x = m_max.m_x - m_min.m_x, y = m_max.m_y - m_min.m_y, z = m_max.m_z - m_min.m_z;
+				return x * y + y * z + z * x;
+			}
+			AABB Fattened(float i_margin) const
+			{
+				AABB result;
+				result.m_min = Vector3(m_min.m_x - i_margin, m_min.m_y - i_margin, m_min.m_z - i_margin);
+				result.m_max = Vector3(m_max.m_x + i_margin, m_max.m_y + i_margin, m_max.m_z + i_margin);
+				return result;
+			}
+			static AABB Merge(const AABB& i_a, const AABB& i_b)
+			{
+				AABB result;
+				result.m_min = Vector3(i_a.m_min.m_x < i_b.m_min.m_x ? i_a.m_min.m_x : i_b.m_min.m_x,
+					i_a.m_min.m_y < i_b.m_min.m_y ? i_a.m_min.m_y : i_b.m_min.m_y,
+					i_a.m_min.m_z < i_b.m_min.m_z ? i_a.m_min.m_z : i_b.m_min.m_z);
+				result.m_max = Vector3(i_a.m_max.m_x > i_b.m_max.m_x ? i_a.m_max.m_x : i_b.m_max.m_x,
+					i_a.m_max.m_y > i_b.m_max.m_y ? i_a.m_max.m_y : i_b.m_max.m_y,
+					i_a.m_max.m_z > i_b.m_max.m_z ? i_a.m_max.m_z : i_b.m_max.m_z);
+				return result;
+			}
+		};
+
+		// Penetration of two overlapping colliders, the normal points from A to B
+		struct sContact
+		{
+			Vector3 m_normal;
+			float m_depth = 0;
+			// Deepest point of A inside B and of B inside A, in world space
+			Vector3 m_pointOnA;
+			Vector3 m_pointOnB;
+		};
+
+		struct sDistanceResult
+		{
+			// 0 when the colliders overlap
+			float m_distance = 0;
+			// Closest points in world space, the centers when the colliders overlap
+			Vector3 m_pointOnA;
+			Vector3 m_pointOnB;
+			bool m_isOverlapping = false;
+		};
+
+		struct sTimeOfImpactResult
+		{
+			// Fraction of the sweep, from 0 (the start) to 1 (the current poses)
+			float m_time = 1;
+			// Closest point on A and the normal from A to B at the time of impact, in world space
+			Vector3 m_point;
+			Vector3 m_normal;
+			// Distance queries made by the advancement
+			int m_iterationCount = 0;
+		};
+
+		// Hill climbing start vertices of a query, -1 starts from the first hull vertex.
+		// Every query owns its hints instead of the colliders remembering their last support vertex,
+		// so queries on the same collider can run on different threads and don't depend on each other's order
+		struct sSupportHint
+		{
+			int m_indexA = -1;
+			int m_indexB = -1;
+		};
+
+		// Separating axis GJK found for a pair of colliders.
+		// If the pair barely moved, the next query starting from it ends after one support call
+		struct sGJKWarmStart
+		{
+			Vector3 m_direction;
+			bool m_isValid = false;
+			// Support vertices of the last query, kept even when the direction isn't
+			sSupportHint m_supportHint;
+		};
+
+		// How a single GJK query ended, for telemetry
+		struct sGJKQueryInfo
+		{
+			enum class eExit
+			{
+				Separated,
+				Intersecting,
+				// The rest are degenerate exits, all of them report the pair as colliding
+				NoProgress,
+				DegenerateDirection,
+				IterationCap,
+			};
+
+			// Support calls made by the query
+			int m_iterationCount = 0;
+			eExit m_exit = eExit::Separated;
+
+			bool IsDegenerate() const { return m_exit != eExit::Separated && m_exit != eExit::Intersecting; }
+		};
+
+		// Outward face of a hull in local space, dot(m_normal, p) == m_distance on the face
+		struct sFacePlane
+		{
+			Vector3 m_normal;
+			float m_distance = 0;
+		};
+
+		class Simplex;
+
 		class Collider
 		{
 		public:
+			// Primitives have no vertices, their support points and the tests between them are computed from the shape
+			enum class eShape : uint8_t
+			{
+				Hull,
+				Sphere,
+				// Its segment runs along the local up axis
+				Capsule,
+				Box,
+
+				Count
+			};
+
 			Collider();
 			Collider(std::vector<Vector3>& i_v);
 			Collider(const Collider& i_v);
 			Collider(std::string i_path);
+			Collider& operator =(const Collider& i_v);
+			static Collider CreateSphere(float i_radius);
+			static Collider CreateCapsule(float i_radius, float i_halfHeight);
+			static Collider CreateBox(const Vector3& i_halfExtents);
 
 			eae6320::cResult InitData(std::string i_path);;
 			void UpdateTransformation(eae6320::Math::cMatrix_transformation i_t);
-			Vector3 Center();
+			// Rebuilds the SoA copy and the cached bounds, call it after editing m_vertices
+			void RefreshVertices();
+			// All three are cached by UpdateTransformation
+			Vector3 Center() const { return m_worldCenter; }
+			AABB GetAABB() const { return m_worldBounds; }
+			// Encloses the collider, pairs whose spheres don't touch are rejected before GJK
+			void GetBoundingSphere(Vector3& o_center, float& o_radius) const { o_center = m_worldSphereCenter; o_radius = m_worldSphereRadius; }
 			bool IsCollided(Collider& i_B);
+			// Same test, but when the colliders overlap EPA is run on the final GJK simplex to fill in the contact
+			bool IsCollided(Collider& i_B, sContact& o_contact, sGJKWarmStart* io_warmStart = nullptr, sGJKQueryInfo* o_info = nullptr);
+			// GJK only, for pairs that need to know whether they overlap but not how
+			bool Overlaps(Collider& i_B, sGJKWarmStart* io_warmStart = nullptr, sGJKQueryInfo* o_info = nullptr);
+			// Separation and closest points, returns false as soon as the colliders are known to be farther apart than i_maxDistance
+			bool Distance(Collider& i_B, sDistanceResult& o_result, float i_maxDistance = FLT_MAX);
+			// First time the colliders touch while each one moves by its translation and ends at its current pose.
+			// Conservative advancement on Distance(), so only translation is swept, rotation is taken from the current poses.
+			// A separation makes them touch that much earlier, as if A was inflated by it (e.g. a point swept as a sphere)
+			bool TimeOfImpact(Collider& i_B, Vector3 i_translationA, Vector3 i_translationB, sTimeOfImpactResult& o_result, float i_separation = 0);
+			const eae6320::Math::cMatrix_transformation& GetTransformation() const { return m_transformation; }
+			// CollisionWorld skips the narrowphase of pairs where both colliders are asleep,
+			// the owner mirrors its body's state here (e.g. eae6320::Physics::cRigidBodyWorld::IsBodyAwake())
+			void SetIsAwake(bool i_isAwake) { m_isAwake = i_isAwake; }
+			bool IsAwake() const { return m_isAwake; }
+			// Fast colliders are also swept by CollisionWorld so that they can't tunnel through thin colliders in one step
+			void SetIsFast(bool i_isFast) { m_isFast = i_isFast; }
+			bool IsFast() const { return m_isFast; }
+			// Triggers only report overlaps through CollisionWorld's events, their pairs get no contacts or manifolds
+			void SetIsTrigger(bool i_isTrigger) { m_isTrigger = i_isTrigger; }
+			bool IsTrigger() const { return m_isTrigger; }
+			// Given out in creation order, so unlike the address it is the same every run. The id belongs to the object and is never copied:
+			// a copy-constructed collider gets a new one and an assigned-to collider keeps its own. 64 bits can't run out
+			uint64_t GetId() const { return m_id; }
+			// Every collider that DynamicAABBTree builds for a query and its copies share this id, so queries don't use up ids.
+			// They are never added to a CollisionWorld
+			static constexpr uint64_t s_queryColliderId = UINT64_MAX;
+			eShape GetShape() const { return m_shape; }
+			// Sphere and capsule
+			float GetRadius() const { return m_radius; }
+			// Capsule, from the center to either end of the segment
+			float GetHalfHeight() const { return m_halfHeight; }
+			const Vector3& GetHalfExtents() const { return m_halfExtents; }
+			// Hull data the queries run on, in local space. Colliders loaded from a collider file read it from the file
+			size_t GetVertexCount() const { return m_hull.m_vertexCount; }
+			const Vector3* GetVertices() const { return m_hull.m_vertices; }
+			// Only collider files carry faces, hulls built from m_vertices have none
+			size_t GetFaceCount() const { return m_hull.m_faceCount; }
+			const sFacePlane* GetFacePlanes() const { return m_hull.m_facePlanes; }
+			const AABB& GetLocalBounds() const { return m_hull.m_localBounds; }
+			Vector3 GetLocalCenter() const { return m_hull.m_localCenter; }
+			void GetLocalBoundingSphere(Vector3& o_center, float& o_radius) const { o_center = m_hull.m_sphereCenter; o_radius = m_hull.m_sphereRadius; }
 			
+			// Editable hull, empty for colliders loaded from a collider file until it is filled and RefreshVertices() is called
 			std::vector<Vector3> m_vertices;
+			// Neighbors of vertex i on the convex hull are m_adjacency[m_adjacencyOffsets[i] .. m_adjacencyOffsets[i + 1]),
+			// both are empty when the collider file has no adjacency
+			std::vector<uint32_t> m_adjacencyOffsets;
+			std::vector<uint16_t> m_adjacency;
 		private:
-			static Vector3 supportFunction(Collider& i_A, Collider& i_B, Vector3 i_dir);
-			Vector3 getFarthestPointInDirection(Vector3 i_dir);
+			// An empty hull with the given id
+			explicit Collider(uint64_t i_id);
+			static Collider createQuerySphere(float i_radius);
+			static Collider createQueryBox(const Vector3& i_halfExtents);
+			void setSphere(float i_radius);
+			void setBox(const Vector3& i_halfExtents);
+
+			// Read-only view of the hull. It points either into the vectors above or into the loaded collider file,
+			// which is shared by every copy of the collider so copies don't duplicate or recompute anything
+			struct sHullView
+			{
+				const Vector3* m_vertices = nullptr;
+				size_t m_vertexCount = 0;
+				// Padded SoA copy of the vertices for the SIMD support kernels
+				const float* m_soaVertices = nullptr;
+				size_t m_paddedVertexCount = 0;
+				// Both null when there is no adjacency
+				const uint32_t* m_adjacencyOffsets = nullptr;
+				const uint16_t* m_adjacency = nullptr;
+				const sFacePlane* m_facePlanes = nullptr;
+				size_t m_faceCount = 0;
+				AABB m_localBounds;
+				Vector3 m_localCenter;
+				Vector3 m_sphereCenter;
+				float m_sphereRadius = 0;
+			};
+
+			// Specialized test for a pair of shapes, o_contact is null when only the overlap is needed
+			typedef bool(*fPairTest)(const Collider& i_A, const Collider& i_B, sContact* o_contact);
+			// nullptr when the pair has to go through GJK
+			static fPairTest GetPairTest(eShape i_shapeA, eShape i_shapeB);
+			bool areBoundingSpheresSeparated(const Collider& i_B) const;
+
+			static Vector3 supportFunction(Collider& i_A, Collider& i_B, Vector3 i_dir, sSupportHint& io_hint);
+			static Vector3 supportFunction(Collider& i_A, Collider& i_B, Vector3 i_dir, Vector3& o_supportA, sSupportHint& io_hint);
+			Vector3 getFarthestPointInDirection(Vector3 i_dir, int& io_hint);
+			Vector3 getPrimitiveSupport(Vector3 i_dir) const;
+			int getFarthestVertexIndex(Vector3& i_localDir, int& io_hint);
+			int climbToFarthestVertex(Vector3& i_localDir, int& io_hint);
+			void updateCachedBounds();
+			void updateBoundingSphere();
+			void updateSoaVertices();
+			// Points m_hull at the vectors again, e.g. after they were copied from another collider
+			void pointHullAtVectors();
+			void copyShape(const Collider& i_v);
+			// The file layout is described in ColliderFormat.h, the header has been checked by the caller
+			eae6320::cResult initFromCompactFile(std::shared_ptr<const eae6320::Platform::sDataFromFile> i_file, uint32_t i_hullIndex, const std::string& i_path);
+			eae6320::cResult initFromLegacyFile(const eae6320::Platform::sDataFromFile& i_file, const std::string& i_path);
+			// Bounded by PLUTOSHE_PHYSICS_GJK_MAX_ITERATIONS, see Configuration.h
+			bool RunGJK(Collider& i_B, Simplex& o_simplex, sGJKWarmStart* io_warmStart = nullptr, sGJKQueryInfo* o_info = nullptr);
+			bool RunEPA(Collider& i_B, Simplex& i_simplex, sContact& o_contact);
+			// Distance() with both colliders translated away from their current poses
+			bool RunDistance(Collider& i_B, Vector3 i_offsetA, Vector3 i_offsetB, sDistanceResult& o_result, float i_maxDistance);
 			eae6320::Math::cMatrix_transformation m_transformation;
+			// m_vertices as padded SoA arrays for the SIMD support kernels
+			std::vector<float> m_soaVertices;
+			sHullView m_hull;
+			// Set when m_hull points into a collider file
+			std::shared_ptr<const eae6320::Platform::sDataFromFile> m_file;
+			Vector3 m_worldCenter;
+			AABB m_worldBounds;
+			Vector3 m_worldSphereCenter;
+			float m_worldSphereRadius;
+			bool m_isAwake;
+			bool m_isFast;
+			bool m_isTrigger;
+			eShape m_shape;
+			float m_radius;
+			float m_halfHeight;
+			Vector3 m_halfExtents;
+			uint64_t m_id;
 
+			// Loads every hull of a collider file into its own collider
+			friend class ColliderList;
+			// Builds its query colliders with s_queryColliderId
+			friend class DynamicAABBTree;
 		};
 
+		// At most a tetrahedron, so the points live inline and GJK never touches the heap
 		class Simplex
 		{
 		public:
-			std::vector<Vector3> m_points;
+			static constexpr size_t s_capacity = 4;
 
-			Simplex() { m_points.clear(); }
-			size_t GetSize() { return m_points.size(); }
-			void Clear() { m_points.clear(); }
+			Vector3 m_points[s_capacity];
+			// Support point on collider A for every Minkowski point, EPA needs them to build contact points
+			Vector3 m_supportsA[s_capacity];
+
+			Simplex() : m_size(0) { }
+			size_t GetSize() { return m_size; }
+			void Clear() { m_size = 0; }
 			Vector3 GetA() { return m_points[0]; }
 			Vector3 GetB() { return m_points[1]; }
 			Vector3 GetC() { return m_points[2]; }
 			Vector3 GetD() { return m_points[3]; }
-			void RemoveA() { m_points.erase(m_points.begin()); }
-			void RemoveB() { m_points.erase(m_points.begin() + 1); }
-			void RemoveC() { m_points.erase(m_points.begin() + 2); }
-			void RemoveD() { m_points.erase(m_points.begin() + 3); }
-			void Add(Vector3 i_data) { m_points.push_back(i_data); }
-			Vector3 GetLast() { return m_points[m_points.size() - 1]; }
+			Vector3 GetSupportA(size_t i_index) { return m_supportsA[i_index]; }
+			void RemoveA() { Remove(0); }
+			void RemoveB() { Remove(1); }
+			void RemoveC() { Remove(2); }
+			void RemoveD() { Remove(3); }
+			void Remove(size_t i_index)
+			{
+				for (size_t i = i_index + 1; i < m_size; i++)
+				{
+					m_points[i - 1] = m_points[i];
+					m_supportsA[i - 1] = m_supportsA[i];
+				}
+				m_size--;
+			}
+			void Copy(size_t i_to, size_t i_from) { m_points[i_to] = m_points[i_from]; m_supportsA[i_to] = m_supportsA[i_from]; }
+			void Add(Vector3 i_data, Vector3 i_supportA) { m_points[m_size] = i_data; m_supportsA[m_size] = i_supportA; m_size++; }
+			Vector3 GetLast() { return m_points[m_size - 1]; }
 			bool ContainsOrigin(Vector3& i_d);
+
+		private:
+			size_t m_size;
 		};
 
 		class ColliderList
@@ -98,13 +386,20 @@ namespace PlutoShe
 			ColliderList();
 			ColliderList(const Collider& i_c);
 			ColliderList(const ColliderList& i_c);
+			// One collider per hull of the collider file, e.g. the convex decomposition of a concave mesh
+			ColliderList(std::string i_path);
+
+			eae6320::cResult InitData(std::string i_path);
 
 			void ClearAllCollider();
 			void AddCollider(Collider i_c);
 			size_t GetSize();
 			Collider GetColliderByIndex(int i_index);
+			Collider* GetColliderPointerByIndex(int i_index);
 			bool IsCollided(ColliderList& i_queryColliderList);
 			void UpdateTransformation(eae6320::Math::cMatrix_transformation i_t);
+			// Rebuilds the SoA copy and the cached bounds, call it after editing m_vertices
+			void RefreshVertices();
 		protected:
 			std::vector<Collider> m_colliders;
 		};
@@ -0,0 +1,469 @@
+// Primitives.cpp : Sphere, capsule and box colliders, analytic support points and the specialized pair tests picked by a dispatch table
+//
+
+#include "PhysicsSystem.h"
+#include <Engine/Asserts/Asserts.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	using PlutoShe::Physics::Collider;
+	using PlutoShe::Physics::Vector3;
+	using PlutoShe::Physics::sContact;
+
+	// An edge axis has to be this much shallower (in world units) than the best face axis to be picked,
+	// otherwise resting boxes flicker between the two because of round-off
+	constexpr float s_edgeAxisTolerance = 1.0e-4f;
+	// Cross products of nearly parallel edges are too short to be a reliable axis, the face axes cover those cases
+	constexpr float s_parallelEdgeTolerance = 1.0e-6f;
+	// Clipped points within this depth (in world units) of the deepest one all take part in a face contact,
+	// so a box resting flat gets the middle of its contact patch instead of whichever corner rounds deepest
+	constexpr float s_contactDepthTolerance = 1.0e-4f;
+	// A quad clipped by four planes has at most eight corners
+	constexpr int s_maxClippedPointCount = 8;
+
+	struct sWorldBox
+	{
+		Vector3 m_center;
+		Vector3 m_axes[3];
+		float m_extents[3];
+	};
+
+	sWorldBox GetWorldBox(const Collider& i_box)
+	{
+		const eae6320::Math::cMatrix_transformation& transformation = i_box.GetTransformation();
+		sWorldBox box;
+		box.m_center = transformation.GetTranslation();
+		box.m_axes[0] = transformation.GetRightDirection();
+		box.m_axes[1] = transformation.GetUpDirection();
+		box.m_axes[2] = transformation.GetBackDirection();
+		box.m_extents[0] = i_box.GetHalfExtents().m_x;
+		box.m_extents[1] = i_box.GetHalfExtents().m_y;
+		box.m_extents[2] = i_box.GetHalfExtents().m_z;
+		return box;
+	}
+
+
+	// Projection of the box on a unit axis, measured from its center
+	float GetBoxRadius(sWorldBox& i_box, Vector3 i_axis)
+	{
+		return i_box.m_extents[0] * std::abs(i_box.m_axes[0].dot(i_axis))
+			+ i_box.m_extents[1] * std::abs(i_box.m_axes[1].dot(i_axis))
+			+ i_box.m_extents[2] * std::abs(i_box.m_axes[2].dot(i_axis));
+	}
+
+	// Keeps the part of the polygon where dot(i_normal, p) <= i_offset
+	int ClipPolygon(const Vector3* i_points, int i_count, Vector3 i_normal, float i_offset, Vector3* o_points)
+	{
+		int count = 0;
+		for (int i = 0; i < i_count; i++)
+		{
+			Vector3 start = i_points[i];
+			Vector3 end = i_points[(i + 1) % i_count];
+			const float startDistance = i_normal.dot(start) - i_offset;
+			const float endDistance = i_normal.dot(end) - i_offset;
+			if (startDistance <= 0)
+			{
+				o_points[count++] = start;
+			}
+			if ((startDistance <= 0) != (endDistance <= 0))
+			{
+				o_points[count++] = start + (end - start) * (startDistance / (startDistance - endDistance));
+			}
+		}
+		return count;
+	}
+
+	// The contact of a face axis: the face of the incident box that faces the reference face most
+	// is clipped against the sides of the reference face, and the points below the reference face are kept.
+	// i_normal points from the reference box towards the incident box
+	bool GetFaceContact(sWorldBox& i_reference, int i_referenceFace, sWorldBox& i_incident, Vector3 i_normal, Vector3& o_pointOnReference, Vector3& o_pointOnIncident, float& o_depth)
+	{
+		int incidentFace = 0;
+		float bestAlignment = -1;
+		for (int i = 0; i < 3; i++)
+		{
+			const float alignment = std::abs(i_incident.m_axes[i].dot(i_normal));
+			if (alignment > bestAlignment)
+			{
+				bestAlignment = alignment;
+				incidentFace = i;
+			}
+		}
+		Vector3 incidentNormal = i_incident.m_axes[incidentFace].dot(i_normal) > 0 ? i_incident.m_axes[incidentFace].Negate() : i_incident.m_axes[incidentFace];
+		Vector3 incidentCenter = i_incident.m_center + incidentNormal * i_incident.m_extents[incidentFace];
+		const int incidentU = (incidentFace + 1) % 3;
+		const int incidentV = (incidentFace + 2) % 3;
+		Vector3 u = i_incident.m_axes[incidentU] * i_incident.m_extents[incidentU];
+		Vector3 v = i_incident.m_axes[incidentV] * i_incident.m_extents[incidentV];
+
+		Vector3 buffers[2][s_maxClippedPointCount];
+		buffers[0][0] = incidentCenter + u + v;
+		buffers[0][1] = incidentCenter - u + v;
+		buffers[0][2] = incidentCenter - u - v;
+		buffers[0][3] = incidentCenter + u - v;
+		int count = 4;
+		int current = 0;
+		for (int side = 1; side < 3 && count > 0; side++)
+		{
+			const int axisIndex = (i_referenceFace + side) % 3;
+			Vector3 axis = i_reference.m_axes[axisIndex];
+			const float centerDistance = axis.dot(i_reference.m_center);
+			count = ClipPolygon(buffers[current], count, axis, centerDistance + i_reference.m_extents[axisIndex], buffers[1 - current]);
+			current = 1 - current;
+			count = ClipPolygon(buffers[current], count, axis.Negate(), i_reference.m_extents[axisIndex] - centerDistance, buffers[1 - current]);
+			current = 1 - current;
+		}
+
+		const float faceOffset = i_normal.dot(i_reference.m_center) + i_reference.m_extents[i_referenceFace];
+		float maxDepth = -FLT_MAX;
+		for (int i = 0; i < count; i++)
+		{
+			maxDepth = std::max(maxDepth, faceOffset - i_normal.dot(buffers[current][i]));
+		}
+		if (maxDepth < 0)
+		{
+			return false;
+		}
+		Vector3 pointSum;
+		float depthSum = 0;
+		int pointCount = 0;
+		for (int i = 0; i < count; i++)
+		{
+			const float depth = faceOffset - i_normal.dot(buffers[current][i]);
+			if (depth >= maxDepth - s_contactDepthTolerance)
+			{
+				pointSum = pointSum + buffers[current][i];
+				depthSum += depth;
+				pointCount++;
+			}
+		}
+		o_pointOnIncident = pointSum / static_cast<float>(pointCount);
+		o_depth = depthSum / static_cast<float>(pointCount);
+		o_pointOnReference = o_pointOnIncident + i_normal * o_depth;
+		return true;
+	}
+
+	// The contact of an edge axis: the closest points between the edge of each box that is deepest along the axis
+	void GetEdgeContact(sWorldBox& i_boxA, int i_edgeA, sWorldBox& i_boxB, int i_edgeB, Vector3 i_normal, Vector3& o_pointOnA, Vector3& o_pointOnB)
+	{
+		Vector3 centerA = i_boxA.m_center;
+		Vector3 centerB = i_boxB.m_center;
+		for (int i = 0; i < 3; i++)
+		{
+			if (i != i_edgeA)
+			{
+				centerA = centerA + i_boxA.m_axes[i] * (i_boxA.m_axes[i].dot(i_normal) < 0 ? -i_boxA.m_extents[i] : i_boxA.m_extents[i]);
+			}
+			if (i != i_edgeB)
+			{
+				centerB = centerB + i_boxB.m_axes[i] * (i_boxB.m_axes[i].dot(i_normal) > 0 ? -i_boxB.m_extents[i] : i_boxB.m_extents[i]);
+			}
+		}
+		Vector3 directionA = i_boxA.m_axes[i_edgeA];
+		Vector3 directionB = i_boxB.m_axes[i_edgeB];
+		Vector3 offset = centerA - centerB;
+		// Both directions are unit length and not parallel, otherwise the axis would have been skipped
+		const float b = directionA.dot(directionB);
+		const float d = directionA.dot(offset);
+		const float e = directionB.dot(offset);
+		const float denominator = 1 - b * b;
+		float s = (b * e - d) / denominator;
+		float t = (e - b * d) / denominator;
+		s = std::min(std::max(s, -i_boxA.m_extents[i_edgeA]), i_boxA.m_extents[i_edgeA]);
+		t = std::min(std::max(t, -i_boxB.m_extents[i_edgeB]), i_boxB.m_extents[i_edgeB]);
+		o_pointOnA = centerA + directionA * s;
+		o_pointOnB = centerB + directionB * t;
+	}
+
+	void FlipContact(sContact& io_contact)
+	{
+		io_contact.m_normal = io_contact.m_normal.Negate();
+		const Vector3 pointOnA = io_contact.m_pointOnA;
+		io_contact.m_pointOnA = io_contact.m_pointOnB;
+		io_contact.m_pointOnB = pointOnA;
+	}
+
+	bool TestSphereSphere(const Collider& i_A, const Collider& i_B, sContact* o_contact)
+	{
+		Vector3 centerA = i_A.Center();
+		Vector3 centerB = i_B.Center();
+		Vector3 offset = centerB - centerA;
+		const float distanceSqr = offset.dot(offset);
+		const float radiusSum = i_A.GetRadius() + i_B.GetRadius();
+		if (distanceSqr > radiusSum * radiusSum)
+		{
+			return false;
+		}
+		if (o_contact)
+		{
+			const float distance = eae6320::Math::Sqrt(distanceSqr);
+			// Concentric spheres can be pushed apart in any direction
+			o_contact->m_normal = distance > 0 ? offset / distance : Vector3(1, 0, 0);
+			o_contact->m_depth = radiusSum - distance;
+			o_contact->m_pointOnA = centerA + o_contact->m_normal * i_A.GetRadius();
+			o_contact->m_pointOnB = centerB - o_contact->m_normal * i_B.GetRadius();
+		}
+		return true;
+	}
+
+	bool TestSphereBox(const Collider& i_A, const Collider& i_B, sContact* o_contact)
+	{
+		sWorldBox box = GetWorldBox(i_B);
+		Vector3 center = i_A.Center();
+		const float radius = i_A.GetRadius();
+		Vector3 offset = center - box.m_center;
+		// Closest point of the box to the center of the sphere, in the box's axes
+		float local[3];
+		float clamped[3];
+		bool isInside = true;
+		for (int i = 0; i < 3; i++)
+		{
+			local[i] = offset.dot(box.m_axes[i]);
+			clamped[i] = local[i] < -box.m_extents[i] ? -box.m_extents[i] : (local[i] > box.m_extents[i] ? box.m_extents[i] : local[i]);
+			isInside = isInside && clamped[i] == local[i];
+		}
+		Vector3 closest = box.m_center + box.m_axes[0] * clamped[0] + box.m_axes[1] * clamped[1] + box.m_axes[2] * clamped[2];
+		Vector3 toClosest = closest - center;
+		const float distanceSqr = toClosest.dot(toClosest);
+		if (!isInside && distanceSqr > radius * radius)
+		{
+			return false;
+		}
+		if (!o_contact)
+		{
+			return true;
+		}
+
+		if (!isInside)
+		{
+			const float distance = eae6320::Math::Sqrt(distanceSqr);
+			o_contact->m_normal = toClosest / distance;
+			o_contact->m_depth = radius - distance;
+			o_contact->m_pointOnA = center + o_contact->m_normal * radius;
+			o_contact->m_pointOnB = closest;
+			return true;
+		}
+		// The center is inside the box, so the sphere leaves through the nearest face
+		int face = 0;
+		float faceDistance = FLT_MAX;
+		for (int i = 0; i < 3; i++)
+		{
+			const float distance = box.m_extents[i] - std::abs(local[i]);
+			if (distance < faceDistance)
+			{
+				faceDistance = distance;
+				face = i;
+			}
+		}
+		Vector3 faceNormal = local[face] < 0 ? box.m_axes[face].Negate() : box.m_axes[face];
+		o_contact->m_normal = faceNormal.Negate();
+		o_contact->m_depth = radius + faceDistance;
+		o_contact->m_pointOnA = center - faceNormal * radius;
+		o_contact->m_pointOnB = center + faceNormal * faceDistance;
+		return true;
+	}
+
+	bool TestBoxSphere(const Collider& i_A, const Collider& i_B, sContact* o_contact)
+	{
+		if (!TestSphereBox(i_B, i_A, o_contact))
+		{
+			return false;
+		}
+		if (o_contact)
+		{
+			FlipContact(*o_contact);
+		}
+		return true;
+	}
+
+	// Separating axis test on the 3 + 3 face normals and the 9 edge cross products,
+	// the contact is along the axis with the smallest overlap
+	bool TestBoxBox(const Collider& i_A, const Collider& i_B, sContact* o_contact)
+	{
+		sWorldBox boxA = GetWorldBox(i_A);
+		sWorldBox boxB = GetWorldBox(i_B);
+		Vector3 offset = boxB.m_center - boxA.m_center;
+
+		float bestDepth = FLT_MAX;
+		Vector3 bestAxis;
+		// 0 - 2 are the faces of A, 3 - 5 the faces of B and 6 - 14 the edge pairs
+		int bestAxisIndex = 0;
+		for (int i = 0; i < 6; i++)
+		{
+			Vector3 axis = i < 3 ? boxA.m_axes[i] : boxB.m_axes[i - 3];
+			const float distance = offset.dot(axis);
+			const float depth = GetBoxRadius(boxA, axis) + GetBoxRadius(boxB, axis) - std::abs(distance);
+			if (depth < 0)
+			{
+				return false;
+			}
+			if (depth < bestDepth)
+			{
+				bestDepth = depth;
+				bestAxis = distance < 0 ? axis.Negate() : axis;
+				bestAxisIndex = i;
+			}
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				Vector3 axis = boxA.m_axes[i].cross(boxB.m_axes[j]);
+				const float lengthSqr = axis.dot(axis);
+				if (lengthSqr < s_parallelEdgeTolerance)
+				{
+					continue;
+				}
+				axis = axis / eae6320::Math::Sqrt(lengthSqr);
+				const float distance = offset.dot(axis);
+				const float depth = GetBoxRadius(boxA, axis) + GetBoxRadius(boxB, axis) - std::abs(distance);
+				if (depth < 0)
+				{
+					return false;
+				}
+				if (depth + s_edgeAxisTolerance < bestDepth)
+				{
+					bestDepth = depth;
+					bestAxis = distance < 0 ? axis.Negate() : axis;
+					bestAxisIndex = 6 + i * 3 + j;
+				}
+			}
+		}
+
+		if (!o_contact)
+		{
+			return true;
+		}
+
+		o_contact->m_normal = bestAxis;
+		o_contact->m_depth = bestDepth;
+		if (bestAxisIndex < 3)
+		{
+			if (!GetFaceContact(boxA, bestAxisIndex, boxB, bestAxis, o_contact->m_pointOnA, o_contact->m_pointOnB, o_contact->m_depth))
+			{
+				return false;
+			}
+		}
+		else if (bestAxisIndex < 6)
+		{
+			if (!GetFaceContact(boxB, bestAxisIndex - 3, boxA, bestAxis.Negate(), o_contact->m_pointOnB, o_contact->m_pointOnA, o_contact->m_depth))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			GetEdgeContact(boxA, (bestAxisIndex - 6) / 3, boxB, (bestAxisIndex - 6) % 3, bestAxis, o_contact->m_pointOnA, o_contact->m_pointOnB);
+		}
+#ifdef EAE6320_ASSERTS_AREENABLED
+		{
+			// The points are on the touching features, separated by the penetration along the normal.
+			// Deep edge pairs whose closest points are clamped to the end of an edge drift a little from it
+			Vector3 error = o_contact->m_pointOnA - o_contact->m_pointOnB - o_contact->m_normal * o_contact->m_depth;
+			const float tolerance = s_contactDepthTolerance + o_contact->m_depth * 0.01f;
+			EAE6320_ASSERT(error.dot(error) <= tolerance * tolerance);
+		}
+#endif
+		return true;
+	}
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		Collider Collider::CreateSphere(float i_radius)
+		{
+			Collider sphere;
+			sphere.setSphere(i_radius);
+			return sphere;
+		}
+
+		Collider Collider::CreateCapsule(float i_radius, float i_halfHeight)
+		{
+			Collider capsule;
+			capsule.m_shape = eShape::Capsule;
+			capsule.m_radius = i_radius;
+			capsule.m_halfHeight = i_halfHeight;
+			capsule.updateCachedBounds();
+			return capsule;
+		}
+
+		Collider Collider::CreateBox(const Vector3& i_halfExtents)
+		{
+			Collider box;
+			box.setBox(i_halfExtents);
+			return box;
+		}
+
+		Collider Collider::createQuerySphere(float i_radius)
+		{
+			Collider sphere(s_queryColliderId);
+			sphere.setSphere(i_radius);
+			return sphere;
+		}
+
+		Collider Collider::createQueryBox(const Vector3& i_halfExtents)
+		{
+			Collider box(s_queryColliderId);
+			box.setBox(i_halfExtents);
+			return box;
+		}
+
+		void Collider::setSphere(float i_radius)
+		{
+			m_shape = eShape::Sphere;
+			m_radius = i_radius;
+			updateCachedBounds();
+		}
+
+		void Collider::setBox(const Vector3& i_halfExtents)
+		{
+			m_shape = eShape::Box;
+			m_halfExtents = i_halfExtents;
+			updateCachedBounds();
+		}
+
+		Vector3 Collider::getPrimitiveSupport(Vector3 i_dir) const
+		{
+			Vector3 center = m_transformation.GetTranslation();
+			if (m_shape == eShape::Box)
+			{
+				Vector3 localDir(Vector3(m_transformation.GetRightDirection()).dot(i_dir),
+					Vector3(m_transformation.GetUpDirection()).dot(i_dir),
+					Vector3(m_transformation.GetBackDirection()).dot(i_dir));
+				const Vector3 corner(localDir.m_x < 0 ? -m_halfExtents.m_x : m_halfExtents.m_x,
+					localDir.m_y < 0 ? -m_halfExtents.m_y : m_halfExtents.m_y,
+					localDir.m_z < 0 ? -m_halfExtents.m_z : m_halfExtents.m_z);
+				eae6320::Math::cMatrix_transformation transformation = m_transformation;
+				return transformation * corner;
+			}
+
+			const float length = eae6320::Math::Sqrt(i_dir.dot(i_dir));
+			Vector3 support = length > 0 ? center + i_dir * (m_radius / length) : center;
+			if (m_shape == eShape::Capsule)
+			{
+				// The end of the segment that is farther along the direction
+				Vector3 up = m_transformation.GetUpDirection();
+				support = support + up * (up.dot(i_dir) < 0 ? -m_halfHeight : m_halfHeight);
+			}
+			return support;
+		}
+
+		Collider::fPairTest Collider::GetPairTest(eShape i_shapeA, eShape i_shapeB)
+		{
+			// Pairs without an entry (hulls and capsules) use GJK on the support points
+			static const fPairTest s_pairTests[static_cast<int>(eShape::Count)][static_cast<int>(eShape::Count)] =
+			{
+				// Hull		Sphere				Capsule		Box
+				{ nullptr,	nullptr,			nullptr,	nullptr },			// Hull
+				{ nullptr,	TestSphereSphere,	nullptr,	TestSphereBox },	// Sphere
+				{ nullptr,	nullptr,			nullptr,	nullptr },			// Capsule
+				{ nullptr,	TestBoxSphere,		nullptr,	TestBoxBox },		// Box
+			};
+			return s_pairTests[static_cast<int>(i_shapeA)][static_cast<int>(i_shapeB)];
+		}
+	}
+}
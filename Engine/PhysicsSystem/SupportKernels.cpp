@@ -0,0 +1,167 @@
+// SupportKernels.cpp : Vectorized farthest point search, the AVX2 or SSE2 path is picked at runtime
+//
+
+#include "SupportKernels.h"
+// GCC fuses the multiplies and adds of intrinsics too, the deterministic mode turns that off
+#include <Engine/Math/Configuration.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PLUTOSHE_SUPPORT_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC lets every intrinsic through regardless of /arch, GCC and Clang need the target enabled per function
+#if defined(PLUTOSHE_SUPPORT_KERNELS_X86) && !defined(_MSC_VER)
+#define PLUTOSHE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PLUTOSHE_TARGET_AVX2
+#endif
+
+namespace
+{
+	// The lowest index among the lanes holding the maximum, so every path breaks ties the same way
+	int ReduceLanes(const float* i_values, const int* i_indices, int i_laneCount)
+	{
+		int best = 0;
+		for (int lane = 1; lane < i_laneCount; lane++)
+		{
+			if (i_values[lane] > i_values[best] || (i_values[lane] == i_values[best] && i_indices[lane] < i_indices[best]))
+			{
+				best = lane;
+			}
+		}
+		return i_indices[best];
+	}
+
+#if defined(PLUTOSHE_SUPPORT_KERNELS_X86)
+	bool IsAvx2Supported()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+		{
+			return false;
+		}
+		__cpuid(info, 1);
+		const bool osUsesXSave = (info[2] & (1 << 27)) != 0;
+		const bool hasAvx = (info[2] & (1 << 28)) != 0;
+		// The OS also has to save the YMM registers on context switches
+		if (!osUsesXSave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6)
+		{
+			return false;
+		}
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}
+#endif
+}
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		int SupportKernels::FindMaxDot_scalar(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz)
+		{
+			int selection = 0;
+			float maxDist = i_x[0] * i_dx + i_y[0] * i_dy + i_z[0] * i_dz;
+			for (size_t i = 1; i < i_paddedCount; i++)
+			{
+				const float dist = i_x[i] * i_dx + i_y[i] * i_dy + i_z[i] * i_dz;
+				if (dist > maxDist)
+				{
+					maxDist = dist;
+					selection = static_cast<int>(i);
+				}
+			}
+			return selection;
+		}
+
+#if defined(PLUTOSHE_SUPPORT_KERNELS_X86)
+		int SupportKernels::FindMaxDot_sse2(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz)
+		{
+			const __m128 dx = _mm_set1_ps(i_dx);
+			const __m128 dy = _mm_set1_ps(i_dy);
+			const __m128 dz = _mm_set1_ps(i_dz);
+			const __m128i step = _mm_set1_epi32(4);
+			__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+			__m128 maxDist = _mm_set1_ps(-3.402823466e+38f);
+			__m128i maxIndex = _mm_setzero_si128();
+			for (size_t i = 0; i < i_paddedCount; i += 4)
+			{
+				const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(i_x + i), dx), _mm_mul_ps(_mm_loadu_ps(i_y + i), dy)), _mm_mul_ps(_mm_loadu_ps(i_z + i), dz));
+				// SSE2 has no blend, so select with and/andnot/or
+				const __m128 isGreater = _mm_cmpgt_ps(dist, maxDist);
+				const __m128i isGreaterInt = _mm_castps_si128(isGreater);
+				maxDist = _mm_or_ps(_mm_and_ps(isGreater, dist), _mm_andnot_ps(isGreater, maxDist));
+				maxIndex = _mm_or_si128(_mm_and_si128(isGreaterInt, index), _mm_andnot_si128(isGreaterInt, maxIndex));
+				index = _mm_add_epi32(index, step);
+			}
+			float values[4];
+			int indices[4];
+			_mm_storeu_ps(values, maxDist);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), maxIndex);
+			return ReduceLanes(values, indices, 4);
+		}
+
+		PLUTOSHE_TARGET_AVX2 int SupportKernels::FindMaxDot_avx2(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz)
+		{
+			const __m256 dx = _mm256_set1_ps(i_dx);
+			const __m256 dy = _mm256_set1_ps(i_dy);
+			const __m256 dz = _mm256_set1_ps(i_dz);
+			const __m256i step = _mm256_set1_epi32(8);
+			__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+			__m256 maxDist = _mm256_set1_ps(-3.402823466e+38f);
+			__m256i maxIndex = _mm256_setzero_si256();
+			for (size_t i = 0; i < i_paddedCount; i += 8)
+			{
+				// No FMA here so the result matches the SSE2 and scalar paths bit for bit
+				const __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(i_x + i), dx), _mm256_mul_ps(_mm256_loadu_ps(i_y + i), dy)), _mm256_mul_ps(_mm256_loadu_ps(i_z + i), dz));
+				const __m256 isGreater = _mm256_cmp_ps(dist, maxDist, _CMP_GT_OQ);
+				maxDist = _mm256_blendv_ps(maxDist, dist, isGreater);
+				maxIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(maxIndex), _mm256_castsi256_ps(index), isGreater));
+				index = _mm256_add_epi32(index, step);
+			}
+			float values[8];
+			int indices[8];
+			_mm256_storeu_ps(values, maxDist);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(indices), maxIndex);
+			return ReduceLanes(values, indices, 8);
+		}
+#else
+		int SupportKernels::FindMaxDot_sse2(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz)
+		{
+			return FindMaxDot_scalar(i_x, i_y, i_z, i_paddedCount, i_dx, i_dy, i_dz);
+		}
+
+		int SupportKernels::FindMaxDot_avx2(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz)
+		{
+			return FindMaxDot_scalar(i_x, i_y, i_z, i_paddedCount, i_dx, i_dy, i_dz);
+		}
+#endif
+
+		SupportKernels::FindMaxDotFunction SupportKernels::GetFindMaxDot()
+		{
+#if defined(PLUTOSHE_SUPPORT_KERNELS_X86)
+			// Every x86-64 CPU (and every CPU the Win32 build targets) has SSE2, AVX2 has to be checked
+			static const FindMaxDotFunction s_function = IsAvx2Supported() ? &FindMaxDot_avx2 : &FindMaxDot_sse2;
+#else
+			static const FindMaxDotFunction s_function = &FindMaxDot_scalar;
+#endif
+			return s_function;
+		}
+
+		const char* SupportKernels::GetKernelName()
+		{
+			const FindMaxDotFunction function = GetFindMaxDot();
+			return function == &FindMaxDot_avx2 ? "AVX2" : (function == &FindMaxDot_sse2 ? "SSE2" : "Scalar");
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		// Max-dot kernels over SoA vertex arrays (all x, then all y, then all z).
+		// The arrays are padded to s_soaPadding floats so the vector paths never need a scalar tail;
+		// padding has to repeat a real vertex so it can't win with a bogus value.
+		namespace SupportKernels
+		{
+			constexpr size_t s_soaPadding = 8;
+
+			inline size_t GetPaddedCount(size_t i_count) { return (i_count + s_soaPadding - 1) / s_soaPadding * s_soaPadding; }
+
+			// Index of the point with the largest dot product with (i_dx, i_dy, i_dz),
+			// i_paddedCount must be a non-zero multiple of s_soaPadding
+			typedef int(*FindMaxDotFunction)(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz);
+
+			int FindMaxDot_scalar(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz);
+			int FindMaxDot_sse2(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz);
+			int FindMaxDot_avx2(const float* i_x, const float* i_y, const float* i_z, size_t i_paddedCount, float i_dx, float i_dy, float i_dz);
+
+			// The widest kernel the CPU supports, detected once
+			FindMaxDotFunction GetFindMaxDot();
+			const char* GetKernelName();
+		}
+	}
+}
@@ -0,0 +1,50 @@
+// TimeOfImpact.cpp : Conservative advancement, steps the sweep forward by the distance over the closing speed until the colliders touch
+//
+
+#include "PhysicsSystem.h"
+#include "Configuration.h"
+
+namespace PlutoShe
+{
+	namespace Physics
+	{
+		bool Collider::TimeOfImpact(Collider& i_B, Vector3 i_translationA, Vector3 i_translationB, sTimeOfImpactResult& o_result, float i_separation)
+		{
+			o_result = sTimeOfImpactResult();
+			Vector3 relativeTranslation = i_translationA - i_translationB;
+			// Kept from the last separated query, the final one can land exactly on the contact where the direction is lost
+			Vector3 normal;
+			float time = 0;
+			for (int iteration = 0; iteration < PLUTOSHE_PHYSICS_CCD_MAX_ITERATIONS; iteration++)
+			{
+				o_result.m_iterationCount++;
+				// The sweep ends at the current poses, so at time t both colliders are (1 - t) of their translations behind
+				sDistanceResult distance;
+				RunDistance(i_B, i_translationA * (time - 1), i_translationB * (time - 1), distance, FLT_MAX);
+				const float gap = distance.m_distance - i_separation;
+				if (distance.m_isOverlapping || gap <= PLUTOSHE_PHYSICS_CCD_TOLERANCE)
+				{
+					o_result.m_time = time;
+					o_result.m_point = distance.m_pointOnA;
+					o_result.m_normal = distance.m_distance > 0 ? (distance.m_pointOnB - distance.m_pointOnA) / distance.m_distance : normal;
+					return true;
+				}
+
+				normal = (distance.m_pointOnB - distance.m_pointOnA) / distance.m_distance;
+				// No point of A can close the gap faster than the relative motion along the normal,
+				// so advancing by the distance over that speed never steps past the impact
+				const float closingSpeed = relativeTranslation.dot(normal);
+				if (closingSpeed <= 0)
+				{
+					return false;
+				}
+				time += gap / closingSpeed;
+				if (time > 1)
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+	}
+}
@@ -27,6 +27,7 @@ return
 		{ path = "Inputs/defaultInput.input" }
 	},
 	colliders = {
-		{ path = "Colliders/BoxCollider.col" }
+		{ path = "Colliders/BoxCollider.col" },
+		{ path = "Colliders/OctopusCollider.col" },
 	}
 }
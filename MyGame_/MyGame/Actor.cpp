@@ -40,6 +40,8 @@ namespace eae6320 {
 		this->m_effect = other.m_effect;
 		this->m_geometry = other.m_geometry;
 		this->m_rigidbody = other.m_rigidbody;
+		// The transform still belongs to the old body
+		this->m_isTransformAtRest = false;
 	}
 
 }
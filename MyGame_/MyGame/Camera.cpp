@@ -2,7 +2,35 @@
 namespace eae6320 {
 	void Camera::UpdateMatrices()
 	{
-		m_transform_worldToCamera = Math::cMatrix_transformation::CreateWorldToCameraTransform(m_transform_localToWorld);
-		m_transform_cameraToProjected = Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(m_verticalFoV, m_asp, m_zNearPlane, m_zFarPlane);
+		// The view only changes when the camera moved
+		if (m_hasTransformChanged)
+		{
+			m_transform_worldToCamera = Math::cMatrix_transformation::CreateWorldToCameraTransform(m_transform_localToWorld);
+			m_hasTransformChanged = false;
+		}
+		if (m_isProjectionDirty)
+		{
+			m_transform_cameraToProjected = Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective(m_verticalFoV, m_asp, m_zNearPlane, m_zFarPlane);
+			m_isProjectionDirty = false;
+		}
+	}
+
+	void Camera::SetVerticalFieldOfView(const float i_verticalFieldOfView_inRadians)
+	{
+		m_verticalFoV = i_verticalFieldOfView_inRadians;
+		m_isProjectionDirty = true;
+	}
+
+	void Camera::SetAspectRatio(const float i_aspectRatio)
+	{
+		m_asp = i_aspectRatio;
+		m_isProjectionDirty = true;
+	}
+
+	void Camera::SetClipPlanes(const float i_z_nearPlane, const float i_z_farPlane)
+	{
+		m_zNearPlane = i_z_nearPlane;
+		m_zFarPlane = i_z_farPlane;
+		m_isProjectionDirty = true;
 	}
 }
@@ -11,7 +11,7 @@ namespace eae6320 {
 		Camera(const float i_verticalFieldOfView_inRadians,
 			const float i_aspectRatio,
 			const float i_z_nearPlane, const float i_z_farPlane) :
-			m_verticalFoV(i_verticalFieldOfView_inRadians), m_asp(i_aspectRatio), m_zNearPlane(i_z_nearPlane), m_zFarPlane(m_zFarPlane) {
+			m_verticalFoV(i_verticalFieldOfView_inRadians), m_asp(i_aspectRatio), m_zNearPlane(i_z_nearPlane), m_zFarPlane(i_z_farPlane) {
 			UpdateMatrices();
 		};
 		// constructor with transformation information
@@ -24,8 +24,13 @@ namespace eae6320 {
 			UpdateMatrices();
 		};
 		~Camera() { };
+		// Only rebuilds the matrices whose inputs changed since the last call
 		void UpdateMatrices();
 
+		void SetVerticalFieldOfView(const float i_verticalFieldOfView_inRadians);
+		void SetAspectRatio(const float i_aspectRatio);
+		void SetClipPlanes(const float i_z_nearPlane, const float i_z_farPlane);
+
 		Math::cMatrix_transformation GetWorldToCameraMatrix() const { return m_transform_worldToCamera; }
 		Math::cMatrix_transformation GetCameraToProjectedMatrix() const { return m_transform_cameraToProjected; }
 
@@ -37,5 +42,7 @@ namespace eae6320 {
 		float m_asp;
 		float m_zNearPlane;
 		float m_zFarPlane;
+		// Set by the setters above, the projection doesn't depend on where the camera is
+		bool m_isProjectionDirty = true;
 	};
 }
@@ -41,7 +41,15 @@ namespace eae6320 {
 
 	void Object::PredictTransformation(const float i_secondCountToExtrapolate)
 	{
+		// A body that isn't moving or spinning is predicted where it already is, so its quaternion isn't turned into a matrix again
+		const bool isAtRest = (m_rigidbody.velocity == Math::sVector()) & (m_rigidbody.acceleration == Math::sVector()) & (m_rigidbody.angularSpeed == 0.0f);
+		if (isAtRest && m_isTransformAtRest)
+		{
+			return;
+		}
 		m_transform_localToWorld = m_rigidbody.PredictFutureTransform(i_secondCountToExtrapolate);
+		m_hasTransformChanged = true;
+		m_isTransformAtRest = isAtRest;
 	}
 
 	void Object::SetInitialTransform(Math::sVector i_initialLocation, Math::cQuaternion i_initialQuaternion)
@@ -49,6 +57,8 @@ namespace eae6320 {
 		m_rigidbody.position = i_initialLocation;
 		m_rigidbody.orientation = i_initialQuaternion;
 		m_transform_localToWorld = Math::cMatrix_transformation(i_initialQuaternion, i_initialLocation);
+		m_hasTransformChanged = true;
+		m_isTransformAtRest = false;
 	}
 
 }
@@ -25,6 +25,10 @@ namespace eae6320 {
 		Math::cMatrix_transformation m_transform_localToWorld;
 		Physics::sRigidBodyState m_rigidbody;
 		bool m_addingForce;
+		// Set whenever m_transform_localToWorld is rebuilt, whoever caches something derived from it (e.g. Camera) clears it
+		bool m_hasTransformChanged = true;
+		// The transform was predicted from a body at rest, so predicting it again would give the same one
+		bool m_isTransformAtRest = false;
 		PlutoShe::Physics::Collider m_BoxCollider;
 	};
 }
@@ -9,6 +9,8 @@
 #include "Engine/Graphics/cGeometry.h"
 #include "Engine/Graphics/cEffect.h"
 #include "Engine/AdvancedUserInput/AdvancedUserInput.h"
+#include "Engine/Math/cFrustum.h"
+#include "Engine/Math/sSphere.h"
 #include "Actor.h"
 #include "Gameplay/PlayerActor.h"
 #include "Camera.h"
@@ -280,16 +282,38 @@ void eae6320::cMyGame::InitializeActorWithGraphicAndTransformationInfo(Actor* o_
 void eae6320::cMyGame::SubmitDataToBeRendered(const float i_elapsedSecondCount_systemTime, const float i_elapsedSecondCount_sinceLastSimulationUpdate)
 {
 	eae6320::Graphics::SubmitBackColorDataFromApplicationThread(m_backColor[0], m_backColor[1], m_backColor[2], m_backColor[3]);
-	// Submit rendering list (list of pair<Geometry, Effect>)
-	eae6320::Graphics::UpdateGeometriesFromApplicationThread(m_renderList);
-	// Submit camera matrices after updating it
-	eae6320::Graphics::SubmitFrameRequiredMatrices(m_mainCamera->GetWorldToCameraMatrix(), m_mainCamera->GetCameraToProjectedMatrix());
+	const auto worldToCamera = m_mainCamera->GetWorldToCameraMatrix();
+	const auto cameraToProjected = m_mainCamera->GetCameraToProjectedMatrix();
+	// Actors outside of the camera's view aren't submitted at all:
+	// Their bounding spheres are moved to world space and culled against the frustum in one batch
+	const auto actorCount = m_actorList.size();
+	std::vector<eae6320::Math::sSphere> boundingSpheres(actorCount);
+	for (size_t i = 0; i < actorCount; i++)
+	{
+		const auto localToWorld = m_actorList[i]->GetLocalToWorldMatrix();
+		const auto* const geometry = m_renderList[i].first;
+		// Actors only rotate and translate, so the radius doesn't change
+		boundingSpheres[i] = geometry
+			? eae6320::Math::sSphere(localToWorld * geometry->GetBoundingSphere().center, geometry->GetBoundingSphere().radius)
+			: eae6320::Math::sSphere(localToWorld * eae6320::Math::sVector(), 0.0f);
+	}
+	std::vector<uint32_t> visibilityBits(eae6320::Math::cFrustum::GetVisibilityWordCount(actorCount));
+	eae6320::Math::cFrustum(cameraToProjected * worldToCamera).CullSpheres(boundingSpheres.data(), actorCount, visibilityBits.data());
 	// Transfer the data in my actor to a format that graphic engine will accept
+	std::vector<std::pair<Graphics::cGeometry*, Graphics::cEffect*>> visibleRenderList;
 	std::vector<eae6320::Math::cMatrix_transformation> drawcallMatrices;
-	for (auto it = m_actorList.begin(); it != m_actorList.end(); ++it)
+	for (size_t i = 0; i < actorCount; i++)
 	{
-		drawcallMatrices.push_back((*it)->GetLocalToWorldMatrix());
+		if (eae6320::Math::cFrustum::IsVisible(visibilityBits.data(), i))
+		{
+			visibleRenderList.push_back(m_renderList[i]);
+			drawcallMatrices.push_back(m_actorList[i]->GetLocalToWorldMatrix());
+		}
 	}
+	// Submit rendering list (list of pair<Geometry, Effect>)
+	eae6320::Graphics::UpdateGeometriesFromApplicationThread(visibleRenderList);
+	// Submit camera matrices after updating it
+	eae6320::Graphics::SubmitFrameRequiredMatrices(worldToCamera, cameraToProjected);
 	// Submit matrices that graphic requires to render object
 	eae6320::Graphics::SubmitDrawCallRequiredMatrices(drawcallMatrices);
 }
@@ -239,7 +239,8 @@ function cbAssetTypeInfo.RegisterReferencedAssets( i_sourceRelativePath )
 end
 
 -- You may need to override the following function for some new asset types, but not for many
-function cbAssetTypeInfo.ShouldTargetBeBuilt( i_lastWriteTime_builtAsset )
+-- (i_path_source is the absolute path of the source asset, for types whose source refers to other files)
+function cbAssetTypeInfo.ShouldTargetBeBuilt( i_lastWriteTime_builtAsset, i_path_source )
 	-- By default this returns false,
 	-- because there are no special dependencies for this asset type
 	-- that need to be taken into account
@@ -336,6 +337,21 @@ NewAssetTypeInfo( "colliders",
 		end,
 		GetBuilderRelativePath = function()
 			return "ColliderBuilder.exe"
+		end,
+		ShouldTargetBeBuilt = function( i_lastWriteTime_builtAsset, i_path_source )
+			-- A collider decomposed from a mesh has to be built again when the mesh changes
+			local collider = dofile( i_path_source )
+			local path_mesh = collider["mesh"]
+			if path_mesh then
+				-- The mesh path is relative to the collider file, like the builder resolves it
+				path_mesh = i_path_source:match( "(.-)[^/\\]+$" ) .. path_mesh
+				if not DoesFileExist( path_mesh ) then
+					-- Let the builder report the missing mesh
+					return true
+				end
+				return GetLastWriteTime( path_mesh ) > i_lastWriteTime_builtAsset
+			end
+			return false
 		end
 	}
 )
@@ -410,7 +426,7 @@ local function BuildAsset( i_assetInfo )
 					if not shouldTargetBeBuilt then
 						-- Even if there is no reason that a general asset shouldn't be built
 						-- the specific asset type may have specialized dependencies
-						shouldTargetBeBuilt = assetTypeInfo.ShouldTargetBeBuilt( lastWriteTime_target )
+						shouldTargetBeBuilt = assetTypeInfo.ShouldTargetBeBuilt( lastWriteTime_target, path_source )
 					end
 				end
 			end
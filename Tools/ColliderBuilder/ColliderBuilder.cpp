@@ -1,11 +1,221 @@
 #include "ColliderBuilder.h"
+#include "ConvexHull.h"
 
 #include <Engine/Graphics/cEffect.h>
 #include <Tools/AssetBuildLibrary/Functions.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <External/Lua/Includes.h>
+#include <Engine/PhysicsSystem/ColliderFormat.h>
+#include <Engine/PhysicsSystem/SupportKernels.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+
+namespace
+{
+	using PlutoShe::Physics::Vector3;
+
+	float GetEnclosingRadius(const std::vector<Vector3>& i_points, Vector3 i_center)
+	{
+		float radiusSqr = 0;
+		for (size_t i = 0; i < i_points.size(); i++)
+		{
+			Vector3 offset = Vector3(i_points[i]) - i_center;
+			radiusSqr = std::max(radiusSqr, offset.dot(offset));
+		}
+		return std::sqrt(radiusSqr);
+	}
+
+	// Ritter's bounding sphere: starts from the two points farthest apart along the widest axis
+	// and grows to take in every point that is left out. Boxy hulls do better around their center,
+	// so the smaller of the two is kept
+	void ComputeBoundingSphere(const std::vector<Vector3>& i_points, Vector3 i_center, Vector3& o_center, float& o_radius)
+	{
+		o_center = i_center;
+		o_radius = GetEnclosingRadius(i_points, i_center);
+		if (i_points.empty())
+		{
+			return;
+		}
+		size_t minIndex[3] = { 0, 0, 0 };
+		size_t maxIndex[3] = { 0, 0, 0 };
+		for (size_t i = 1; i < i_points.size(); i++)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (i_points[i].Get(axis) < i_points[minIndex[axis]].Get(axis)) minIndex[axis] = i;
+				if (i_points[i].Get(axis) > i_points[maxIndex[axis]].Get(axis)) maxIndex[axis] = i;
+			}
+		}
+		int widestAxis = 0;
+		float widestSpanSqr = -1;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			Vector3 span = Vector3(i_points[maxIndex[axis]]) - i_points[minIndex[axis]];
+			if (span.dot(span) > widestSpanSqr)
+			{
+				widestSpanSqr = span.dot(span);
+				widestAxis = axis;
+			}
+		}
+		Vector3 center = (Vector3(i_points[minIndex[widestAxis]]) + i_points[maxIndex[widestAxis]]) * 0.5f;
+		float radius = std::sqrt(widestSpanSqr) * 0.5f;
+		for (size_t i = 0; i < i_points.size(); i++)
+		{
+			Vector3 offset = Vector3(i_points[i]) - center;
+			const float distance = std::sqrt(offset.dot(offset));
+			if (distance > radius)
+			{
+				// Move the center toward the point just enough to keep the far side of the sphere where it was
+				const float newRadius = (radius + distance) * 0.5f;
+				center = center + offset * ((newRadius - radius) / distance);
+				radius = newRadius;
+			}
+		}
+		// Measured again so that round-off in the growing can't leave a point outside
+		radius = GetEnclosingRadius(i_points, center);
+		if (radius < o_radius)
+		{
+			o_center = center;
+			o_radius = radius;
+		}
+	}
+
+	// One hull of the file, without a convex hull (degenerate points) it gets no faces or adjacency
+	struct sHullToWrite
+	{
+		const std::vector<Vector3>* m_vertices;
+		const PlutoShe::Assets::ConvexHull* m_hull;
+	};
+
+	// Lays the hulls out as described in ColliderFormat.h, every value the runtime needs is computed here
+	std::vector<uint8_t> LayOutColliderFile(const std::vector<sHullToWrite>& i_hulls)
+	{
+		using namespace PlutoShe::Physics::ColliderFormat;
+		const uint32_t hullCount = static_cast<uint32_t>(i_hulls.size());
+		std::vector<sHullHeader> hullHeaders(hullCount);
+		std::vector<std::vector<uint32_t>> adjacencyOffsets(hullCount);
+		std::vector<std::vector<uint16_t>> adjacency(hullCount);
+		std::vector<std::vector<PlutoShe::Physics::sFacePlane>> facePlanes(hullCount);
+
+		sHeader header;
+		std::memset(&header, 0, sizeof(header));
+		header.m_magic = s_magic;
+		header.m_version = s_version;
+		header.m_hullCount = hullCount;
+
+		// Sections in the order of the hull headers, each one aligned
+		uint32_t size = static_cast<uint32_t>(sizeof(sHeader) + hullCount * sizeof(sHullHeader));
+		const auto addSection = [&size](uint32_t i_count, size_t i_elementSize)
+		{
+			if (i_count == 0)
+			{
+				return uint32_t(0);
+			}
+			const uint32_t offset = AlignSection(size);
+			size = offset + static_cast<uint32_t>(i_count * i_elementSize);
+			return offset;
+		};
+		for (uint32_t h = 0; h < hullCount; h++)
+		{
+			const std::vector<Vector3>& vertices = *i_hulls[h].m_vertices;
+			if (i_hulls[h].m_hull)
+			{
+				// Hull adjacency lets the runtime hill-climb to the support vertex instead of scanning every vertex.
+				// A hull too big for 16 bit neighbor indices gets none and keeps the scan
+				i_hulls[h].m_hull->BuildAdjacency(adjacencyOffsets[h], adjacency[h]);
+				for (const auto& face : i_hulls[h].m_hull->GetFaces())
+				{
+					PlutoShe::Physics::sFacePlane plane;
+					plane.m_normal = face.m_normal;
+					plane.m_distance = face.m_distance;
+					facePlanes[h].push_back(plane);
+				}
+			}
+
+			sHullHeader& hullHeader = hullHeaders[h];
+			std::memset(&hullHeader, 0, sizeof(hullHeader));
+			const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+			hullHeader.m_vertexCount = vertexCount;
+			hullHeader.m_paddedVertexCount = static_cast<uint32_t>(PlutoShe::Physics::SupportKernels::GetPaddedCount(vertexCount));
+			hullHeader.m_faceCount = static_cast<uint32_t>(facePlanes[h].size());
+			hullHeader.m_adjacencyCount = static_cast<uint32_t>(adjacency[h].size());
+
+			Vector3 boundsMin = vertexCount > 0 ? vertices[0] : Vector3();
+			Vector3 boundsMax = boundsMin;
+			Vector3 center;
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				boundsMin = Vector3(std::min(boundsMin.m_x, vertices[i].m_x), std::min(boundsMin.m_y, vertices[i].m_y), std::min(boundsMin.m_z, vertices[i].m_z));
+				boundsMax = Vector3(std::max(boundsMax.m_x, vertices[i].m_x), std::max(boundsMax.m_y, vertices[i].m_y), std::max(boundsMax.m_z, vertices[i].m_z));
+				center = center + vertices[i];
+			}
+			if (vertexCount > 0)
+			{
+				center = center / static_cast<float>(vertexCount);
+			}
+			Vector3 sphereCenter;
+			float sphereRadius;
+			ComputeBoundingSphere(vertices, center, sphereCenter, sphereRadius);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				hullHeader.m_boundsMin[axis] = boundsMin.Get(axis);
+				hullHeader.m_boundsMax[axis] = boundsMax.Get(axis);
+				hullHeader.m_center[axis] = center.Get(axis);
+				hullHeader.m_boundingSphere[axis] = sphereCenter.Get(axis);
+				header.m_boundsMin[axis] = h == 0 ? boundsMin.Get(axis) : std::min(header.m_boundsMin[axis], boundsMin.Get(axis));
+				header.m_boundsMax[axis] = h == 0 ? boundsMax.Get(axis) : std::max(header.m_boundsMax[axis], boundsMax.Get(axis));
+			}
+			hullHeader.m_boundingSphere[3] = sphereRadius;
+
+			hullHeader.m_verticesOffset = addSection(vertexCount, sizeof(Vector3));
+			hullHeader.m_soaVerticesOffset = addSection(hullHeader.m_paddedVertexCount * 3, sizeof(float));
+			hullHeader.m_facePlanesOffset = addSection(hullHeader.m_faceCount, sizeof(PlutoShe::Physics::sFacePlane));
+			hullHeader.m_adjacencyOffsetsOffset = addSection(hullHeader.m_adjacencyCount > 0 ? vertexCount + 1 : 0, sizeof(uint32_t));
+			hullHeader.m_adjacencyOffset = addSection(hullHeader.m_adjacencyCount, sizeof(uint16_t));
+		}
+
+		std::vector<uint8_t> data(AlignSection(size), 0);
+		std::memcpy(&data[0], &header, sizeof(header));
+		if (hullCount > 0)
+		{
+			std::memcpy(&data[sizeof(header)], &hullHeaders[0], hullCount * sizeof(sHullHeader));
+		}
+		for (uint32_t h = 0; h < hullCount; h++)
+		{
+			const std::vector<Vector3>& vertices = *i_hulls[h].m_vertices;
+			const sHullHeader& hullHeader = hullHeaders[h];
+			const uint32_t vertexCount = hullHeader.m_vertexCount;
+			const uint32_t paddedCount = hullHeader.m_paddedVertexCount;
+			if (vertexCount > 0)
+			{
+				std::memcpy(&data[hullHeader.m_verticesOffset], &vertices[0], vertexCount * sizeof(Vector3));
+				// The padding repeats the first vertex, it ties with it and loses on index
+				float* const soa = reinterpret_cast<float*>(&data[hullHeader.m_soaVerticesOffset]);
+				for (uint32_t i = 0; i < paddedCount; i++)
+				{
+					const Vector3& v = vertices[i < vertexCount ? i : 0];
+					soa[i] = v.m_x;
+					soa[paddedCount + i] = v.m_y;
+					soa[2 * paddedCount + i] = v.m_z;
+				}
+			}
+			if (!facePlanes[h].empty())
+			{
+				std::memcpy(&data[hullHeader.m_facePlanesOffset], &facePlanes[h][0], facePlanes[h].size() * sizeof(PlutoShe::Physics::sFacePlane));
+			}
+			if (!adjacency[h].empty())
+			{
+				std::memcpy(&data[hullHeader.m_adjacencyOffsetsOffset], &adjacencyOffsets[h][0], adjacencyOffsets[h].size() * sizeof(uint32_t));
+				std::memcpy(&data[hullHeader.m_adjacencyOffset], &adjacency[h][0], adjacency[h].size() * sizeof(uint16_t));
+			}
+		}
+		return data;
+	}
+}
 // Inherited Implementation
 //=========================
 
@@ -17,7 +227,10 @@ eae6320::cResult PlutoShe::Assets::ColliderBuilder::Build(const std::vector<std:
 	auto result = eae6320::Results::Success;
 	std::string errorMessage;
 	PlutoShe::Physics::Collider loadCollider;
-	InitData(m_path_source, loadCollider);
+	if (!(result = InitData(m_path_source, loadCollider)))
+	{
+		return result;
+	}
 	std::ofstream outfile(m_path_target, std::ofstream::binary);
 	if (!outfile.is_open())
 	{
@@ -26,10 +239,90 @@ eae6320::cResult PlutoShe::Assets::ColliderBuilder::Build(const std::vector<std:
 		result = eae6320::Results::Failure;
 		return result;
 	}
-	uint16_t vertexNum = static_cast<uint16_t>(loadCollider.m_vertices.size());
+	// Only the corners of the hull are kept, so interior and redundant mesh vertices cost the support function nothing
+	const auto& sourcePoints = loadCollider.m_vertices;
+	// A concave mesh is split into parts that are close to convex, each one becomes a hull of its own
+	std::vector<std::vector<PlutoShe::Physics::Vector3>> parts;
+	if (!m_meshIndices.empty() && m_decompositionSettings.m_maxPartCount > 1)
+	{
+		ConvexDecomposition decomposition;
+		if (decomposition.Build(sourcePoints, m_meshIndices, m_decompositionSettings))
+		{
+			parts = decomposition.GetParts();
+			std::cout << m_path_source << ": " << m_meshIndices.size() / 3 << " triangles decomposed into " << parts.size()
+				<< " convex parts, their hulls cover " << decomposition.GetConcavity() * 100.0f << "% of the mesh's volume outside of the mesh" << std::endl;
+			if (!decomposition.IsClosed())
+			{
+				eae6320::Assets::OutputWarningMessageWithFileInfo(m_path_source, "The mesh has no inside, the hulls only follow its surface");
+			}
+		}
+	}
+	if (parts.empty())
+	{
+		parts.push_back(sourcePoints);
+	}
 
-	outfile.write(reinterpret_cast<const char*>(&vertexNum), sizeof(vertexNum));
-	outfile.write(reinterpret_cast<const char*>(&loadCollider.m_vertices[0]), vertexNum * sizeof(PlutoShe::Physics::Vector3));
+	std::vector<ConvexHull> hulls(parts.size());
+	std::vector<sHullToWrite> hullsToWrite;
+	size_t flatPartCount = 0;
+	for (size_t i = 0; i < parts.size(); i++)
+	{
+		ConvexHull& hull = hulls[i];
+		const auto& points = parts[i];
+		if (!hull.Build(points, m_maxHullVertexCount, m_hullTolerance))
+		{
+			if (parts.size() > 1)
+			{
+				// A flat sliver of the mesh has no volume, the hulls next to it already hold its points
+				flatPartCount++;
+				continue;
+			}
+			eae6320::Assets::OutputWarningMessageWithFileInfo(m_path_source, "The collider's vertices are degenerate, the support function will fall back to a linear scan");
+			hullsToWrite.push_back(sHullToWrite{ &points, nullptr });
+			continue;
+		}
+		const auto& vertices = hull.GetVertices();
+		hullsToWrite.push_back(sHullToWrite{ &vertices, &hull });
+		const std::string name = parts.size() > 1 ? std::string(m_path_source) + " hull " + std::to_string(i) : std::string(m_path_source);
+		if (hull.GetError() > 0)
+		{
+			// The full hull is only built to tell how much the budget removed, so it has a budget of its own
+			constexpr size_t maxReportedVertexCount = 4096;
+			ConvexHull fullHull;
+			fullHull.Build(points, maxReportedVertexCount);
+			const size_t fullVertexCount = fullHull.GetVertices().size();
+			std::cout << name << ": " << points.size() << " points, convex hull of " << (fullVertexCount >= maxReportedVertexCount ? "at least " : "") << fullVertexCount
+				<< " vertices simplified to " << vertices.size() << " (" << hull.GetFaces().size() << " faces), source points are at most "
+				<< hull.GetError() << " outside of it" << std::endl;
+		}
+		else
+		{
+			std::cout << name << ": " << points.size() << " points, convex hull of " << vertices.size()
+				<< " vertices (" << hull.GetFaces().size() << " faces)" << std::endl;
+		}
+		if (vertices.size() > ConvexHull::s_maxAdjacencyVertexCount)
+		{
+			eae6320::Assets::OutputWarningMessageWithFileInfo(m_path_source, "The hull has %zu vertices but the 16 bit adjacency only reaches %zu,"
+				" the support function will fall back to a linear scan", vertices.size(), ConvexHull::s_maxAdjacencyVertexCount);
+		}
+		if (hull.GetError() > m_hullTolerance)
+		{
+			eae6320::Assets::OutputWarningMessageWithFileInfo(m_path_source, "A source point is %g outside of the simplified hull, more than the tolerance of %g",
+				hull.GetError(), m_hullTolerance);
+		}
+	}
+	if (flatPartCount > 0)
+	{
+		std::cout << m_path_source << ": " << flatPartCount << " flat parts were left out" << std::endl;
+	}
+	if (hullsToWrite.empty())
+	{
+		eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "Every part of the mesh is flat, there is no hull to write");
+		result = eae6320::Results::Failure;
+		return result;
+	}
+	const std::vector<uint8_t> fileData = LayOutColliderFile(hullsToWrite);
+	outfile.write(reinterpret_cast<const char*>(&fileData[0]), fileData.size());
 
 	outfile.close();
 	return result;
@@ -109,6 +402,265 @@ eae6320::cResult PlutoShe::Assets::ColliderBuilder::LoadVerticesFromLua(lua_Stat
 
 
 
+eae6320::cResult PlutoShe::Assets::ColliderBuilder::LoadHullSettingsFromLua(lua_State& io_luaState)
+{
+	auto result = eae6320::Results::Success;
+
+	{
+		lua_pushstring(&io_luaState, "maxVertexCount");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popMaxVertexCount([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (lua_isinteger(&io_luaState, -1))
+		{
+			// 0 keeps every corner of the hull
+			const auto maxVertexCount = lua_tointeger(&io_luaState, -1);
+			if (maxVertexCount < 0 || (maxVertexCount > 0 && maxVertexCount < 4))
+			{
+				result = eae6320::Results::InvalidFile;
+				eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "maxVertexCount has to be 0 (no limit) or at least 4");
+				return result;
+			}
+			m_maxHullVertexCount = static_cast<size_t>(maxVertexCount);
+		}
+		else if (!lua_isnil(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "maxVertexCount must be an integer");
+			return result;
+		}
+	}
+	{
+		lua_pushstring(&io_luaState, "tolerance");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popTolerance([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (lua_isnumber(&io_luaState, -1))
+		{
+			m_hullTolerance = static_cast<float>(lua_tonumber(&io_luaState, -1));
+		}
+		else if (!lua_isnil(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "tolerance must be a number");
+			return result;
+		}
+	}
+	return result;
+}
+
+
+
+eae6320::cResult PlutoShe::Assets::ColliderBuilder::LoadMeshFromLua(lua_State& io_luaState, PlutoShe::Physics::Collider& t_collider)
+{
+	auto result = eae6320::Results::Success;
+
+	std::string path_mesh;
+	{
+		lua_pushstring(&io_luaState, "mesh");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popMeshPath([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (lua_type(&io_luaState, -1) != LUA_TSTRING)
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "mesh must be the path of a geometry file");
+			return result;
+		}
+		// The path is relative to the collider file
+		const std::string path_collider(m_path_source);
+		const auto directoryEnd = path_collider.find_last_of("/\\");
+		path_mesh = directoryEnd == std::string::npos ? std::string() : path_collider.substr(0, directoryEnd + 1);
+		path_mesh += lua_tostring(&io_luaState, -1);
+	}
+
+	// The geometry file is run in the same state, its table is on top of the collider's one until this function returns
+	const auto stackTopBeforeLoad = lua_gettop(&io_luaState);
+	if (luaL_loadfile(&io_luaState, path_mesh.c_str()) != LUA_OK ||
+		lua_pcall(&io_luaState, 0, 1, 0) != LUA_OK)
+	{
+		result = eae6320::Results::InvalidFile;
+		eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "The mesh \"%s\" can't be loaded: %s", path_mesh.c_str(), lua_tostring(&io_luaState, -1));
+		// Pop the error message
+		lua_pop(&io_luaState, 1);
+		return result;
+	}
+	eae6320::cScopeGuard scopeGuard_popMeshTable([&io_luaState, stackTopBeforeLoad]
+	{
+		lua_settop(&io_luaState, stackTopBeforeLoad);
+	});
+	if (!lua_istable(&io_luaState, -1))
+	{
+		result = eae6320::Results::InvalidFile;
+		eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "The mesh \"%s\" must return a table", path_mesh.c_str());
+		return result;
+	}
+
+	{
+		lua_pushstring(&io_luaState, "vertexes");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popVertexes([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (!lua_istable(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "The mesh \"%s\" has no vertexes table", path_mesh.c_str());
+			return result;
+		}
+		const auto vertexCount = luaL_len(&io_luaState, -1);
+		t_collider.m_vertices.reserve(static_cast<size_t>(vertexCount));
+		for (lua_Integer i = 1; i <= vertexCount; ++i)
+		{
+			lua_pushinteger(&io_luaState, i);
+			lua_gettable(&io_luaState, -2);
+			eae6320::cScopeGuard scopeGuard_popVertex([&io_luaState]
+			{
+				lua_pop(&io_luaState, 1);
+			});
+			float position[3] = { 0, 0, 0 };
+			if (lua_istable(&io_luaState, -1))
+			{
+				for (int j = 1; j <= 3; j++)
+				{
+					lua_pushinteger(&io_luaState, j);
+					lua_gettable(&io_luaState, -2);
+					position[j - 1] = static_cast<float>(lua_tonumber(&io_luaState, -1));
+					lua_pop(&io_luaState, 1);
+				}
+			}
+			t_collider.m_vertices.push_back(PlutoShe::Physics::Vector3(position[0], position[1], position[2]));
+		}
+	}
+	{
+		lua_pushstring(&io_luaState, "indices");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popIndices([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (!lua_istable(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "The mesh \"%s\" has no indices table", path_mesh.c_str());
+			return result;
+		}
+		const auto indexCount = luaL_len(&io_luaState, -1);
+		if (indexCount % 3 != 0)
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "The mesh \"%s\" has %d indices, a triangle list needs a multiple of 3",
+				path_mesh.c_str(), static_cast<int>(indexCount));
+			return result;
+		}
+		m_meshIndices.reserve(static_cast<size_t>(indexCount));
+		for (lua_Integer i = 1; i <= indexCount; ++i)
+		{
+			lua_pushinteger(&io_luaState, i);
+			lua_gettable(&io_luaState, -2);
+			// Indices are 0-based, like the ones GeometryBuilder reads
+			const auto index = lua_tointeger(&io_luaState, -1);
+			lua_pop(&io_luaState, 1);
+			if (index < 0 || static_cast<size_t>(index) >= t_collider.m_vertices.size())
+			{
+				result = eae6320::Results::InvalidFile;
+				eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "The mesh \"%s\" has an index of %d, it only has %d vertices",
+					path_mesh.c_str(), static_cast<int>(index), static_cast<int>(t_collider.m_vertices.size()));
+				return result;
+			}
+			m_meshIndices.push_back(static_cast<uint32_t>(index));
+		}
+	}
+	return result;
+}
+
+
+
+eae6320::cResult PlutoShe::Assets::ColliderBuilder::LoadDecompositionSettingsFromLua(lua_State& io_luaState)
+{
+	auto result = eae6320::Results::Success;
+
+	{
+		lua_pushstring(&io_luaState, "maxHullCount");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popMaxHullCount([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (lua_isinteger(&io_luaState, -1))
+		{
+			// 1 keeps the whole mesh in a single hull
+			const auto maxHullCount = lua_tointeger(&io_luaState, -1);
+			if (maxHullCount < 1)
+			{
+				result = eae6320::Results::InvalidFile;
+				eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "maxHullCount has to be at least 1");
+				return result;
+			}
+			m_decompositionSettings.m_maxPartCount = static_cast<size_t>(maxHullCount);
+		}
+		else if (!lua_isnil(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "maxHullCount must be an integer");
+			return result;
+		}
+	}
+	{
+		lua_pushstring(&io_luaState, "voxelResolution");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popVoxelResolution([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (lua_isinteger(&io_luaState, -1))
+		{
+			const auto voxelResolution = lua_tointeger(&io_luaState, -1);
+			if (voxelResolution < 4 || voxelResolution > 256)
+			{
+				result = eae6320::Results::InvalidFile;
+				eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "voxelResolution has to be between 4 and 256");
+				return result;
+			}
+			m_decompositionSettings.m_resolution = static_cast<int>(voxelResolution);
+		}
+		else if (!lua_isnil(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "voxelResolution must be an integer");
+			return result;
+		}
+	}
+	{
+		lua_pushstring(&io_luaState, "maxConcavity");
+		lua_gettable(&io_luaState, -2);
+		eae6320::cScopeGuard scopeGuard_popMaxConcavity([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+		if (lua_isnumber(&io_luaState, -1))
+		{
+			m_decompositionSettings.m_maxConcavity = static_cast<float>(lua_tonumber(&io_luaState, -1));
+		}
+		else if (!lua_isnil(&io_luaState, -1))
+		{
+			result = eae6320::Results::InvalidFile;
+			eae6320::Assets::OutputErrorMessageWithFileInfo(m_path_source, "maxConcavity must be a number");
+			return result;
+		}
+	}
+	return result;
+}
+
+
+
 eae6320::cResult PlutoShe::Assets::ColliderBuilder::InitData(std::string i_path, PlutoShe::Physics::Collider& t_collider)
 {
 	auto result = eae6320::Results::Success;
@@ -203,7 +755,20 @@ eae6320::cResult PlutoShe::Assets::ColliderBuilder::InitData(std::string i_path,
 		lua_pop(luaState, 1);
 	});
 
-	if (!(result = LoadVerticesFromLua(*luaState, t_collider)))
+	// A collider is either given as its vertices or as a mesh to decompose
+	lua_pushstring(luaState, "mesh");
+	lua_gettable(luaState, -2);
+	const bool hasMesh = !lua_isnil(luaState, -1);
+	lua_pop(luaState, 1);
+	if (!(result = hasMesh ? LoadMeshFromLua(*luaState, t_collider) : LoadVerticesFromLua(*luaState, t_collider)))
+	{
+		return result;
+	}
+	if (!(result = LoadHullSettingsFromLua(*luaState)))
+	{
+		return result;
+	}
+	if (!(result = LoadDecompositionSettingsFromLua(*luaState)))
 	{
 		return result;
 	}
@@ -5,6 +5,7 @@
 #include <Engine/Graphics/Configuration.h>
 #include <Engine/PhysicsSystem/PhysicsSystem.h>
 #include <External/Lua/Includes.h>
+#include "ConvexDecomposition.h"
 namespace PlutoShe
 {
 	namespace Assets
@@ -16,6 +17,19 @@ namespace PlutoShe
 			virtual eae6320::cResult Build(const std::vector<std::string>& i_arguments) override;
 			virtual eae6320::cResult InitData(std::string i_path, PlutoShe::Physics::Collider& t_collider);
 			eae6320::cResult LoadVerticesFromLua(lua_State& io_luaState, PlutoShe::Physics::Collider& t_collider);
+			// Optional "maxVertexCount" and "tolerance" of the asset table
+			eae6320::cResult LoadHullSettingsFromLua(lua_State& io_luaState);
+			// "mesh" is the path of a geometry file, relative to the collider file, whose triangles are decomposed into convex hulls
+			eae6320::cResult LoadMeshFromLua(lua_State& io_luaState, PlutoShe::Physics::Collider& t_collider);
+			// Optional "maxHullCount", "voxelResolution" and "maxConcavity" of the asset table
+			eae6320::cResult LoadDecompositionSettingsFromLua(lua_State& io_luaState);
+
+			// The hull keeps at most this many vertices (0 for no limit) and leaves out the ones that are within the tolerance of the rest
+			size_t m_maxHullVertexCount = 64;
+			float m_hullTolerance = 0.01f;
+			// Triangles of the mesh, whose vertices are in the collider. Empty when the collider is given as vertices
+			std::vector<uint32_t> m_meshIndices;
+			ConvexDecomposition::sSettings m_decompositionSettings;
 		};
 
 	}
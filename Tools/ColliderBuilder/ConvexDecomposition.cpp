@@ -0,0 +1,646 @@
+#include "ConvexDecomposition.h"
+#include "ConvexHull.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace
+{
+	using PlutoShe::Physics::Vector3;
+
+	constexpr uint8_t s_outside = 0;
+	// Voxels that a triangle passes through
+	constexpr uint8_t s_surface = 1;
+	constexpr uint8_t s_inside = 2;
+
+	// Planes tried along each axis, the best one is then moved voxel by voxel between its neighbors
+	constexpr int s_coarsePlaneCount = 8;
+	// In voxels, the centers of a part lie on the faces of its own hull
+	constexpr float s_hullEpsilon = 1.0e-3f;
+	// Half the thickness given to flat parts, in voxels
+	constexpr float s_flatPartThickness = 0.49f;
+
+	bool IsSeparatingAxis(Vector3 i_axis, Vector3 i_a, Vector3 i_b, Vector3 i_c, Vector3 i_halfSize)
+	{
+		const float a = i_axis.dot(i_a);
+		const float b = i_axis.dot(i_b);
+		const float c = i_axis.dot(i_c);
+		const float radius = i_halfSize.m_x * std::abs(i_axis.m_x) + i_halfSize.m_y * std::abs(i_axis.m_y) + i_halfSize.m_z * std::abs(i_axis.m_z);
+		return std::min(a, std::min(b, c)) > radius || std::max(a, std::max(b, c)) < -radius;
+	}
+
+	// Separating axis test (Real-Time Collision Detection, 5.2.9), degenerate axes of thin triangles separate nothing
+	bool IsTriangleOverlappingBox(Vector3 i_a, Vector3 i_b, Vector3 i_c, Vector3 i_center, Vector3 i_halfSize)
+	{
+		Vector3 a = i_a - i_center;
+		Vector3 b = i_b - i_center;
+		Vector3 c = i_c - i_center;
+		Vector3 edges[3] = { b - a, c - b, a - c };
+		const Vector3 boxAxes[3] = { Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1) };
+		for (int i = 0; i < 3; i++)
+		{
+			if (IsSeparatingAxis(boxAxes[i], a, b, c, i_halfSize))
+			{
+				return false;
+			}
+		}
+		if (IsSeparatingAxis(edges[0].cross(edges[1]), a, b, c, i_halfSize))
+		{
+			return false;
+		}
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				if (IsSeparatingAxis(Vector3(boxAxes[i]).cross(edges[j]), a, b, c, i_halfSize))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+bool PlutoShe::Assets::ConvexDecomposition::Build(const std::vector<PlutoShe::Physics::Vector3>& i_vertices, const std::vector<uint32_t>& i_indices, const sSettings& i_settings)
+{
+	m_parts.clear();
+	m_concavity = 0;
+	m_isClosed = false;
+	if (i_vertices.empty() || i_indices.size() < 3)
+	{
+		return false;
+	}
+
+	Vector3 boundsMin = i_vertices[0];
+	Vector3 boundsMax = i_vertices[0];
+	for (const auto& vertex : i_vertices)
+	{
+		boundsMin = Vector3(std::min(boundsMin.m_x, vertex.m_x), std::min(boundsMin.m_y, vertex.m_y), std::min(boundsMin.m_z, vertex.m_z));
+		boundsMax = Vector3(std::max(boundsMax.m_x, vertex.m_x), std::max(boundsMax.m_y, vertex.m_y), std::max(boundsMax.m_z, vertex.m_z));
+	}
+	Vector3 extent = boundsMax - boundsMin;
+	const float longestSide = std::max(extent.m_x, std::max(extent.m_y, extent.m_z));
+	if (longestSide <= 0)
+	{
+		return false;
+	}
+	m_voxelSize = longestSide / static_cast<float>(std::max(i_settings.m_resolution, 1));
+	m_origin = boundsMin - Vector3(m_voxelSize, m_voxelSize, m_voxelSize);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		// The mesh ends at most one voxel before the last layer, so both outer layers stay empty
+		m_size[axis] = static_cast<int>(extent.Get(axis) / m_voxelSize) + 3;
+	}
+	voxelize(i_vertices, i_indices);
+
+	m_labels.assign(m_voxels.size(), -1);
+	m_rowMin.assign(static_cast<size_t>(m_size[1]) * m_size[2], 0);
+	m_rowMax.assign(m_rowMin.size(), -1);
+	std::vector<uint32_t> solid;
+	for (uint32_t i = 0; i < m_voxels.size(); i++)
+	{
+		if (m_voxels[i] != s_outside)
+		{
+			solid.push_back(i);
+			m_isClosed = m_isClosed || m_voxels[i] == s_inside;
+		}
+	}
+
+	// Separate pieces of the mesh start out as parts of their own
+	std::vector<sPart> parts;
+	{
+		std::vector<std::vector<uint32_t>> pieces;
+		splitIntoComponents(solid, pieces);
+		// Every piece of the mesh has a surface around it, the ones without are rays through holes in the mesh that were taken to be inside
+		pieces.erase(std::remove_if(pieces.begin(), pieces.end(), [this](const std::vector<uint32_t>& i_piece)
+		{
+			return std::none_of(i_piece.begin(), i_piece.end(), [this](uint32_t i_index) { return m_voxels[i_index] == s_surface; });
+		}), pieces.end());
+		if (pieces.size() > i_settings.m_maxPartCount)
+		{
+			for (size_t i = 1; i < pieces.size(); i++)
+			{
+				pieces[0].insert(pieces[0].end(), pieces[i].begin(), pieces[i].end());
+			}
+			pieces.resize(1);
+		}
+		for (auto& piece : pieces)
+		{
+			sPart part;
+			part.m_voxels = std::move(piece);
+			size_t count;
+			measure(part.m_voxels, -1, 0, true, count, part.m_concavity);
+			parts.push_back(std::move(part));
+		}
+	}
+
+	const size_t maxConcavity = static_cast<size_t>(i_settings.m_maxConcavity * static_cast<float>(solid.size()));
+	while (!parts.empty() && parts.size() < i_settings.m_maxPartCount)
+	{
+		size_t worst = 0;
+		for (size_t i = 1; i < parts.size(); i++)
+		{
+			if (parts[i].m_concavity > parts[worst].m_concavity)
+			{
+				worst = i;
+			}
+		}
+		if (parts[worst].m_concavity <= maxConcavity)
+		{
+			break;
+		}
+		sPart sides[2];
+		if (!split(parts[worst], sides[0], sides[1]))
+		{
+			parts[worst].m_concavity = 0;
+			continue;
+		}
+
+		// A side can fall apart into pieces (e.g. cutting through the arms of a U),
+		// they are kept separate as long as there are parts left for them
+		std::vector<std::vector<uint32_t>> pieces[2];
+		splitIntoComponents(sides[0].m_voxels, pieces[0]);
+		splitIntoComponents(sides[1].m_voxels, pieces[1]);
+		const bool keepPieces = parts.size() - 1 + pieces[0].size() + pieces[1].size() <= i_settings.m_maxPartCount;
+		parts.erase(parts.begin() + worst);
+		for (int side = 0; side < 2; side++)
+		{
+			if (!keepPieces || pieces[side].size() == 1)
+			{
+				parts.push_back(std::move(sides[side]));
+				continue;
+			}
+			for (auto& piece : pieces[side])
+			{
+				sPart part;
+				part.m_voxels = std::move(piece);
+				size_t count;
+				measure(part.m_voxels, -1, 0, true, count, part.m_concavity);
+				parts.push_back(std::move(part));
+			}
+		}
+	}
+
+	size_t concavity = 0;
+	for (const auto& part : parts)
+	{
+		concavity += part.m_concavity;
+	}
+	m_concavity = solid.empty() ? 0 : static_cast<float>(concavity) / static_cast<float>(solid.size());
+	gatherPartPoints(i_vertices, i_indices, parts);
+	return true;
+}
+
+void PlutoShe::Assets::ConvexDecomposition::voxelize(const std::vector<PlutoShe::Physics::Vector3>& i_vertices, const std::vector<uint32_t>& i_indices)
+{
+	m_voxels.assign(static_cast<size_t>(m_size[0]) * m_size[1] * m_size[2], s_outside);
+	// A little larger than the voxels so that round-off can't open gaps between the voxels of a triangle
+	const float halfSize = m_voxelSize * 0.505f;
+	for (size_t t = 0; t + 2 < i_indices.size(); t += 3)
+	{
+		const Vector3& a = i_vertices[i_indices[t]];
+		const Vector3& b = i_vertices[i_indices[t + 1]];
+		const Vector3& c = i_vertices[i_indices[t + 2]];
+		int minCell[3];
+		int maxCell[3];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float low = std::min(a.Get(axis), std::min(b.Get(axis), c.Get(axis))) - m_origin.Get(axis);
+			const float high = std::max(a.Get(axis), std::max(b.Get(axis), c.Get(axis))) - m_origin.Get(axis);
+			// Where the mesh only touches the outer layers the voxels next to them hold it as well, so they are left empty
+			minCell[axis] = std::max(static_cast<int>(std::floor(low / m_voxelSize - 0.01f)), 1);
+			maxCell[axis] = std::min(static_cast<int>(std::floor(high / m_voxelSize + 0.01f)), m_size[axis] - 2);
+		}
+		for (int z = minCell[2]; z <= maxCell[2]; z++)
+		{
+			for (int y = minCell[1]; y <= maxCell[1]; y++)
+			{
+				for (int x = minCell[0]; x <= maxCell[0]; x++)
+				{
+					uint8_t& voxel = m_voxels[getIndex(x, y, z)];
+					if (voxel != s_surface && IsTriangleOverlappingBox(a, b, c, getCorner(x, y, z) + Vector3(0.5f, 0.5f, 0.5f) * m_voxelSize,
+						Vector3(halfSize, halfSize, halfSize)))
+					{
+						voxel = s_surface;
+					}
+				}
+			}
+		}
+	}
+
+	// A voxel is inside when a ray from its center crosses the surface an odd number of times.
+	// Rays go both ways along all three axes and most of them have to agree, so that a hole in the mesh
+	// or a ray through an edge only spoils a few of them. The rays are moved off the voxel centers by a fraction
+	// of a voxel so they don't run exactly along the edges of meshes that line up with the grid
+	std::vector<uint8_t> votes(m_voxels.size(), 0);
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const int u = (axis + 1) % 3;
+		const int v = (axis + 2) % 3;
+		const float rayOffset = 0.5f + 0.00137f * static_cast<float>(axis + 1);
+		// Crossings of every ray with the surface, the rays are the rows of voxels along the axis
+		std::vector<std::vector<float>> crossings(static_cast<size_t>(m_size[u]) * m_size[v]);
+		for (size_t t = 0; t + 2 < i_indices.size(); t += 3)
+		{
+			const Vector3* const corners[3] = { &i_vertices[i_indices[t]], &i_vertices[i_indices[t + 1]], &i_vertices[i_indices[t + 2]] };
+			int first[2];
+			int last[2];
+			for (int i = 0; i < 2; i++)
+			{
+				const int other = i == 0 ? u : v;
+				const float low = std::min(corners[0]->Get(other), std::min(corners[1]->Get(other), corners[2]->Get(other))) - m_origin.Get(other);
+				const float high = std::max(corners[0]->Get(other), std::max(corners[1]->Get(other), corners[2]->Get(other))) - m_origin.Get(other);
+				first[i] = std::max(static_cast<int>(std::ceil(low / m_voxelSize - rayOffset)), 1);
+				last[i] = std::min(static_cast<int>(std::floor(high / m_voxelSize - rayOffset)), m_size[other] - 2);
+			}
+			for (int cv = first[1]; cv <= last[1]; cv++)
+			{
+				for (int cu = first[0]; cu <= last[0]; cu++)
+				{
+					const float pu = m_origin.Get(u) + (static_cast<float>(cu) + rayOffset) * m_voxelSize;
+					const float pv = m_origin.Get(v) + (static_cast<float>(cv) + rayOffset) * m_voxelSize;
+					// Edge functions of the triangle projected along the axis, the ray hits it when they all have the same sign
+					float edges[3];
+					for (int i = 0; i < 3; i++)
+					{
+						const Vector3& from = *corners[i];
+						const Vector3& to = *corners[(i + 1) % 3];
+						edges[i] = (to.Get(u) - from.Get(u)) * (pv - from.Get(v)) - (to.Get(v) - from.Get(v)) * (pu - from.Get(u));
+					}
+					if (!((edges[0] > 0 && edges[1] > 0 && edges[2] > 0) || (edges[0] < 0 && edges[1] < 0 && edges[2] < 0)))
+					{
+						continue;
+					}
+					// Each edge function weighs the corner across from it
+					const float crossing = (edges[1] * corners[0]->Get(axis) + edges[2] * corners[1]->Get(axis) + edges[0] * corners[2]->Get(axis))
+						/ (edges[0] + edges[1] + edges[2]);
+					crossings[cu + m_size[u] * cv].push_back(crossing);
+				}
+			}
+		}
+		for (int cv = 1; cv < m_size[v] - 1; cv++)
+		{
+			for (int cu = 1; cu < m_size[u] - 1; cu++)
+			{
+				auto& rayCrossings = crossings[cu + m_size[u] * cv];
+				if (rayCrossings.empty())
+				{
+					continue;
+				}
+				std::sort(rayCrossings.begin(), rayCrossings.end());
+				size_t before = 0;
+				for (int c = 1; c < m_size[axis] - 1; c++)
+				{
+					const float center = m_origin.Get(axis) + (static_cast<float>(c) + 0.5f) * m_voxelSize;
+					while (before < rayCrossings.size() && rayCrossings[before] < center)
+					{
+						before++;
+					}
+					int coordinates[3];
+					coordinates[axis] = c;
+					coordinates[u] = cu;
+					coordinates[v] = cv;
+					const uint32_t index = getIndex(coordinates[0], coordinates[1], coordinates[2]);
+					votes[index] = static_cast<uint8_t>(votes[index] + (before % 2) + ((rayCrossings.size() - before) % 2));
+				}
+			}
+		}
+	}
+	for (size_t i = 0; i < m_voxels.size(); i++)
+	{
+		if (m_voxels[i] != s_surface && votes[i] > 3)
+		{
+			m_voxels[i] = s_inside;
+		}
+	}
+}
+
+void PlutoShe::Assets::ConvexDecomposition::measure(const std::vector<uint32_t>& i_voxels, int i_axis, int i_plane, bool i_isBelow, size_t& o_count, size_t& o_concavity)
+{
+	o_count = 0;
+	o_concavity = 0;
+	int minCoordinates[3] = { INT_MAX, INT_MAX, INT_MAX };
+	int maxCoordinates[3] = { -1, -1, -1 };
+	std::vector<int> rows;
+	for (const auto index : i_voxels)
+	{
+		int coordinates[3];
+		getCoordinates(index, coordinates);
+		if (i_axis >= 0 && (coordinates[i_axis] < i_plane) != i_isBelow)
+		{
+			continue;
+		}
+		o_count++;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			minCoordinates[axis] = std::min(minCoordinates[axis], coordinates[axis]);
+			maxCoordinates[axis] = std::max(maxCoordinates[axis], coordinates[axis]);
+		}
+		const int row = coordinates[1] + m_size[1] * coordinates[2];
+		if (m_rowMax[row] < 0)
+		{
+			rows.push_back(row);
+			m_rowMin[row] = coordinates[0];
+			m_rowMax[row] = coordinates[0];
+		}
+		else
+		{
+			m_rowMin[row] = std::min(m_rowMin[row], coordinates[0]);
+			m_rowMax[row] = std::max(m_rowMax[row], coordinates[0]);
+		}
+	}
+
+	// The hull of the voxel centers is the hull of the first and the last center of every row.
+	// It is built in voxel units, with the center of voxel (x, y, z) at (x + 0.5, y + 0.5, z + 0.5)
+	std::vector<Vector3> centers;
+	for (const auto row : rows)
+	{
+		const float y = static_cast<float>(row % m_size[1]) + 0.5f;
+		const float z = static_cast<float>(row / m_size[1]) + 0.5f;
+		centers.push_back(Vector3(static_cast<float>(m_rowMin[row]) + 0.5f, y, z));
+		if (m_rowMax[row] != m_rowMin[row])
+		{
+			centers.push_back(Vector3(static_cast<float>(m_rowMax[row]) + 0.5f, y, z));
+		}
+		m_rowMax[row] = -1;
+	}
+	ConvexHull hull;
+	if (!hull.Build(centers))
+	{
+		// The centers of a part one voxel thick are coplanar. The part is thickened by a little less than half a voxel,
+		// which covers none of the centers next to it along the axes
+		std::vector<Vector3> thickenedCenters;
+		for (const auto& center : centers)
+		{
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const Vector3 offset(axis == 0 ? s_flatPartThickness : 0, axis == 1 ? s_flatPartThickness : 0, axis == 2 ? s_flatPartThickness : 0);
+				thickenedCenters.push_back(Vector3(center) + offset);
+				thickenedCenters.push_back(Vector3(center) - offset);
+			}
+		}
+		if (!hull.Build(thickenedCenters))
+		{
+			return;
+		}
+	}
+
+	// Every voxel center inside the hull, counted row by row from where the row enters and leaves the hull
+	size_t coveredCount = 0;
+	const auto& faces = hull.GetFaces();
+	for (int z = minCoordinates[2]; z <= maxCoordinates[2]; z++)
+	{
+		for (int y = minCoordinates[1]; y <= maxCoordinates[1]; y++)
+		{
+			float enter = static_cast<float>(minCoordinates[0]);
+			float leave = static_cast<float>(maxCoordinates[0] + 1);
+			for (const auto& face : faces)
+			{
+				// The row is inside the face where normal.x * x <= limit
+				const float limit = face.m_distance + s_hullEpsilon
+					- face.m_normal.m_y * (static_cast<float>(y) + 0.5f) - face.m_normal.m_z * (static_cast<float>(z) + 0.5f);
+				if (face.m_normal.m_x > 1.0e-6f)
+				{
+					leave = std::min(leave, limit / face.m_normal.m_x);
+				}
+				else if (face.m_normal.m_x < -1.0e-6f)
+				{
+					enter = std::max(enter, limit / face.m_normal.m_x);
+				}
+				else if (limit < 0)
+				{
+					leave = enter - 1;
+				}
+				if (leave < enter)
+				{
+					break;
+				}
+			}
+			const int first = static_cast<int>(std::ceil(enter - 0.5f));
+			const int last = static_cast<int>(std::floor(leave - 0.5f));
+			if (last >= first)
+			{
+				coveredCount += static_cast<size_t>(last - first + 1);
+			}
+		}
+	}
+	o_concavity = coveredCount > o_count ? coveredCount - o_count : 0;
+}
+
+bool PlutoShe::Assets::ConvexDecomposition::split(const sPart& i_part, sPart& o_below, sPart& o_above)
+{
+	int minCoordinates[3] = { INT_MAX, INT_MAX, INT_MAX };
+	int maxCoordinates[3] = { -1, -1, -1 };
+	for (const auto index : i_part.m_voxels)
+	{
+		int coordinates[3];
+		getCoordinates(index, coordinates);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			minCoordinates[axis] = std::min(minCoordinates[axis], coordinates[axis]);
+			maxCoordinates[axis] = std::max(maxCoordinates[axis], coordinates[axis]);
+		}
+	}
+
+	// A plane at p puts the voxels with a coordinate below p on one side and the rest on the other
+	int bestAxis = -1;
+	int bestPlane = 0;
+	size_t bestConcavity = 0;
+	size_t concavities[2] = { 0, 0 };
+	const auto tryPlane = [&](int i_axis, int i_plane)
+	{
+		size_t counts[2];
+		size_t planeConcavities[2];
+		measure(i_part.m_voxels, i_axis, i_plane, true, counts[0], planeConcavities[0]);
+		measure(i_part.m_voxels, i_axis, i_plane, false, counts[1], planeConcavities[1]);
+		if (bestAxis < 0 || planeConcavities[0] + planeConcavities[1] < bestConcavity)
+		{
+			bestAxis = i_axis;
+			bestPlane = i_plane;
+			bestConcavity = planeConcavities[0] + planeConcavities[1];
+			concavities[0] = planeConcavities[0];
+			concavities[1] = planeConcavities[1];
+		}
+	};
+	int steps[3] = { 1, 1, 1 };
+	for (int axis = 0; axis < 3; axis++)
+	{
+		steps[axis] = std::max((maxCoordinates[axis] - minCoordinates[axis] + 1) / s_coarsePlaneCount, 1);
+		for (int plane = minCoordinates[axis] + steps[axis]; plane <= maxCoordinates[axis]; plane += steps[axis])
+		{
+			tryPlane(axis, plane);
+		}
+	}
+	if (bestAxis < 0)
+	{
+		return false;
+	}
+	{
+		const int axis = bestAxis;
+		const int coarsePlane = bestPlane;
+		const int first = std::max(coarsePlane - steps[axis] + 1, minCoordinates[axis] + 1);
+		const int last = std::min(coarsePlane + steps[axis] - 1, maxCoordinates[axis]);
+		for (int plane = first; plane <= last; plane++)
+		{
+			if (plane != coarsePlane)
+			{
+				tryPlane(axis, plane);
+			}
+		}
+	}
+
+	o_below = sPart();
+	o_above = sPart();
+	for (const auto index : i_part.m_voxels)
+	{
+		int coordinates[3];
+		getCoordinates(index, coordinates);
+		(coordinates[bestAxis] < bestPlane ? o_below : o_above).m_voxels.push_back(index);
+	}
+	o_below.m_concavity = concavities[0];
+	o_above.m_concavity = concavities[1];
+	return true;
+}
+
+void PlutoShe::Assets::ConvexDecomposition::splitIntoComponents(const std::vector<uint32_t>& i_voxels, std::vector<std::vector<uint32_t>>& o_components)
+{
+	constexpr int unvisited = -2;
+	constexpr int visited = -3;
+	o_components.clear();
+	for (const auto index : i_voxels)
+	{
+		m_labels[index] = unvisited;
+	}
+	// The outer layers of the grid are empty, so the neighbors of a voxel of the mesh are always in the grid
+	const int offsets[6] = { 1, -1, m_size[0], -m_size[0], m_size[0] * m_size[1], -m_size[0] * m_size[1] };
+	std::vector<uint32_t> stack;
+	for (const auto index : i_voxels)
+	{
+		if (m_labels[index] != unvisited)
+		{
+			continue;
+		}
+		o_components.push_back(std::vector<uint32_t>());
+		auto& component = o_components.back();
+		m_labels[index] = visited;
+		stack.push_back(index);
+		while (!stack.empty())
+		{
+			const uint32_t current = stack.back();
+			stack.pop_back();
+			component.push_back(current);
+			for (int i = 0; i < 6; i++)
+			{
+				const uint32_t neighbor = static_cast<uint32_t>(static_cast<int>(current) + offsets[i]);
+				if (m_labels[neighbor] == unvisited)
+				{
+					m_labels[neighbor] = visited;
+					stack.push_back(neighbor);
+				}
+			}
+		}
+	}
+	for (const auto index : i_voxels)
+	{
+		m_labels[index] = -1;
+	}
+}
+
+void PlutoShe::Assets::ConvexDecomposition::gatherPartPoints(const std::vector<PlutoShe::Physics::Vector3>& i_vertices, const std::vector<uint32_t>& i_indices,
+	const std::vector<sPart>& i_parts)
+{
+	m_parts.assign(i_parts.size(), std::vector<Vector3>());
+	for (size_t p = 0; p < i_parts.size(); p++)
+	{
+		// Inside voxels are entirely within the mesh, so their corners are points of the part.
+		// As for the centers, the first and the last voxel of every row are enough
+		std::vector<int> rows;
+		for (const auto index : i_parts[p].m_voxels)
+		{
+			m_labels[index] = static_cast<int>(p);
+			if (m_voxels[index] != s_inside)
+			{
+				continue;
+			}
+			int coordinates[3];
+			getCoordinates(index, coordinates);
+			const int row = coordinates[1] + m_size[1] * coordinates[2];
+			if (m_rowMax[row] < 0)
+			{
+				rows.push_back(row);
+				m_rowMin[row] = coordinates[0];
+				m_rowMax[row] = coordinates[0];
+			}
+			else
+			{
+				m_rowMin[row] = std::min(m_rowMin[row], coordinates[0]);
+				m_rowMax[row] = std::max(m_rowMax[row], coordinates[0]);
+			}
+		}
+		for (const auto row : rows)
+		{
+			const int y = row % m_size[1];
+			const int z = row / m_size[1];
+			for (int corner = 0; corner < 4; corner++)
+			{
+				m_parts[p].push_back(getCorner(m_rowMin[row], y + corner % 2, z + corner / 2));
+				m_parts[p].push_back(getCorner(m_rowMax[row] + 1, y + corner % 2, z + corner / 2));
+			}
+			m_rowMax[row] = -1;
+		}
+	}
+
+	// The rest of every part is in its surface voxels, the triangles are sampled at half the voxel size
+	// and every sample goes to the parts of the voxels within that distance of it.
+	// Samples can't reach the boundary between two parts, so they are shared to close the gap between their hulls
+	const float spacing = m_voxelSize * 0.5f;
+	for (size_t t = 0; t + 2 < i_indices.size(); t += 3)
+	{
+		Vector3 a = i_vertices[i_indices[t]];
+		Vector3 ab = Vector3(i_vertices[i_indices[t + 1]]) - a;
+		Vector3 ac = Vector3(i_vertices[i_indices[t + 2]]) - a;
+		Vector3 bc = ac - ab;
+		const float longestEdge = std::sqrt(std::max(ab.dot(ab), std::max(ac.dot(ac), bc.dot(bc))));
+		const int subdivisions = std::max(static_cast<int>(std::ceil(longestEdge / spacing)), 1);
+		for (int i = 0; i <= subdivisions; i++)
+		{
+			for (int j = 0; i + j <= subdivisions; j++)
+			{
+				Vector3 sample = a + ab * (static_cast<float>(i) / subdivisions) + ac * (static_cast<float>(j) / subdivisions);
+				int cells[2][3];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					const float position = (sample.Get(axis) - m_origin.Get(axis)) / m_voxelSize;
+					cells[0][axis] = std::min(std::max(static_cast<int>(std::floor(position - 0.5f)), 1), m_size[axis] - 2);
+					cells[1][axis] = std::min(std::max(static_cast<int>(std::floor(position + 0.5f)), 1), m_size[axis] - 2);
+				}
+				int labels[8];
+				int labelCount = 0;
+				for (int corner = 0; corner < 8; corner++)
+				{
+					const int label = m_labels[getIndex(cells[corner & 1][0], cells[(corner >> 1) & 1][1], cells[corner >> 2][2])];
+					if (label >= 0 && std::find(labels, labels + labelCount, label) == labels + labelCount)
+					{
+						labels[labelCount++] = label;
+						m_parts[label].push_back(sample);
+					}
+				}
+			}
+		}
+	}
+}
+
+void PlutoShe::Assets::ConvexDecomposition::getCoordinates(uint32_t i_index, int o_coordinates[3]) const
+{
+	const int index = static_cast<int>(i_index);
+	o_coordinates[0] = index % m_size[0];
+	o_coordinates[1] = (index / m_size[0]) % m_size[1];
+	o_coordinates[2] = index / (m_size[0] * m_size[1]);
+}
+
+PlutoShe::Physics::Vector3 PlutoShe::Assets::ConvexDecomposition::getCorner(int i_x, int i_y, int i_z) const
+{
+	return Vector3(m_origin) + Vector3(static_cast<float>(i_x), static_cast<float>(i_y), static_cast<float>(i_z)) * m_voxelSize;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <Engine/PhysicsSystem/PhysicsSystem.h>
+
+namespace PlutoShe
+{
+	namespace Assets
+	{
+		// Approximate convex decomposition of a closed triangle mesh, in the spirit of V-HACD.
+		// The mesh is voxelized, then the part whose convex hull covers the most voxels that aren't its own
+		// is cut in two by the axis-aligned plane that leaves the least of them, until every part is close to convex
+		class ConvexDecomposition
+		{
+		public:
+			struct sSettings
+			{
+				size_t m_maxPartCount = 8;
+				// Voxels along the longest side of the mesh
+				int m_resolution = 32;
+				// A part is left as it is once its hull covers no more than this fraction of the mesh's volume outside of the part
+				float m_maxConcavity = 0.02f;
+			};
+
+			// i_indices is a triangle list. Returns false if the mesh has no extent
+			bool Build(const std::vector<PlutoShe::Physics::Vector3>& i_vertices, const std::vector<uint32_t>& i_indices, const sSettings& i_settings);
+
+			// Points of every part, the convex hull of each one is a hull of the collider
+			const std::vector<std::vector<PlutoShe::Physics::Vector3>>& GetParts() const { return m_parts; }
+			// Volume the hulls of the parts cover outside of their parts, as a fraction of the mesh's volume
+			float GetConcavity() const { return m_concavity; }
+			// False when no voxel is inside the mesh, e.g. because it is flat, the parts only follow its surface then
+			bool IsClosed() const { return m_isClosed; }
+
+		private:
+			struct sPart
+			{
+				std::vector<uint32_t> m_voxels;
+				size_t m_concavity = 0;
+			};
+
+			void voxelize(const std::vector<PlutoShe::Physics::Vector3>& i_vertices, const std::vector<uint32_t>& i_indices);
+			// Voxels of the part on one side of the plane through the voxel boundary at i_plane along i_axis (a negative axis takes all of them),
+			// o_concavity is the number of voxel centers inside the hull of their centers that aren't theirs
+			void measure(const std::vector<uint32_t>& i_voxels, int i_axis, int i_plane, bool i_isBelow, size_t& o_count, size_t& o_concavity);
+			// Returns false if no plane cuts the part
+			bool split(const sPart& i_part, sPart& o_below, sPart& o_above);
+			void splitIntoComponents(const std::vector<uint32_t>& i_voxels, std::vector<std::vector<uint32_t>>& o_components);
+			void gatherPartPoints(const std::vector<PlutoShe::Physics::Vector3>& i_vertices, const std::vector<uint32_t>& i_indices, const std::vector<sPart>& i_parts);
+
+			uint32_t getIndex(int i_x, int i_y, int i_z) const { return static_cast<uint32_t>(i_x + m_size[0] * (i_y + m_size[1] * i_z)); }
+			void getCoordinates(uint32_t i_index, int o_coordinates[3]) const;
+			PlutoShe::Physics::Vector3 getCorner(int i_x, int i_y, int i_z) const;
+
+			// Voxel grid with an empty layer all around the mesh
+			PlutoShe::Physics::Vector3 m_origin;
+			float m_voxelSize = 0;
+			int m_size[3] = { 0, 0, 0 };
+			std::vector<uint8_t> m_voxels;
+			// Part of every voxel, -1 outside of the mesh
+			std::vector<int> m_labels;
+			// Scratch space of measure(), per row of voxels along x
+			std::vector<int> m_rowMin;
+			std::vector<int> m_rowMax;
+
+			std::vector<std::vector<PlutoShe::Physics::Vector3>> m_parts;
+			float m_concavity = 0;
+			bool m_isClosed = false;
+		};
+	}
+}
@@ -0,0 +1,554 @@
+#include "ConvexHull.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+	struct sHorizonEdge
+	{
+		int m_from, m_to;
+		// The face across the edge, it stays on the hull
+		size_t m_face;
+	};
+
+	// Which side of a face a point is on is decided in double precision, so that thin faces don't tilt enough
+	// to fold the hull over while it grows
+	struct sPlane
+	{
+		double m_x = 0, m_y = 0, m_z = 0;
+		double m_distance = 0;
+
+		double GetDistance(const PlutoShe::Physics::Vector3& i_point) const
+		{
+			return m_x * i_point.m_x + m_y * i_point.m_y + m_z * i_point.m_z - m_distance;
+		}
+	};
+
+	// The normal follows the winding of the corners, a face with no area gets a zero normal that never sees a point
+	sPlane MakePlane(const PlutoShe::Physics::Vector3& i_a, const PlutoShe::Physics::Vector3& i_b, const PlutoShe::Physics::Vector3& i_c)
+	{
+		const double abX = double(i_b.m_x) - i_a.m_x, abY = double(i_b.m_y) - i_a.m_y, abZ = double(i_b.m_z) - i_a.m_z;
+		const double acX = double(i_c.m_x) - i_a.m_x, acY = double(i_c.m_y) - i_a.m_y, acZ = double(i_c.m_z) - i_a.m_z;
+		sPlane plane;
+		plane.m_x = abY * acZ - abZ * acY;
+		plane.m_y = abZ * acX - abX * acZ;
+		plane.m_z = abX * acY - abY * acX;
+		const double length = std::sqrt(plane.m_x * plane.m_x + plane.m_y * plane.m_y + plane.m_z * plane.m_z);
+		if (length > 0)
+		{
+			plane.m_x /= length;
+			plane.m_y /= length;
+			plane.m_z /= length;
+			plane.m_distance = plane.m_x * i_a.m_x + plane.m_y * i_a.m_y + plane.m_z * i_a.m_z;
+		}
+		else
+		{
+			plane.m_x = plane.m_y = plane.m_z = 0;
+		}
+		return plane;
+	}
+
+	PlutoShe::Physics::Vector3 GetClosestPointOnTriangle(PlutoShe::Physics::Vector3 i_point,
+		PlutoShe::Physics::Vector3 i_a, PlutoShe::Physics::Vector3 i_b, PlutoShe::Physics::Vector3 i_c)
+	{
+		using PlutoShe::Physics::Vector3;
+		Vector3 ab = i_b - i_a;
+		Vector3 ac = i_c - i_a;
+		Vector3 ap = i_point - i_a;
+		const float d1 = ab.dot(ap), d2 = ac.dot(ap);
+		if (d1 <= 0 && d2 <= 0) return i_a;
+		Vector3 bp = i_point - i_b;
+		const float d3 = ab.dot(bp), d4 = ac.dot(bp);
+		if (d3 >= 0 && d4 <= d3) return i_b;
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0 && d1 >= 0 && d3 <= 0) return i_a + ab * (d1 / (d1 - d3));
+		Vector3 cp = i_point - i_c;
+		const float d5 = ab.dot(cp), d6 = ac.dot(cp);
+		if (d6 >= 0 && d5 <= d6) return i_c;
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0 && d2 >= 0 && d6 <= 0) return i_a + ac * (d2 / (d2 - d6));
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) return i_b + (i_c - i_b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		const float denominator = 1.0f / (va + vb + vc);
+		return i_a + ab * (vb * denominator) + ac * (vc * denominator);
+	}
+
+	// A face of the hull while it grows, m_neighbors[i] is the face across the edge that starts at corner i
+	struct sBuildFace
+	{
+		PlutoShe::Assets::ConvexHull::sFace m_face;
+		sPlane m_plane;
+		size_t m_neighbors[3];
+		// Points outside of the face, every point is assigned to at most one face
+		std::vector<int> m_points;
+		int m_farthest = -1;
+		float m_farthestDistance = 0;
+		bool m_isVisible = false;
+		bool m_isRemoved = false;
+	};
+
+	int GetCorner(const PlutoShe::Assets::ConvexHull::sFace& i_face, int i_corner)
+	{
+		return i_corner == 0 ? i_face.m_a : (i_corner == 1 ? i_face.m_b : i_face.m_c);
+	}
+}
+
+bool PlutoShe::Assets::ConvexHull::Build(const std::vector<PlutoShe::Physics::Vector3>& i_points, size_t i_maxVertexCount, float i_tolerance)
+{
+	using PlutoShe::Physics::Vector3;
+	m_points = i_points;
+	m_faces.clear();
+	m_error = 0;
+	const int count = static_cast<int>(m_points.size());
+	if (count < 4)
+	{
+		return false;
+	}
+
+	// Removed faces keep their slot until a new face reuses it, so that the neighbor indices stay valid
+	std::vector<sBuildFace> faces;
+	std::vector<size_t> freeFaces;
+	// The faces added by the last step
+	std::vector<size_t> newFaces;
+	// Number of faces using each point, the hull vertices are the points with a non-zero count
+	std::vector<int> faceCounts(count, 0);
+	size_t vertexCount = 0;
+	const auto addFace = [&](int i_a, int i_b, int i_c)
+	{
+		size_t face = faces.size();
+		if (freeFaces.empty())
+		{
+			faces.push_back(sBuildFace());
+		}
+		else
+		{
+			face = freeFaces.back();
+			freeFaces.pop_back();
+			faces[face].m_farthest = -1;
+			faces[face].m_farthestDistance = 0;
+			faces[face].m_isVisible = false;
+			faces[face].m_isRemoved = false;
+		}
+		sBuildFace& newFace = faces[face];
+		newFace.m_face.m_a = i_a;
+		newFace.m_face.m_b = i_b;
+		newFace.m_face.m_c = i_c;
+		newFace.m_plane = MakePlane(m_points[i_a], m_points[i_b], m_points[i_c]);
+		newFace.m_face.m_normal = Vector3(static_cast<float>(newFace.m_plane.m_x), static_cast<float>(newFace.m_plane.m_y), static_cast<float>(newFace.m_plane.m_z));
+		newFace.m_face.m_distance = static_cast<float>(newFace.m_plane.m_distance);
+		newFaces.push_back(face);
+		const int corners[3] = { i_a, i_b, i_c };
+		for (int i = 0; i < 3; i++)
+		{
+			vertexCount += faceCounts[corners[i]]++ == 0 ? 1 : 0;
+		}
+	};
+	const auto removeFace = [&](size_t i_face)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			vertexCount -= --faceCounts[GetCorner(faces[i_face].m_face, i)] == 0 ? 1 : 0;
+		}
+		faces[i_face].m_isRemoved = true;
+		faces[i_face].m_points.clear();
+		freeFaces.push_back(i_face);
+	};
+	const auto getDistance = [&](size_t i_face, int i_point)
+	{
+		return static_cast<float>(faces[i_face].m_plane.GetDistance(m_points[i_point]));
+	};
+	// Only called for points outside of the hull
+	const auto getDistanceToHull = [&](int i_point)
+	{
+		float distanceSqr = FLT_MAX;
+		for (size_t f = 0; f < faces.size(); f++)
+		{
+			if (!faces[f].m_isRemoved)
+			{
+				const sFace& face = faces[f].m_face;
+				Vector3 offset = m_points[i_point] - GetClosestPointOnTriangle(m_points[i_point], m_points[face.m_a], m_points[face.m_b], m_points[face.m_c]);
+				distanceSqr = std::min(distanceSqr, offset.dot(offset));
+			}
+		}
+		return std::sqrt(distanceSqr);
+	};
+	// Gives the point to the face it is farthest outside of, among the new faces or among all of them.
+	// Returns false if it is inside all of them or within m_epsilon of the hull, such points count as being on it
+	const auto assignPoint = [&](int i_point, bool i_newFacesOnly)
+	{
+		size_t bestFace = faces.size();
+		// Anything closer than this is rounding noise, and a point that is coplanar with a face must not become its eye
+		float bestDistance = m_epsilon * 1.0e-3f;
+		const size_t candidateCount = i_newFacesOnly ? newFaces.size() : faces.size();
+		for (size_t i = 0; i < candidateCount; i++)
+		{
+			const size_t f = i_newFacesOnly ? newFaces[i] : i;
+			const float distance = faces[f].m_isRemoved ? 0 : getDistance(f, i_point);
+			if (distance > bestDistance)
+			{
+				bestDistance = distance;
+				bestFace = f;
+			}
+		}
+		// A point can be barely in front of every face and still far from the hull, off to the side of a sharp edge.
+		// That is how a thin hull would lose its rim, so the actual distance is measured for these
+		if (bestFace < faces.size() && (bestDistance > m_epsilon || getDistanceToHull(i_point) > m_epsilon))
+		{
+			sBuildFace& face = faces[bestFace];
+			face.m_points.push_back(i_point);
+			if (bestDistance > face.m_farthestDistance)
+			{
+				face.m_farthestDistance = bestDistance;
+				face.m_farthest = i_point;
+			}
+			return true;
+		}
+		return false;
+	};
+
+	// Tolerance relative to the size of the cloud
+	float extent = 0;
+	for (int i = 0; i < count; i++)
+	{
+		extent = std::max(extent, std::max(std::abs(m_points[i].m_x), std::max(std::abs(m_points[i].m_y), std::abs(m_points[i].m_z))));
+	}
+	m_epsilon = std::max(extent, 1.0f) * 1.0e-5f;
+
+	// Initial tetrahedron from extreme points
+	int i0 = 0;
+	for (int i = 1; i < count; i++)
+	{
+		if (m_points[i].m_x < m_points[i0].m_x) i0 = i;
+	}
+	int i1 = i0;
+	float best = 0;
+	for (int i = 0; i < count; i++)
+	{
+		Vector3 d = m_points[i] - m_points[i0];
+		if (d.dot(d) > best) { best = d.dot(d); i1 = i; }
+	}
+	int i2 = i0;
+	best = 0;
+	Vector3 axis = m_points[i1] - m_points[i0];
+	for (int i = 0; i < count; i++)
+	{
+		Vector3 c = axis.cross(m_points[i] - m_points[i0]);
+		if (c.dot(c) > best) { best = c.dot(c); i2 = i; }
+	}
+	int i3 = i0;
+	best = 0;
+	Vector3 planeNormal = axis.cross(m_points[i2] - m_points[i0]);
+	for (int i = 0; i < count; i++)
+	{
+		const float d = std::abs(planeNormal.dot(m_points[i] - m_points[i0]));
+		if (d > best) { best = d; i3 = i; }
+	}
+	if (i1 == i0 || i2 == i0 || i3 == i0 || best <= m_epsilon * std::sqrt(planeNormal.dot(planeNormal)))
+	{
+		return false;
+	}
+	// The faces below are counter-clockwise seen from outside when i3 is below the plane of i0, i1 and i2
+	if (planeNormal.dot(m_points[i3] - m_points[i0]) > 0)
+	{
+		std::swap(i1, i2);
+	}
+
+	const int tetrahedron[4][3] = { { i0, i1, i2 }, { i0, i3, i1 }, { i0, i2, i3 }, { i1, i3, i2 } };
+	for (int i = 0; i < 4; i++)
+	{
+		addFace(tetrahedron[i][0], tetrahedron[i][1], tetrahedron[i][2]);
+	}
+	for (size_t f = 0; f < 4; f++)
+	{
+		for (int e = 0; e < 3; e++)
+		{
+			const int from = GetCorner(faces[f].m_face, e);
+			const int to = GetCorner(faces[f].m_face, (e + 1) % 3);
+			for (size_t g = 0; g < 4; g++)
+			{
+				for (int k = 0; k < 3; k++)
+				{
+					if (GetCorner(faces[g].m_face, k) == to && GetCorner(faces[g].m_face, (k + 1) % 3) == from)
+					{
+						faces[f].m_neighbors[e] = g;
+					}
+				}
+			}
+		}
+	}
+
+	// The hull only grows, so this stays strictly inside of it
+	const Vector3 interior = (m_points[i0] + m_points[i1] + m_points[i2] + m_points[i3]) * 0.25f;
+
+	for (int p = 0; p < count; p++)
+	{
+		if (p != i0 && p != i1 && p != i2 && p != i3)
+		{
+			assignPoint(p, false);
+		}
+	}
+
+	// Grow the hull toward the farthest outside point until none is left
+	std::vector<size_t> visibleFaces;
+	std::vector<size_t> stack;
+	std::vector<sHorizonEdge> horizon;
+	// New face starting and ending at each horizon vertex, to link the new faces with each other
+	std::vector<size_t> newFaceFrom(count, 0);
+	std::vector<size_t> newFaceTo(count, 0);
+	// Horizon edge starting at each vertex plus one, 0 for vertices that aren't on the horizon
+	std::vector<size_t> horizonEdgeFrom(count, 0);
+	// Points owned by the faces that are replaced, they have to be assigned again
+	std::vector<int> orphans;
+	// Every point can only be the eye once, so more iterations than points means the hull has gone wrong numerically
+	for (int iteration = 0; iteration < count; iteration++)
+	{
+		size_t eyeFace = faces.size();
+		float eyeDistance = 0;
+		for (size_t f = 0; f < faces.size(); f++)
+		{
+			if (!faces[f].m_isRemoved && !faces[f].m_points.empty() && faces[f].m_farthestDistance > eyeDistance)
+			{
+				eyeDistance = faces[f].m_farthestDistance;
+				eyeFace = f;
+			}
+		}
+		if (eyeFace == faces.size() || eyeDistance <= i_tolerance || (i_maxVertexCount > 0 && vertexCount >= i_maxVertexCount))
+		{
+			break;
+		}
+		const int eye = faces[eyeFace].m_farthest;
+
+		// The faces the eye can see are flood filled from the eye face, so they are connected
+		// and the horizon is the boundary between them and the faces that stay.
+		// Unlike the points, a face is visible as soon as the eye is in front of it at all, or the new faces could fold
+		visibleFaces.clear();
+		stack.clear();
+		stack.push_back(eyeFace);
+		faces[eyeFace].m_isVisible = true;
+		while (!stack.empty())
+		{
+			const size_t f = stack.back();
+			stack.pop_back();
+			visibleFaces.push_back(f);
+			for (int e = 0; e < 3; e++)
+			{
+				const size_t neighbor = faces[f].m_neighbors[e];
+				if (!faces[neighbor].m_isVisible && faces[neighbor].m_plane.GetDistance(m_points[eye]) > 0)
+				{
+					faces[neighbor].m_isVisible = true;
+					stack.push_back(neighbor);
+				}
+			}
+		}
+		// Round-off can still fold a new face over the face across its horizon edge when the eye is almost in the plane of that face,
+		// and an eye exactly in that plane folds it flat with its normal turned inward.
+		// Such faces are replaced as well until every new face bends outward at the horizon
+		for (bool isFolded = true; isFolded;)
+		{
+			isFolded = false;
+			horizon.clear();
+			for (size_t i = 0; i < visibleFaces.size(); i++)
+			{
+				const size_t f = visibleFaces[i];
+				for (int e = 0; e < 3; e++)
+				{
+					const size_t neighbor = faces[f].m_neighbors[e];
+					if (faces[neighbor].m_isVisible)
+					{
+						continue;
+					}
+					sHorizonEdge edge;
+					edge.m_from = GetCorner(faces[f].m_face, e);
+					edge.m_to = GetCorner(faces[f].m_face, (e + 1) % 3);
+					edge.m_face = neighbor;
+					int opposite = 0;
+					for (int k = 0; k < 3; k++)
+					{
+						if (GetCorner(faces[neighbor].m_face, k) == edge.m_to)
+						{
+							opposite = GetCorner(faces[neighbor].m_face, (k + 2) % 3);
+						}
+					}
+					const sPlane newPlane = MakePlane(m_points[edge.m_from], m_points[edge.m_to], m_points[eye]);
+					const bool hasArea = newPlane.m_x != 0 || newPlane.m_y != 0 || newPlane.m_z != 0;
+					if (!hasArea || newPlane.GetDistance(m_points[opposite]) > 0 || newPlane.GetDistance(interior) >= 0)
+					{
+						faces[neighbor].m_isVisible = true;
+						visibleFaces.push_back(neighbor);
+						isFolded = true;
+					}
+					else
+					{
+						horizon.push_back(edge);
+					}
+				}
+			}
+		}
+
+		// Round-off can make the visible faces touch themselves at a vertex or enclose a face that stays,
+		// the eye is then treated as if it was on the hull instead of making the hull non-manifold.
+		// The horizon has to be one loop that passes every vertex once
+		bool isManifold = horizon.size() >= 3;
+		for (size_t h = 0; h < horizon.size(); h++)
+		{
+			isManifold = isManifold && horizonEdgeFrom[horizon[h].m_from] == 0;
+			horizonEdgeFrom[horizon[h].m_from] = h + 1;
+		}
+		size_t loopLength = 0;
+		for (size_t h = 0; isManifold && loopLength < horizon.size(); loopLength++)
+		{
+			h = horizonEdgeFrom[horizon[h].m_to];
+			if (h-- == 0)
+			{
+				isManifold = false;
+			}
+			else if (h == 0)
+			{
+				isManifold = loopLength + 1 == horizon.size();
+				break;
+			}
+		}
+		for (size_t h = 0; h < horizon.size(); h++)
+		{
+			horizonEdgeFrom[horizon[h].m_from] = 0;
+		}
+		if (!isManifold)
+		{
+			for (size_t i = 0; i < visibleFaces.size(); i++)
+			{
+				faces[visibleFaces[i]].m_isVisible = false;
+			}
+			sBuildFace& face = faces[eyeFace];
+			face.m_points.erase(std::find(face.m_points.begin(), face.m_points.end(), eye));
+			m_error = std::max(m_error, eyeDistance);
+			face.m_farthest = -1;
+			face.m_farthestDistance = 0;
+			for (size_t i = 0; i < face.m_points.size(); i++)
+			{
+				const float distance = getDistance(eyeFace, face.m_points[i]);
+				if (distance > face.m_farthestDistance)
+				{
+					face.m_farthestDistance = distance;
+					face.m_farthest = face.m_points[i];
+				}
+			}
+			continue;
+		}
+
+		orphans.clear();
+		for (size_t i = 0; i < visibleFaces.size(); i++)
+		{
+			const sBuildFace& face = faces[visibleFaces[i]];
+			orphans.insert(orphans.end(), face.m_points.begin(), face.m_points.end());
+			removeFace(visibleFaces[i]);
+		}
+
+		// Every horizon edge is joined to the eye, the new faces keep the winding of the faces they replace
+		newFaces.clear();
+		for (size_t h = 0; h < horizon.size(); h++)
+		{
+			addFace(horizon[h].m_from, horizon[h].m_to, eye);
+			const size_t newFace = newFaces.back();
+			faces[newFace].m_neighbors[0] = horizon[h].m_face;
+			sBuildFace& outside = faces[horizon[h].m_face];
+			for (int e = 0; e < 3; e++)
+			{
+				if (GetCorner(outside.m_face, e) == horizon[h].m_to)
+				{
+					outside.m_neighbors[e] = newFace;
+				}
+			}
+			newFaceFrom[horizon[h].m_from] = newFace;
+			newFaceTo[horizon[h].m_to] = newFace;
+		}
+		for (size_t i = 0; i < newFaces.size(); i++)
+		{
+			sBuildFace& face = faces[newFaces[i]];
+			face.m_neighbors[1] = newFaceFrom[face.m_face.m_b];
+			face.m_neighbors[2] = newFaceTo[face.m_face.m_a];
+		}
+
+		// Points are usually outside of a new face if they are outside at all,
+		// but one that was also outside of a face that stays would be lost without checking every face
+		for (size_t i = 0; i < orphans.size(); i++)
+		{
+			if (orphans[i] != eye && !assignPoint(orphans[i], true))
+			{
+				assignPoint(orphans[i], false);
+			}
+		}
+	}
+
+	// A hull that was stopped early or ran out of iterations leaves points outside, measure how far
+	for (size_t f = 0; f < faces.size(); f++)
+	{
+		if (faces[f].m_isRemoved)
+		{
+			continue;
+		}
+		m_faces.push_back(faces[f].m_face);
+		for (size_t i = 0; i < faces[f].m_points.size(); i++)
+		{
+			for (size_t g = 0; g < faces.size(); g++)
+			{
+				if (!faces[g].m_isRemoved)
+				{
+					m_error = std::max(m_error, getDistance(g, faces[f].m_points[i]));
+				}
+			}
+		}
+	}
+
+	// Keep only the corners and renumber the faces
+	std::vector<int> remap(count, -1);
+	std::vector<Vector3> vertices;
+	for (int p = 0; p < count; p++)
+	{
+		if (faceCounts[p] > 0)
+		{
+			remap[p] = static_cast<int>(vertices.size());
+			vertices.push_back(m_points[p]);
+		}
+	}
+	for (size_t f = 0; f < m_faces.size(); f++)
+	{
+		m_faces[f].m_a = remap[m_faces[f].m_a];
+		m_faces[f].m_b = remap[m_faces[f].m_b];
+		m_faces[f].m_c = remap[m_faces[f].m_c];
+	}
+	m_points.swap(vertices);
+	return !m_faces.empty();
+}
+
+bool PlutoShe::Assets::ConvexHull::BuildAdjacency(std::vector<uint32_t>& o_offsets, std::vector<uint16_t>& o_neighbors) const
+{
+	o_offsets.clear();
+	o_neighbors.clear();
+	const size_t pointCount = m_points.size();
+	if (pointCount > s_maxAdjacencyVertexCount)
+	{
+		return false;
+	}
+	std::vector<std::vector<uint16_t>> neighbors(pointCount);
+	for (size_t f = 0; f < m_faces.size(); f++)
+	{
+		const int corners[3] = { m_faces[f].m_a, m_faces[f].m_b, m_faces[f].m_c };
+		for (int i = 0; i < 3; i++)
+		{
+			neighbors[corners[i]].push_back(static_cast<uint16_t>(corners[(i + 1) % 3]));
+			neighbors[corners[i]].push_back(static_cast<uint16_t>(corners[(i + 2) % 3]));
+		}
+	}
+
+	for (size_t i = 0; i < pointCount; i++)
+	{
+		std::sort(neighbors[i].begin(), neighbors[i].end());
+		neighbors[i].erase(std::unique(neighbors[i].begin(), neighbors[i].end()), neighbors[i].end());
+		o_offsets.push_back(static_cast<uint32_t>(o_neighbors.size()));
+		o_neighbors.insert(o_neighbors.end(), neighbors[i].begin(), neighbors[i].end());
+	}
+	o_offsets.push_back(static_cast<uint32_t>(o_neighbors.size()));
+	return true;
+}
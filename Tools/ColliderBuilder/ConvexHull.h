@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <Engine/PhysicsSystem/PhysicsSystem.h>
+
+namespace PlutoShe
+{
+	namespace Assets
+	{
+		// Convex hull of a point cloud (Quickhull), built offline so the runtime can walk the hull
+		class ConvexHull
+		{
+		public:
+			struct sFace
+			{
+				// Indices into GetVertices(), counter-clockwise seen from outside
+				int m_a, m_b, m_c;
+				PlutoShe::Physics::Vector3 m_normal;
+				float m_distance;
+			};
+
+			// Returns false if the points are degenerate (fewer than four or all coplanar).
+			// The farthest point is always added next, so stopping early gives the hull that loses the least.
+			// It stops once it has i_maxVertexCount vertices (0 for no limit) or once no point is more than i_tolerance outside of it
+			bool Build(const std::vector<PlutoShe::Physics::Vector3>& i_points, size_t i_maxVertexCount = 0, float i_tolerance = 0);
+
+			// Only the points that are corners of the hull, in the order of the input
+			const std::vector<PlutoShe::Physics::Vector3>& GetVertices() const { return m_points; }
+			const std::vector<sFace>& GetFaces() const { return m_faces; }
+			// How far the faces would have to move out to contain every input point, 0 unless the hull was stopped early or round-off made it skip a point
+			float GetError() const { return m_error; }
+			// Neighbors of every hull vertex along hull edges, as offsets into one packed index list.
+			// The indices are 16 bit, so a hull with more vertices than they can reach gets no adjacency and returns false
+			bool BuildAdjacency(std::vector<uint32_t>& o_offsets, std::vector<uint16_t>& o_neighbors) const;
+			static constexpr size_t s_maxAdjacencyVertexCount = size_t(UINT16_MAX) + 1;
+
+		private:
+			std::vector<PlutoShe::Physics::Vector3> m_points;
+			std::vector<sFace> m_faces;
+			float m_epsilon = 0;
+			float m_error = 0;
+		};
+	}
+}
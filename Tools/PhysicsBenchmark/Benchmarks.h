@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace PlutoShe
+{
+	namespace Benchmark
+	{
+		// Every benchmark prints its own results and returns false if a result doesn't match its reference
+		bool RunBroadphase();
+		bool RunDeterminism();
+		bool RunHillClimbing();
+		bool RunNarrowphase();
+		bool RunGJKAllocations();
+		bool RunRigidBodyWorld();
+		bool RunTransformInverse();
+
+		// Seconds since an arbitrary point, only differences between two calls mean anything
+		inline double GetTime()
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// rand() differs between standard libraries, this gives every platform the same scenes
+		class Random
+		{
+		public:
+			explicit Random(uint32_t i_seed) : m_state(i_seed) {}
+			float Get(float i_min, float i_max)
+			{
+				m_state = m_state * 1664525u + 1013904223u;
+				return i_min + (i_max - i_min) * (static_cast<float>(m_state >> 8) / 16777216.0f);
+			}
+
+		private:
+			uint32_t m_state;
+		};
+	}
+}
@@ -0,0 +1,94 @@
+#include "Benchmarks.h"
+
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/PhysicsSystem/CollisionWorld.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int s_stepCount = 60;
+	// Above this the brute force reference takes too long to run every time
+	constexpr size_t s_maxBruteForceColliderCount = 1000;
+
+	eae6320::Math::cMatrix_transformation GetTransform(const PlutoShe::Physics::Vector3& i_position)
+	{
+		return eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(), eae6320::Math::sVector(i_position.m_x, i_position.m_y, i_position.m_z));
+	}
+}
+
+// Unit boxes drifting over a flat level like the top-down shooter's, at the same density for every count,
+// so that the candidate pairs grow with the collider count and the brute force pairs with its square
+bool PlutoShe::Benchmark::RunBroadphase()
+{
+	using namespace PlutoShe::Physics;
+	bool areResultsValid = true;
+	const size_t colliderCounts[] = { 100, 1000, 10000 };
+	for (const size_t colliderCount : colliderCounts)
+	{
+		Random random(1);
+		const float levelSize = 4.0f * std::sqrt(static_cast<float>(colliderCount));
+		std::vector<Collider> colliders;
+		// The world keeps pointers, so the colliders must not move
+		colliders.reserve(colliderCount);
+		std::vector<Vector3> positions;
+		std::vector<Vector3> velocities;
+		CollisionWorld world;
+		for (size_t i = 0; i < colliderCount; i++)
+		{
+			// One draw per statement, the order arguments are evaluated in differs between compilers
+			const float x = random.Get(0, levelSize);
+			const float y = random.Get(-1, 1);
+			const float z = random.Get(0, levelSize);
+			positions.push_back(Vector3(x, y, z));
+			const float velocityX = random.Get(-0.1f, 0.1f);
+			const float velocityZ = random.Get(-0.1f, 0.1f);
+			velocities.push_back(Vector3(velocityX, 0, velocityZ));
+			colliders.push_back(Collider::CreateBox(Vector3(0.5f, 0.5f, 0.5f)));
+			colliders.back().UpdateTransformation(GetTransform(positions.back()));
+			world.AddCollider(&colliders.back());
+		}
+		world.Step();
+
+		double stepTime = 0;
+		size_t candidatePairCount = 0;
+		for (int step = 0; step < s_stepCount; step++)
+		{
+			for (size_t i = 0; i < colliderCount; i++)
+			{
+				positions[i] = positions[i] + velocities[i];
+				colliders[i].UpdateTransformation(GetTransform(positions[i]));
+			}
+			const double startTime = GetTime();
+			world.Step();
+			stepTime += GetTime() - startTime;
+			candidatePairCount += world.GetBroadphaseStats().m_candidatePairCount;
+		}
+		std::cout << std::setw(6) << colliderCount << " colliders: " << candidatePairCount / s_stepCount << " candidate pairs of "
+			<< world.GetBroadphaseStats().m_bruteForcePairCount << ", " << std::fixed << std::setprecision(3) << stepTime * 1000.0 / s_stepCount << " ms/step";
+
+		// Every pair through GJK on the last step's poses must find the same colliding pairs
+		if (colliderCount <= s_maxBruteForceColliderCount)
+		{
+			const double startTime = GetTime();
+			size_t collidingPairCount = 0;
+			for (size_t i = 0; i < colliderCount; i++)
+			{
+				for (size_t j = i + 1; j < colliderCount; j++)
+				{
+					collidingPairCount += colliders[i].IsCollided(colliders[j]) ? 1 : 0;
+				}
+			}
+			std::cout << ", brute force " << (GetTime() - startTime) * 1000.0 << " ms";
+			if (collidingPairCount != world.GetCollidingPairs().size())
+			{
+				std::cout << " and " << collidingPairCount << " colliding pairs instead of " << world.GetCollidingPairs().size();
+				areResultsValid = false;
+			}
+		}
+		std::cout << std::defaultfloat << std::endl;
+	}
+	return areResultsValid;
+}
@@ -0,0 +1,48 @@
+#include "Benchmarks.h"
+
+#include <Engine/Math/Configuration.h>
+#include <Engine/Physics/DeterminismCheck.h>
+#include <iomanip>
+#include <iostream>
+
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+namespace
+{
+	// The reference hash is only trusted for the compilers and platforms it was recorded from, so every run says which one it is
+	const char* GetCompilerName()
+	{
+#if defined( _MSC_VER )
+		return "MSVC";
+#elif defined( __clang__ )
+		return "Clang";
+#elif defined( __GNUC__ )
+		return "GCC";
+#else
+		return "an unknown compiler";
+#endif
+	}
+}
+#endif
+
+// The lockstep reference scene that DeterminismCheck hashes. Every build that is meant to simulate identically
+// (x64 and Win32, Debug and Release, Direct3D and OpenGL) has to print s_referenceHash
+bool PlutoShe::Benchmark::RunDeterminism()
+{
+#ifdef EAE6320_MATH_ISDETERMINISTIC
+	using namespace eae6320::Physics::DeterminismCheck;
+	const double startTime = GetTime();
+	const uint64_t hash = SimulateReferenceScene(s_referenceTickCount);
+	const double time = GetTime() - startTime;
+	std::cout << GetCompilerName() << " " << sizeof(void*) * 8 << " bit: " << s_referenceTickCount << " ticks in " << std::fixed << std::setprecision(1) << time * 1000.0
+		<< " ms, hash " << std::hex << std::setfill('0') << std::setw(16) << hash;
+	if (hash != s_referenceHash)
+	{
+		std::cout << " instead of " << std::setw(16) << s_referenceHash;
+	}
+	std::cout << std::dec << std::setfill(' ') << std::defaultfloat << std::endl;
+	return hash == s_referenceHash;
+#else
+	std::cout << "EAE6320_MATH_ISDETERMINISTIC isn't defined, so the hash depends on the compiler and the CPU" << std::endl;
+	return true;
+#endif
+}
@@ -0,0 +1,45 @@
+#include "Benchmarks.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	struct sBenchmark
+	{
+		const char* m_name;
+		bool(*m_run)();
+	};
+
+	const sBenchmark s_benchmarks[] =
+	{
+		{ "broadphase", PlutoShe::Benchmark::RunBroadphase },
+		{ "determinism", PlutoShe::Benchmark::RunDeterminism },
+		{ "hillclimbing", PlutoShe::Benchmark::RunHillClimbing },
+		{ "narrowphase", PlutoShe::Benchmark::RunNarrowphase },
+		{ "gjkallocations", PlutoShe::Benchmark::RunGJKAllocations },
+		{ "rigidbodyworld", PlutoShe::Benchmark::RunRigidBodyWorld },
+		{ "transforminverse", PlutoShe::Benchmark::RunTransformInverse },
+	};
+}
+
+// Runs every benchmark, or only the ones named on the command line.
+// Numbers only mean something in a Release build
+int main(int i_argumentCount, char** i_arguments)
+{
+	bool areResultsValid = true;
+	for (const sBenchmark& benchmark : s_benchmarks)
+	{
+		bool isSelected = i_argumentCount < 2;
+		for (int i = 1; i < i_argumentCount; i++)
+		{
+			isSelected = isSelected || std::strcmp(i_arguments[i], benchmark.m_name) == 0;
+		}
+		if (isSelected)
+		{
+			std::cout << "== " << benchmark.m_name << std::endl;
+			areResultsValid = benchmark.m_run() && areResultsValid;
+		}
+	}
+	return areResultsValid ? 0 : 1;
+}
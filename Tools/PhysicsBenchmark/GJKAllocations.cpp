@@ -0,0 +1,129 @@
+#include "Benchmarks.h"
+
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/PhysicsSystem/PhysicsSystem.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+
+// Every allocation in the program goes through these, so a query that touches the heap shows up in the count.
+// The other benchmarks pay for the counter too, which is noise next to the allocation itself
+namespace
+{
+	std::atomic<size_t> s_allocationCount(0);
+}
+
+void* operator new(size_t i_size)
+{
+	s_allocationCount++;
+	void* const memory = std::malloc(i_size > 0 ? i_size : 1);
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void* i_memory) noexcept
+{
+	std::free(i_memory);
+}
+
+void operator delete(void* i_memory, size_t) noexcept
+{
+	std::free(i_memory);
+}
+
+namespace
+{
+	constexpr int s_queryCount = 5000;
+
+	PlutoShe::Physics::Collider CreateHull(size_t i_vertexCount, PlutoShe::Benchmark::Random& io_random)
+	{
+		PlutoShe::Physics::Collider collider;
+		for (size_t i = 0; i < i_vertexCount; i++)
+		{
+			const float x = io_random.Get(-1, 1);
+			const float y = io_random.Get(-1, 1);
+			const float z = io_random.Get(-1, 1);
+			collider.m_vertices.push_back(PlutoShe::Physics::Vector3(x, y, z));
+		}
+		collider.RefreshVertices();
+		return collider;
+	}
+
+	// Runs i_query on the pair at poses that go from overlapping to well apart, and returns how many allocations it made
+	template <typename tQuery>
+	size_t CountAllocations(PlutoShe::Physics::Collider& io_A, PlutoShe::Physics::Collider& io_B, tQuery i_query)
+	{
+		std::vector<eae6320::Math::cMatrix_transformation> poses;
+		for (int i = 0; i < s_queryCount; i++)
+		{
+			const float angle = 0.01f * static_cast<float>(i);
+			poses.push_back(eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(angle, eae6320::Math::sVector(0, 0, 1)),
+				eae6320::Math::sVector(3.0f * std::sin(0.7f * angle), 0.2f, 0)));
+		}
+		const size_t startCount = s_allocationCount;
+		for (int i = 0; i < s_queryCount; i++)
+		{
+			io_B.UpdateTransformation(poses[i]);
+			i_query(io_A, io_B);
+		}
+		return s_allocationCount - startCount;
+	}
+}
+
+// GJK is run once per candidate pair every step, so none of its queries may touch the heap.
+// EPA builds its polytope in vectors and is only reported
+bool PlutoShe::Benchmark::RunGJKAllocations()
+{
+	using namespace PlutoShe::Physics;
+	Random random(8);
+	Collider hullA = CreateHull(300, random);
+	Collider hullB = CreateHull(300, random);
+	Collider sphere = Collider::CreateSphere(0.8f);
+	Collider capsule = Collider::CreateCapsule(0.5f, 1.0f);
+
+	struct sPair
+	{
+		const char* m_name;
+		Collider* m_A;
+		Collider* m_B;
+	};
+	const sPair pairs[] =
+	{
+		{ "hull-hull", &hullA, &hullB },
+		{ "hull-sphere", &hullA, &sphere },
+		{ "hull-capsule", &hullA, &capsule },
+	};
+
+	bool areResultsValid = true;
+	for (const sPair& pair : pairs)
+	{
+		sGJKWarmStart warmStart;
+		const size_t isCollidedCount = CountAllocations(*pair.m_A, *pair.m_B, [](Collider& io_A, Collider& io_B) { io_A.IsCollided(io_B); });
+		const size_t overlapsCount = CountAllocations(*pair.m_A, *pair.m_B, [&warmStart](Collider& io_A, Collider& io_B) { io_A.Overlaps(io_B, &warmStart); });
+		const size_t distanceCount = CountAllocations(*pair.m_A, *pair.m_B, [](Collider& io_A, Collider& io_B)
+			{
+				sDistanceResult result;
+				io_A.Distance(io_B, result);
+			});
+		const size_t timeOfImpactCount = CountAllocations(*pair.m_A, *pair.m_B, [](Collider& io_A, Collider& io_B)
+			{
+				sTimeOfImpactResult result;
+				io_A.TimeOfImpact(io_B, Vector3(), Vector3(-2.0f, 0, 0), result);
+			});
+		const size_t epaCount = CountAllocations(*pair.m_A, *pair.m_B, [](Collider& io_A, Collider& io_B)
+			{
+				sContact contact;
+				io_A.IsCollided(io_B, contact);
+			});
+		std::cout << pair.m_name << ", allocations in " << s_queryCount << " queries: IsCollided " << isCollidedCount << ", Overlaps " << overlapsCount
+			<< ", Distance " << distanceCount << ", TimeOfImpact " << timeOfImpactCount << ", with EPA " << epaCount << std::endl;
+		areResultsValid = areResultsValid && isCollidedCount == 0 && overlapsCount == 0 && distanceCount == 0 && timeOfImpactCount == 0;
+	}
+	return areResultsValid;
+}
@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+
+#include <Engine/Math/cQuaternion.h>
+#include <Tools/ColliderBuilder/ConvexHull.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int s_queryCount = 20000;
+
+	// Evenly spread points on a unit sphere, every one of them is a hull vertex
+	std::vector<PlutoShe::Physics::Vector3> GetSpherePoints(size_t i_count)
+	{
+		std::vector<PlutoShe::Physics::Vector3> points;
+		const float goldenAngle = 2.39996323f;
+		for (size_t i = 0; i < i_count; i++)
+		{
+			const float y = 1.0f - 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(i_count);
+			const float radius = std::sqrt(1.0f - y * y);
+			const float angle = goldenAngle * static_cast<float>(i);
+			points.push_back(PlutoShe::Physics::Vector3(radius * std::cos(angle), y, radius * std::sin(angle)));
+		}
+		return points;
+	}
+
+	struct sTimes
+	{
+		double m_overlaps = 0;
+		double m_distance = 0;
+	};
+
+	// B circles A a little further every query, the way a pair moves between steps. Overlaps() climbs from
+	// the last query's support vertices, Distance() has no warm start and climbs from the first vertex
+	sTimes RunQueries(PlutoShe::Physics::Collider& io_A, PlutoShe::Physics::Collider& io_B, std::vector<float>& o_distances)
+	{
+		using namespace PlutoShe::Physics;
+		sTimes times;
+		o_distances.clear();
+		PlutoShe::Benchmark::Random random(4);
+		sGJKWarmStart warmStart;
+		for (int i = 0; i < s_queryCount; i++)
+		{
+			const float angle = 0.01f * static_cast<float>(i);
+			const float centerDistance = 2.0f + 0.5f * std::sin(0.37f * angle);
+			const float spin = random.Get(0, 0.02f) + angle;
+			io_A.UpdateTransformation(eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(0.5f * angle, eae6320::Math::sVector(0, 1, 0)), eae6320::Math::sVector()));
+			io_B.UpdateTransformation(eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(spin, eae6320::Math::sVector(1, 0, 0)),
+				eae6320::Math::sVector(centerDistance * std::cos(angle), 0.3f, centerDistance * std::sin(angle))));
+
+			double startTime = PlutoShe::Benchmark::GetTime();
+			const bool isOverlapping = io_A.Overlaps(io_B, &warmStart);
+			times.m_overlaps += PlutoShe::Benchmark::GetTime() - startTime;
+
+			sDistanceResult result;
+			startTime = PlutoShe::Benchmark::GetTime();
+			io_A.Distance(io_B, result);
+			times.m_distance += PlutoShe::Benchmark::GetTime() - startTime;
+			o_distances.push_back(isOverlapping ? -1.0f : result.m_distance);
+		}
+		return times;
+	}
+}
+
+// GJK between two hulls of evenly spread points with and without hull adjacency, i.e. hill climbing against the linear scan.
+// Hulls under the hill climbing threshold (256 vertices) always use the linear scan, so at 8 and 64 vertices both columns are the scan
+bool PlutoShe::Benchmark::RunHillClimbing()
+{
+	using namespace PlutoShe::Physics;
+	bool areResultsValid = true;
+	const size_t vertexCounts[] = { 8, 64, 256, 512, 4096 };
+	for (const size_t vertexCount : vertexCounts)
+	{
+		PlutoShe::Assets::ConvexHull hull;
+		if (!hull.Build(GetSpherePoints(vertexCount)))
+		{
+			std::cout << "Couldn't build the hull of " << vertexCount << " points" << std::endl;
+			return false;
+		}
+		Collider linear;
+		linear.m_vertices = hull.GetVertices();
+		linear.RefreshVertices();
+		Collider climbing(linear);
+		hull.BuildAdjacency(climbing.m_adjacencyOffsets, climbing.m_adjacency);
+		climbing.RefreshVertices();
+		Collider linearB(linear);
+		Collider climbingB(climbing);
+
+		std::vector<float> linearDistances;
+		std::vector<float> climbingDistances;
+		const sTimes linearTimes = RunQueries(linear, linearB, linearDistances);
+		const sTimes climbingTimes = RunQueries(climbing, climbingB, climbingDistances);
+
+		const double toMicroseconds = 1.0e6 / s_queryCount;
+		std::cout << std::setw(5) << hull.GetVertices().size() << " vertices: " << std::fixed << std::setprecision(3)
+			<< "Overlaps " << linearTimes.m_overlaps * toMicroseconds << " -> " << climbingTimes.m_overlaps * toMicroseconds << " us, "
+			<< "Distance " << linearTimes.m_distance * toMicroseconds << " -> " << climbingTimes.m_distance * toMicroseconds << " us";
+
+		// Both walks end on the farthest vertex, so only ties may pick a different one
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < linearDistances.size(); i++)
+		{
+			mismatchCount += std::abs(linearDistances[i] - climbingDistances[i]) > 1.0e-4f ? 1 : 0;
+		}
+		if (mismatchCount > 0)
+		{
+			std::cout << ", " << mismatchCount << " results differ";
+			areResultsValid = false;
+		}
+		std::cout << std::defaultfloat << std::endl;
+	}
+	return areResultsValid;
+}
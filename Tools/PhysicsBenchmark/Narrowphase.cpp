@@ -0,0 +1,330 @@
+#include "Benchmarks.h"
+
+#include <Engine/Concurrency/cThread.h>
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/PhysicsSystem/CollisionWorld.h>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr size_t s_colliderCount = 2000;
+	constexpr int s_stepCount = 30;
+	constexpr size_t s_rayCount = 8192;
+	constexpr int s_threadStartCount = 200;
+
+	// Mixed shapes packed closely enough that a few thousand pairs reach the narrowphase and many of them touch.
+	// Every tenth collider is a trigger and every fiftieth one is fast, so events and sweeps are compared too
+	class cScene
+	{
+	public:
+		explicit cScene(unsigned int i_threadCount)
+		{
+			using namespace PlutoShe::Physics;
+			PlutoShe::Benchmark::Random random(14);
+			m_colliders.reserve(s_colliderCount);
+			for (size_t i = 0; i < s_colliderCount; i++)
+			{
+				if (i % 4 == 0)
+				{
+					std::vector<Vector3> points;
+					for (int p = 0; p < 16; p++)
+					{
+						const float x = random.Get(-0.5f, 0.5f);
+						const float y = random.Get(-0.5f, 0.5f);
+						const float z = random.Get(-0.5f, 0.5f);
+						points.push_back(Vector3(x, y, z));
+					}
+					m_colliders.push_back(Collider(points));
+				}
+				else if (i % 4 == 1)
+				{
+					m_colliders.push_back(Collider::CreateSphere(0.5f));
+				}
+				else if (i % 4 == 2)
+				{
+					m_colliders.push_back(Collider::CreateBox(Vector3(0.4f, 0.4f, 0.4f)));
+				}
+				else
+				{
+					m_colliders.push_back(Collider::CreateCapsule(0.3f, 0.4f));
+				}
+				m_colliders.back().SetIsTrigger(i % 10 == 9);
+				m_colliders.back().SetIsFast(i % 50 == 0);
+
+				const float x = random.Get(0, s_sceneSize);
+				const float y = random.Get(0, s_sceneSize);
+				const float z = random.Get(0, s_sceneSize);
+				m_positions.push_back(Vector3(x, y, z));
+				const float speed = i % 50 == 0 ? 2.0f : 0.05f;
+				const float velocityX = random.Get(-speed, speed);
+				const float velocityY = random.Get(-speed, speed);
+				const float velocityZ = random.Get(-speed, speed);
+				m_velocities.push_back(Vector3(velocityX, velocityY, velocityZ));
+				const float axisX = random.Get(-1, 1);
+				const float axisY = random.Get(-1, 1);
+				m_axes.push_back(eae6320::Math::sVector(axisX, axisY, 1.0f).GetNormalized());
+				m_angles.push_back(random.Get(0, 3.14f));
+				m_colliders.back().UpdateTransformation(GetTransform(i));
+				m_world.AddCollider(&m_colliders.back());
+			}
+			m_world.SetWorkerThreadCount(i_threadCount);
+		}
+
+		// Moves every collider (bouncing off the sides of the scene) and steps the world, returns the seconds Step() took
+		double Step()
+		{
+			for (size_t i = 0; i < s_colliderCount; i++)
+			{
+				m_positions[i] = m_positions[i] + m_velocities[i];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					const float position = m_positions[i].Get(axis);
+					if (position < 0 || position > s_sceneSize)
+					{
+						m_velocities[i] = m_velocities[i] - Vector3(axis == 0 ? 2.0f * m_velocities[i].m_x : 0, axis == 1 ? 2.0f * m_velocities[i].m_y : 0, axis == 2 ? 2.0f * m_velocities[i].m_z : 0);
+					}
+				}
+				m_angles[i] += 0.02f;
+				m_colliders[i].UpdateTransformation(GetTransform(i));
+			}
+			const double startTime = PlutoShe::Benchmark::GetTime();
+			m_world.Step();
+			return PlutoShe::Benchmark::GetTime() - startTime;
+		}
+
+		// Colliders as their index, floats as their bits, so two records are only equal if the results are bitwise equal
+		void Record(std::vector<uint32_t>& io_record) const
+		{
+			using namespace PlutoShe::Physics;
+			const std::vector<ColliderPair>& pairs = m_world.GetCollidingPairs();
+			io_record.push_back(static_cast<uint32_t>(pairs.size()));
+			for (const ColliderPair& pair : pairs)
+			{
+				io_record.push_back(GetIndex(pair.m_A));
+				io_record.push_back(GetIndex(pair.m_B));
+			}
+			io_record.push_back(static_cast<uint32_t>(m_world.GetManifolds().size()));
+			for (const auto& manifold : m_world.GetManifolds())
+			{
+				io_record.push_back(GetIndex(manifold.first.first));
+				io_record.push_back(GetIndex(manifold.first.second));
+				AppendVector(manifold.second.GetNormal(), io_record);
+				io_record.push_back(static_cast<uint32_t>(manifold.second.GetPointCount()));
+				for (int p = 0; p < manifold.second.GetPointCount(); p++)
+				{
+					const sContactPoint& point = manifold.second.GetPoint(p);
+					AppendVector(point.m_localPointA, io_record);
+					AppendVector(point.m_localPointB, io_record);
+					AppendVector(point.m_pointOnA, io_record);
+					AppendVector(point.m_pointOnB, io_record);
+					AppendFloat(point.m_depth, io_record);
+					io_record.push_back(static_cast<uint32_t>(point.m_lifetime));
+				}
+			}
+			io_record.push_back(static_cast<uint32_t>(m_world.GetCollisionEvents().size()));
+			for (const sCollisionEvent& event : m_world.GetCollisionEvents())
+			{
+				io_record.push_back(GetIndex(event.m_A));
+				io_record.push_back(GetIndex(event.m_B));
+				io_record.push_back(static_cast<uint32_t>(event.m_type));
+				io_record.push_back(event.m_isTrigger ? 1 : 0);
+			}
+			io_record.push_back(static_cast<uint32_t>(m_world.GetSweepHits().size()));
+			for (const sSweepHit& hit : m_world.GetSweepHits())
+			{
+				io_record.push_back(GetIndex(hit.m_fastCollider));
+				io_record.push_back(GetIndex(hit.m_other));
+				AppendFloat(hit.m_timeOfImpact.m_time, io_record);
+				AppendVector(hit.m_timeOfImpact.m_point, io_record);
+				AppendVector(hit.m_timeOfImpact.m_normal, io_record);
+			}
+		}
+
+		// Casts every ray through the world's RaycastBatch() i_passCount times, returns the seconds it took
+		double CastRays(const std::vector<PlutoShe::Physics::sRay>& i_rays, int i_passCount, std::vector<uint32_t>& io_record) const
+		{
+			std::vector<PlutoShe::Physics::sRaycastHit> hits(i_rays.size());
+			const double startTime = PlutoShe::Benchmark::GetTime();
+			for (int pass = 0; pass < i_passCount; pass++)
+			{
+				m_world.RaycastBatch(&i_rays[0], i_rays.size(), &hits[0]);
+			}
+			const double time = PlutoShe::Benchmark::GetTime() - startTime;
+			for (const PlutoShe::Physics::sRaycastHit& hit : hits)
+			{
+				io_record.push_back(hit.m_collider ? GetIndex(hit.m_collider) : UINT32_MAX);
+				AppendFloat(hit.m_distance, io_record);
+				AppendVector(hit.m_point, io_record);
+			}
+			return time;
+		}
+
+		// The narrowphase on its own, without the broadphase and bookkeeping that Step() also times
+		double GetTimePerPair()
+		{
+			using namespace PlutoShe::Physics;
+			SweepAndPrune broadphase;
+			for (Collider& collider : m_colliders)
+			{
+				broadphase.AddCollider(&collider);
+			}
+			broadphase.Update();
+			const std::vector<ColliderPair>& candidates = broadphase.GetCandidatePairs();
+			std::vector<sGJKWarmStart> warmStarts(candidates.size());
+			const int passCount = 4;
+			const double startTime = PlutoShe::Benchmark::GetTime();
+			for (int pass = 0; pass < passCount; pass++)
+			{
+				for (size_t i = 0; i < candidates.size(); i++)
+				{
+					sContact contact;
+					candidates[i].m_A->IsCollided(*candidates[i].m_B, contact, &warmStarts[i]);
+				}
+			}
+			const double time = PlutoShe::Benchmark::GetTime() - startTime;
+			return candidates.empty() ? 0 : time / (static_cast<double>(passCount) * candidates.size());
+		}
+
+		const PlutoShe::Physics::CollisionWorld& GetWorld() const { return m_world; }
+
+		static constexpr float s_sceneSize = 14.0f;
+
+	private:
+		using Vector3 = PlutoShe::Physics::Vector3;
+
+		eae6320::Math::cMatrix_transformation GetTransform(size_t i_index) const
+		{
+			return eae6320::Math::cMatrix_transformation(eae6320::Math::cQuaternion(m_angles[i_index], m_axes[i_index]),
+				eae6320::Math::sVector(m_positions[i_index].m_x, m_positions[i_index].m_y, m_positions[i_index].m_z));
+		}
+		uint32_t GetIndex(const PlutoShe::Physics::Collider* i_collider) const { return static_cast<uint32_t>(i_collider - &m_colliders[0]); }
+		static void AppendFloat(float i_value, std::vector<uint32_t>& io_record)
+		{
+			uint32_t bits;
+			std::memcpy(&bits, &i_value, sizeof(bits));
+			io_record.push_back(bits);
+		}
+		static void AppendVector(const Vector3& i_value, std::vector<uint32_t>& io_record)
+		{
+			AppendFloat(i_value.m_x, io_record);
+			AppendFloat(i_value.m_y, io_record);
+			AppendFloat(i_value.m_z, io_record);
+		}
+
+		// The world keeps pointers, so the colliders must not move
+		std::vector<PlutoShe::Physics::Collider> m_colliders;
+		std::vector<Vector3> m_positions;
+		std::vector<Vector3> m_velocities;
+		std::vector<eae6320::Math::sVector> m_axes;
+		std::vector<float> m_angles;
+		PlutoShe::Physics::CollisionWorld m_world;
+	};
+
+	// What a worker thread costs CollisionWorld before it does any work
+	double GetThreadStartTime()
+	{
+		const double startTime = PlutoShe::Benchmark::GetTime();
+		for (int i = 0; i < s_threadStartCount; i++)
+		{
+			eae6320::Concurrency::cThread thread;
+			if (thread.Start([](void* const) {}))
+			{
+				WaitForThreadToStop(thread);
+			}
+		}
+		return (PlutoShe::Benchmark::GetTime() - startTime) / s_threadStartCount;
+	}
+}
+
+// The same scene stepped with 1 to 16 worker threads. The colliding pairs, manifolds, events and sweep hits of every step
+// and the hits of a ray batch must be bitwise equal to the single-threaded run's. The thread start and per pair (per ray) costs
+// give the break-even chunk sizes that CollisionWorld::s_minPairCountPerThread and s_minRayCountPerThread are set from
+bool PlutoShe::Benchmark::RunNarrowphase()
+{
+	using namespace PlutoShe::Physics;
+	Random random(15);
+	std::vector<sRay> rays;
+	for (size_t i = 0; i < s_rayCount; i++)
+	{
+		const float x = random.Get(0, cScene::s_sceneSize);
+		const float z = random.Get(0, cScene::s_sceneSize);
+		const float directionX = random.Get(-1, 1);
+		const float directionZ = random.Get(-1, 1);
+		sRay ray;
+		ray.m_origin = Vector3(x, cScene::s_sceneSize + 1.0f, z);
+		ray.m_direction = Vector3(directionX, -4.0f, directionZ);
+		ray.m_maxDistance = 2.0f * cScene::s_sceneSize;
+		rays.push_back(ray);
+	}
+
+	bool areResultsValid = true;
+	std::vector<uint32_t> referenceRecord;
+	std::vector<uint32_t> referenceRayRecord;
+	double singleThreadedStepTime = 0;
+	double singleThreadedRayTime = 0;
+	size_t candidatePairCount = 0;
+	size_t collidingPairCount = 0;
+	size_t eventCount = 0;
+	const unsigned int threadCounts[] = { 1, 2, 4, 8, 16 };
+	for (const unsigned int threadCount : threadCounts)
+	{
+		cScene scene(threadCount);
+		std::vector<uint32_t> record;
+		double stepTime = 0;
+		candidatePairCount = 0;
+		collidingPairCount = 0;
+		eventCount = 0;
+		for (int step = 0; step < s_stepCount; step++)
+		{
+			stepTime += scene.Step();
+			candidatePairCount += scene.GetWorld().GetBroadphaseStats().m_candidatePairCount;
+			collidingPairCount += scene.GetWorld().GetCollidingPairs().size();
+			eventCount += scene.GetWorld().GetCollisionEvents().size();
+			scene.Record(record);
+		}
+		std::vector<uint32_t> rayRecord;
+		const int rayPassCount = 4;
+		const double rayTime = scene.CastRays(rays, rayPassCount, rayRecord);
+
+		std::cout << std::setw(2) << threadCount << " threads: " << std::fixed << std::setprecision(3) << stepTime * 1000.0 / s_stepCount << " ms/step, "
+			<< s_rayCount << " rays " << rayTime * 1000.0 / rayPassCount << " ms";
+		if (threadCount == 1)
+		{
+			referenceRecord = record;
+			referenceRayRecord = rayRecord;
+			singleThreadedStepTime = stepTime;
+			singleThreadedRayTime = rayTime / rayPassCount;
+		}
+		else
+		{
+			std::cout << ", " << singleThreadedStepTime / stepTime << "x";
+			if (record != referenceRecord)
+			{
+				std::cout << ", the step results differ from the single-threaded ones";
+				areResultsValid = false;
+			}
+			if (rayRecord != referenceRayRecord)
+			{
+				std::cout << ", the ray hits differ from the single-threaded ones";
+				areResultsValid = false;
+			}
+		}
+		std::cout << std::defaultfloat << std::endl;
+	}
+
+	// A chunk has to take longer than starting and joining its thread to pay for it
+	cScene scene(1);
+	scene.Step();
+	const double threadStartTime = GetThreadStartTime();
+	const double pairTime = scene.GetTimePerPair();
+	const double rayTime = singleThreadedRayTime / s_rayCount;
+	std::cout << candidatePairCount / s_stepCount << " candidate pairs, " << collidingPairCount / s_stepCount << " colliding pairs and "
+		<< eventCount / s_stepCount << " events per step. " << std::fixed << std::setprecision(2) << "Starting and joining a thread "
+		<< threadStartTime * 1.0e6 << " us, a pair " << pairTime * 1.0e6 << " us, a ray " << rayTime * 1.0e6 << " us, so a chunk pays for its thread above "
+		<< std::setprecision(0) << threadStartTime / pairTime << " pairs or " << threadStartTime / rayTime << " rays" << std::defaultfloat << std::endl;
+	return areResultsValid;
+}
@@ -0,0 +1,105 @@
+#include "Benchmarks.h"
+
+#include <Engine/Physics/cRigidBodyWorld.h>
+#include <Engine/Physics/sRigidBodyState.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr int s_stepCount = 60;
+	constexpr float s_secondCountPerStep = 1.0f / 60.0f;
+
+	// Half of the bodies spin, so both the skipped and the renormalized orientation paths are timed
+	eae6320::Physics::sRigidBodyState CreateBody(PlutoShe::Benchmark::Random& io_random, const bool i_isSpinning)
+	{
+		eae6320::Physics::sRigidBodyState state;
+		const float x = io_random.Get(-100, 100);
+		const float z = io_random.Get(-100, 100);
+		state.position = eae6320::Math::sVector(x, 0, z);
+		const float velocityX = io_random.Get(-1, 1);
+		const float velocityZ = io_random.Get(-1, 1);
+		state.velocity = eae6320::Math::sVector(velocityX, 0, velocityZ);
+		state.acceleration = eae6320::Math::sVector(0, -9.8f, 0);
+		if (i_isSpinning)
+		{
+			state.angularSpeed = io_random.Get(0.5f, 3);
+		}
+		return state;
+	}
+}
+
+// cRigidBodyWorld::Update() against calling sRigidBodyState::Update() on every body, with sleeping off so that every body integrates.
+// The threaded run only helps on a machine with that many cores
+bool PlutoShe::Benchmark::RunRigidBodyWorld()
+{
+	bool areResultsValid = true;
+	const size_t bodyCounts[] = { 10000, 100000 };
+	for (const size_t bodyCount : bodyCounts)
+	{
+		Random random(11);
+		std::vector<eae6320::Physics::sRigidBodyState> states;
+		for (size_t i = 0; i < bodyCount; i++)
+		{
+			states.push_back(CreateBody(random, i % 2 == 0));
+		}
+		eae6320::Physics::sSleepSettings sleepSettings;
+		sleepSettings.isEnabled = false;
+		eae6320::Physics::cRigidBodyWorld worlds[2];
+		for (eae6320::Physics::cRigidBodyWorld& world : worlds)
+		{
+			world.SetSleepSettings(sleepSettings);
+			for (const eae6320::Physics::sRigidBodyState& state : states)
+			{
+				world.AddBody(state);
+			}
+		}
+		worlds[1].SetWorkerThreadCount(4);
+
+		double startTime = GetTime();
+		for (int step = 0; step < s_stepCount; step++)
+		{
+			for (eae6320::Physics::sRigidBodyState& state : states)
+			{
+				state.Update(s_secondCountPerStep);
+			}
+		}
+		const double perObjectTime = GetTime() - startTime;
+		double worldTimes[2];
+		for (size_t w = 0; w < 2; w++)
+		{
+			startTime = GetTime();
+			for (int step = 0; step < s_stepCount; step++)
+			{
+				worlds[w].Update(s_secondCountPerStep);
+			}
+			worldTimes[w] = GetTime() - startTime;
+		}
+
+		// The world renormalizes with the SoA Normalize(), so the results may only differ in the last bits
+		float maxDifference = 0;
+		for (size_t i = 0; i < bodyCount; i++)
+		{
+			for (const eae6320::Physics::cRigidBodyWorld& world : worlds)
+			{
+				const eae6320::Math::sVector offset = world.GetPosition(i) - states[i].position;
+				const eae6320::Math::cQuaternion orientation = world.GetOrientation(i);
+				maxDifference = std::max(maxDifference, offset.GetLength());
+				maxDifference = std::max(maxDifference, std::abs(orientation.GetW() - states[i].orientation.GetW()));
+			}
+		}
+
+		const double toMilliseconds = 1000.0 / s_stepCount;
+		std::cout << std::setw(6) << bodyCount << " bodies: " << std::fixed << std::setprecision(3) << "per object " << perObjectTime * toMilliseconds
+			<< " ms/step, world " << worldTimes[0] * toMilliseconds << " ms/step, world on 4 threads " << worldTimes[1] * toMilliseconds
+			<< " ms/step, max difference " << std::scientific << std::setprecision(1) << maxDifference << std::defaultfloat << std::endl;
+		if (maxDifference > 1.0e-4f)
+		{
+			areResultsValid = false;
+		}
+	}
+	return areResultsValid;
+}
@@ -0,0 +1,98 @@
+#include "Benchmarks.h"
+
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Math/cQuaternion.h>
+#include <Engine/Math/sVector.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+	constexpr size_t s_transformCount = 4096;
+	constexpr int s_passCount = 200;
+
+	// Every element of the inverse feeds the sum, so the compiler can't drop any of the work
+	float GetSum(const eae6320::Math::cMatrix_transformation& i_transform)
+	{
+		const eae6320::Math::sVector sum = i_transform.GetRightDirection() + i_transform.GetUpDirection() + i_transform.GetBackDirection() + i_transform.GetTranslation();
+		return sum.x + sum.y + sum.z;
+	}
+
+	float GetMaxDifference(const eae6320::Math::cMatrix_transformation& i_a, const eae6320::Math::cMatrix_transformation& i_b)
+	{
+		float maxDifference = 0;
+		maxDifference = std::max(maxDifference, (i_a.GetRightDirection() - i_b.GetRightDirection()).GetLength());
+		maxDifference = std::max(maxDifference, (i_a.GetUpDirection() - i_b.GetUpDirection()).GetLength());
+		maxDifference = std::max(maxDifference, (i_a.GetBackDirection() - i_b.GetBackDirection()).GetLength());
+		maxDifference = std::max(maxDifference, (i_a.GetTranslation() - i_b.GetTranslation()).GetLength());
+		return maxDifference;
+	}
+}
+
+// The camera's world-to-camera transform every frame: inverting the local-to-world matrix it already has
+// against rebuilding the inverse from the inverted orientation and the position
+bool PlutoShe::Benchmark::RunTransformInverse()
+{
+	using namespace eae6320::Math;
+	Random random(22);
+	std::vector<cQuaternion> orientations;
+	std::vector<sVector> positions;
+	std::vector<cMatrix_transformation> transforms;
+	for (size_t i = 0; i < s_transformCount; i++)
+	{
+		const float angle = random.Get(-3.14f, 3.14f);
+		const float axisX = random.Get(-1, 1);
+		const float axisY = random.Get(-1, 1);
+		const float axisZ = random.Get(-1, 1);
+		const float x = random.Get(-100, 100);
+		const float y = random.Get(-100, 100);
+		const float z = random.Get(-100, 100);
+		orientations.push_back(cQuaternion(angle, sVector(axisX, axisY, axisZ + 2.0f).GetNormalized()));
+		positions.push_back(sVector(x, y, z));
+		transforms.push_back(cMatrix_transformation(orientations.back(), positions.back()));
+	}
+	std::vector<cMatrix_transformation> inverses(s_transformCount);
+	std::vector<cMatrix_transformation> rebuiltInverses(s_transformCount);
+
+	float sum = 0;
+	double startTime = GetTime();
+	for (int pass = 0; pass < s_passCount; pass++)
+	{
+		for (size_t i = 0; i < s_transformCount; i++)
+		{
+			inverses[i] = transforms[i].GetInverse_orthonormalAffine();
+		}
+		sum += GetSum(inverses[pass]);
+	}
+	const double inverseTime = GetTime() - startTime;
+	startTime = GetTime();
+	for (int pass = 0; pass < s_passCount; pass++)
+	{
+		for (size_t i = 0; i < s_transformCount; i++)
+		{
+			const cQuaternion inverseOrientation = orientations[i].GetInverse();
+			rebuiltInverses[i] = cMatrix_transformation(inverseOrientation, -(inverseOrientation * positions[i]));
+		}
+		sum += GetSum(rebuiltInverses[pass]);
+	}
+	const double rebuildTime = GetTime() - startTime;
+
+	// Both must undo the transform, and they must agree with each other up to the quaternion's round-off
+	float maxIdentityDifference = 0;
+	float maxRebuildDifference = 0;
+	for (size_t i = 0; i < s_transformCount; i++)
+	{
+		maxIdentityDifference = std::max(maxIdentityDifference, GetMaxDifference(inverses[i] * transforms[i], cMatrix_transformation()));
+		maxRebuildDifference = std::max(maxRebuildDifference, GetMaxDifference(inverses[i], rebuiltInverses[i]));
+	}
+
+	const double toNanoseconds = 1.0e9 / (static_cast<double>(s_transformCount) * s_passCount);
+	std::cout << std::fixed << std::setprecision(2) << "GetInverse_orthonormalAffine " << inverseTime * toNanoseconds
+		<< " ns, rebuilt from the inverted quaternion " << rebuildTime * toNanoseconds << " ns" << std::endl
+		<< std::scientific << std::setprecision(1) << "Max difference from the identity " << maxIdentityDifference
+		<< ", from the rebuilt inverse " << maxRebuildDifference << " (checksum " << sum << ")" << std::defaultfloat << std::endl;
+	return maxIdentityDifference < 1.0e-5f && maxRebuildDifference < 1.0e-3f;
+}